@@ -0,0 +1,76 @@
+/* Shared helpers for the benchmarks
+(C) 2013-2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef BOOST_OUTCOME_BENCHMARK_HPP
+#define BOOST_OUTCOME_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+/* Each benchmark is a plain executable which prints one line of JSON per measurement to stdout:
+
+{"benchmark":"chain","subject":"lazy","param":1000,"iterations":1000,"value":4.2,"unit":"ns/await"}
+
+`subject` is the thing measured, and `param` is the depth, count or thread count where the
+benchmark has one. Any check of the work done which fails is printed to stderr, and the
+executable then exits with a failure.
+*/
+namespace boost_outcome_benchmark
+{
+  inline void report(const char *benchmark, const char *subject, long param, long iterations, double value, const char *unit)
+  {
+    std::printf("{\"benchmark\":\"%s\",\"subject\":\"%s\",\"param\":%ld,\"iterations\":%ld,\"value\":%g,\"unit\":\"%s\"}\n", benchmark, subject, param,
+                iterations, value, unit);
+    std::fflush(stdout);
+  }
+  // Returns nanoseconds per operation, where f() does `ops` operations
+  template <class F> inline double time_it(long iterations, long ops, F &&f)
+  {
+    const auto begin = std::chrono::steady_clock::now();
+    for(long n = 0; n < iterations; n++)
+    {
+      f(static_cast<int>(n));
+    }
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+    return static_cast<double>(ns) / static_cast<double>(iterations * ops);
+  }
+  inline void check(bool ok, const char *expr, const char *file, int line)
+  {
+    if(!ok)
+    {
+      std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+      std::exit(EXIT_FAILURE);
+    }
+  }
+}  // namespace boost_outcome_benchmark
+
+#define BOOST_OUTCOME_BENCHMARK_CHECK(...) ::boost_outcome_benchmark::check(!!(__VA_ARGS__), #__VA_ARGS__, __FILE__, __LINE__)
+
+#endif
@@ -0,0 +1,118 @@
+/* Benchmarks of the work stealing pool
+(C) 2013-2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <boost/outcome.hpp>
+#include <boost/outcome/coroutine_support.hpp>
+#include <boost/outcome/sync_wait.hpp>
+#include <boost/outcome/try.hpp>
+#include <boost/outcome/when_all.hpp>
+#include <boost/outcome/work_stealing_pool.hpp>
+
+#if BOOST_OUTCOME_FOUND_COROUTINE_HEADER
+
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+/* `param` is the number of threads in the pool. `benchmark` is `fib_fine` for fib(20) with a
+coroutine per call, `fib_coarse` for fib(30) done serially below 15, or `sum` for summing 16M
+integers split into parts of 64K.
+*/
+namespace coroutine_work_stealing_benchmark
+{
+  namespace outcome = BOOST_OUTCOME_V2_NAMESPACE;
+  using boost_outcome_benchmark::report;
+  using boost_outcome_benchmark::time_it;
+  using outcome::awaitables::sync_wait;
+  using outcome::awaitables::when_all;
+  using outcome::awaitables::work_stealing_pool;
+  using executor = work_stealing_pool::executor_type;
+  template <class T> using atomic_lazy = outcome::awaitables::atomic_lazy<T, executor>;
+  template <class T> using result = outcome::result<T>;
+
+  inline long serial_fib(int n) { return n < 2 ? n : serial_fib(n - 1) + serial_fib(n - 2); }
+  // Every call at or below the cutoff is done serially
+  inline atomic_lazy<result<long>> fib(executor ex, int n, int cutoff)
+  {
+    if(n <= cutoff)
+    {
+      co_return serial_fib(n);
+    }
+    BOOST_OUTCOME_CO_TRY(auto v, co_await when_all(fib(ex, n - 1, cutoff), fib(ex, n - 2, cutoff)));
+    co_return std::get<0>(v) + std::get<1>(v);
+  }
+  inline atomic_lazy<result<uint64_t>> sum(executor ex, const uint32_t *begin, size_t count)
+  {
+    if(count <= 65536)
+    {
+      co_return std::accumulate(begin, begin + count, uint64_t(0));
+    }
+    BOOST_OUTCOME_CO_TRY(auto v, co_await when_all(sum(ex, begin, count / 2), sum(ex, begin + count / 2, count - count / 2)));
+    co_return std::get<0>(v) + std::get<1>(v);
+  }
+}  // namespace coroutine_work_stealing_benchmark
+
+// Reports how fib and a parallel sum scale from one thread to every hardware thread
+int main(void)
+{
+  using namespace coroutine_work_stealing_benchmark;
+  static constexpr long iterations = 10;
+  std::vector<uint32_t> values(1 << 24);
+  std::iota(values.begin(), values.end(), 0);
+  const auto expected_sum = std::accumulate(values.begin(), values.end(), uint64_t(0));
+  const auto expected_fib = serial_fib(30);
+  for(size_t threads = 1; threads <= (std::max)(std::thread::hardware_concurrency(), 4u); threads *= 2)
+  {
+    work_stealing_pool pool(threads);
+    auto ex = pool.get_executor();
+    const long param = static_cast<long>(threads);
+    report("fib_fine", "work_stealing_pool", param, iterations,
+           time_it(iterations, 1, [&](int /*unused*/) { BOOST_OUTCOME_BENCHMARK_CHECK(sync_wait(fib(ex, 20, 1)).value() == 6765); }), "ns/op");
+    report("fib_coarse", "work_stealing_pool", param, iterations,
+           time_it(iterations, 1, [&](int /*unused*/) { BOOST_OUTCOME_BENCHMARK_CHECK(sync_wait(fib(ex, 30, 15)).value() == expected_fib); }), "ns/op");
+    report("sum", "work_stealing_pool", param, iterations, time_it(iterations, 1,
+                                                                  [&](int /*unused*/)
+                                                                  {
+                                                                    const auto v = sync_wait(sum(ex, values.data(), values.size()));
+                                                                    BOOST_OUTCOME_BENCHMARK_CHECK(v.value() == expected_sum);
+                                                                  }),
+           "ns/op");
+  }
+  return 0;
+}
+#else
+int main(void)
+{
+  return 0;
+}
+#endif
@@ -0,0 +1,373 @@
+/* Benchmarks of the coroutine awaitables
+(C) 2013-2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <boost/outcome.hpp>
+#include <boost/outcome/coroutine_support.hpp>
+#include <boost/outcome/thread_pool.hpp>
+#include <boost/outcome/try.hpp>
+
+#if BOOST_OUTCOME_FOUND_COROUTINE_HEADER
+
+#include "benchmark.hpp"
+
+#include <memory>
+#include <thread>
+
+/* `subject` is the awaitable measured, or `function` for a plain function returning `result<int>`
+doing the same work.
+*/
+namespace coroutine_benchmark
+{
+  using boost_outcome_benchmark::report;
+  using boost_outcome_benchmark::time_it;
+  namespace outcome = BOOST_OUTCOME_V2_NAMESPACE;
+  template <class T> using eager = outcome::awaitables::eager<T>;
+  template <class T> using atomic_eager = outcome::awaitables::atomic_eager<T>;
+  template <class T> using lazy = outcome::awaitables::lazy<T>;
+  template <class T> using atomic_lazy = outcome::awaitables::atomic_lazy<T>;
+  template <class T> using atomic_lazy_upon = outcome::awaitables::atomic_lazy<T, outcome::awaitables::thread_pool::executor_type>;
+  template <class T> using generator = outcome::awaitables::generator<T>;
+  template <class T> using result = outcome::result<T>;
+
+  // AddressSanitizer stops GCC resuming by tail call, so each level of a chain then nests upon the stack
+#if defined(__SANITIZE_ADDRESS__)
+  static constexpr long max_depth = 1000;
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+  static constexpr long max_depth = 1000;
+#else
+  static constexpr long max_depth = 10000;
+#endif
+#else
+  static constexpr long max_depth = 10000;
+#endif
+
+  template <class T> inline auto wait(T &&t)
+  {
+#if BOOST_OUTCOME_HAVE_NOOP_COROUTINE
+    t.await_suspend({}).resume();
+#else
+    t.await_suspend({});
+#endif
+    return t.await_resume();
+  }
+
+  // Called through a pointer, as the compiler cannot see through a coroutine's resumption either
+  inline result<int> plain_int_impl(int x) { return x + 1; }
+  static result<int> (*volatile plain_int)(int) = plain_int_impl;
+  inline result<int> plain_chain_impl(int depth);
+  static result<int> (*volatile plain_chain)(int) = plain_chain_impl;
+  inline result<int> plain_chain_impl(int depth)
+  {
+    if(depth == 0)
+    {
+      return 0;
+    }
+    BOOST_OUTCOME_TRY(auto v, plain_chain(depth - 1));
+    return v + 1;
+  }
+
+  template <class A> inline A immediate(int x) { co_return x + 1; }
+  template <class A> inline A chain(int depth)
+  {
+    if(depth == 0)
+    {
+      co_return 0;
+    }
+    BOOST_OUTCOME_CO_TRY(auto v, co_await chain<A>(depth - 1));
+    co_return v + 1;
+  }
+  // Every resumption is posted to the pool
+  using executor = outcome::awaitables::thread_pool::executor_type;
+  inline atomic_lazy_upon<result<int>> executor_chain(executor ex, int depth)
+  {
+    if(depth == 0)
+    {
+      co_return 0;
+    }
+    BOOST_OUTCOME_CO_TRY(auto v, co_await executor_chain(ex, depth - 1));
+    co_return v + 1;
+  }
+  template <class A> inline lazy<result<int>> await_each(int count)
+  {
+    int sum = 0;
+    for(int n = 0; n < count; n++)
+    {
+      BOOST_OUTCOME_CO_TRY(auto v, co_await immediate<A>(n));
+      sum += v;
+    }
+    co_return sum;
+  }
+  template <class G> inline G counting(int count)
+  {
+    for(int n = 0; n < count; n++)
+    {
+      co_yield n;
+    }
+  }
+
+  // Remembers the size of the last allocation, which is the coroutine frame plus what is stored to free it
+  template <class T> struct measuring_allocator
+  {
+    using value_type = T;
+    size_t *bytes;
+
+    explicit measuring_allocator(size_t *_bytes)
+        : bytes(_bytes)
+    {
+    }
+    template <class U>
+    measuring_allocator(const measuring_allocator<U> &o)
+        : bytes(o.bytes)
+    {
+    }
+    T *allocate(size_t n)
+    {
+      *bytes = n * sizeof(T);
+      return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T *p, size_t n) { std::allocator<T>().deallocate(p, n); }
+    template <class U> bool operator==(const measuring_allocator<U> &o) const { return bytes == o.bytes; }
+    template <class U> bool operator!=(const measuring_allocator<U> &o) const { return bytes != o.bytes; }
+  };
+  template <class A, class Alloc> inline A sized(std::allocator_arg_t /*unused*/, Alloc /*unused*/, int x) { co_return x + 1; }
+  template <class G, class Alloc> inline G sized_generator(std::allocator_arg_t /*unused*/, Alloc /*unused*/, int x) { co_yield x; }
+  template <class A> inline void report_frame_size(const char *subject)
+  {
+    size_t bytes = 0;
+    {
+      auto t = sized<A>(std::allocator_arg, measuring_allocator<char>(&bytes), 1);
+      BOOST_OUTCOME_BENCHMARK_CHECK(wait(t).value() == 2);
+    }
+    report("frame_size", subject, 0, 1, static_cast<double>(bytes), "bytes");
+  }
+
+  template <class A> inline void report_create_destroy(const char *subject)
+  {
+    static constexpr long iterations = 1000000;
+    // Eager coroutines run to completion when created, lazy ones never begin
+    report("create_destroy", subject, 0, iterations, time_it(iterations, 1, [](int n) { (void) immediate<A>(n); }), "ns/op");
+  }
+  template <class A> inline void report_chain(const char *subject)
+  {
+    for(long depth = 1; depth <= max_depth; depth *= 10)
+    {
+      const long iterations = 1000000 / depth;
+      volatile int sink = 0;
+      report("chain", subject, depth, iterations, time_it(iterations, depth, [&](int /*unused*/) { sink = wait(chain<A>(static_cast<int>(depth))).value(); }),
+             "ns/await");
+      BOOST_OUTCOME_BENCHMARK_CHECK(sink == depth);
+    }
+  }
+  template <class A> inline void report_completion(const char *subject)
+  {
+    static constexpr long count = 1000, iterations = 1000;
+    volatile int sink = 0;
+    report("completion", subject, count, iterations, time_it(iterations, count, [&](int /*unused*/) { sink = wait(await_each<A>(count)).value(); }),
+           "ns/await");
+    BOOST_OUTCOME_BENCHMARK_CHECK(sink == count * (count + 1) / 2);
+  }
+}  // namespace coroutine_benchmark
+
+// Reports the size of coroutine frames
+static void run_frame_size()
+{
+  using namespace coroutine_benchmark;
+  report_frame_size<eager<result<int>>>("eager");
+  report_frame_size<atomic_eager<result<int>>>("atomic_eager");
+  report_frame_size<lazy<result<int>>>("lazy");
+  report_frame_size<atomic_lazy<result<int>>>("atomic_lazy");
+  size_t bytes = 0;
+  {
+    auto t = sized_generator<generator<result<int>>>(std::allocator_arg, measuring_allocator<char>(&bytes), 1);
+    BOOST_OUTCOME_BENCHMARK_CHECK(t().value() == 1);
+  }
+  report("frame_size", "generator", 0, 1, static_cast<double>(bytes), "bytes");
+}
+
+// Reports the cost of creating and destroying awaitables
+static void run_create_destroy()
+{
+  using namespace coroutine_benchmark;
+  static constexpr long iterations = 1000000;
+  volatile int sink = 0;
+  report("create_destroy", "function", 0, iterations, time_it(iterations, 1, [&](int n) { sink = plain_int(n).value(); }), "ns/op");
+  BOOST_OUTCOME_BENCHMARK_CHECK(sink == iterations);
+  report_create_destroy<eager<result<int>>>("eager");
+  report_create_destroy<atomic_eager<result<int>>>("atomic_eager");
+  report_create_destroy<lazy<result<int>>>("lazy");
+  report_create_destroy<atomic_lazy<result<int>>>("atomic_lazy");
+  report("create_destroy", "generator", 0, iterations, time_it(iterations, 1, [](int n) { (void) counting<generator<result<int>>>(n); }), "ns/op");
+}
+
+// Reports the cost of a lazy coroutine whose frame comes from operator new, as was always done before, against a recycled frame
+static void run_frame_allocation()
+{
+  using namespace coroutine_benchmark;
+  static constexpr long iterations = 1000000;
+  volatile int sink = 0;
+  report("frame_allocation", "operator_new", 0, iterations,
+         time_it(iterations, 1, [&](int n) { sink = wait(sized<lazy<result<int>>>(std::allocator_arg, std::allocator<char>(), n)).value(); }), "ns/op");
+  BOOST_OUTCOME_BENCHMARK_CHECK(sink == iterations);
+  report("frame_allocation", "pool", 0, iterations, time_it(iterations, 1, [&](int n) { sink = wait(immediate<lazy<result<int>>>(n)).value(); }), "ns/op");
+  BOOST_OUTCOME_BENCHMARK_CHECK(sink == iterations);
+}
+
+// Reports the cost per level of chains of awaits from 1 to 10000 deep
+static void run_chain()
+{
+  using namespace coroutine_benchmark;
+  for(long depth = 1; depth <= max_depth; depth *= 10)
+  {
+    const long iterations = 1000000 / depth;
+    volatile int sink = 0;
+    report("chain", "function", depth, iterations, time_it(iterations, depth, [&](int /*unused*/) { sink = plain_chain(static_cast<int>(depth)).value(); }),
+           "ns/await");
+    BOOST_OUTCOME_BENCHMARK_CHECK(sink == depth);
+  }
+  // Lazy awaitables begin and complete by symmetric transfer, so their chains do not grow the stack
+  report_chain<lazy<result<int>>>("lazy");
+  report_chain<atomic_lazy<result<int>>>("atomic_lazy");
+}
+
+// Reports the cost per level of a chain of awaits, each resumed by being posted to a thread pool
+static void run_executor_chain()
+{
+  using namespace coroutine_benchmark;
+  outcome::awaitables::thread_pool pool(4);
+  static constexpr long depth = 10000, iterations = 10;
+  volatile int sink = 0;
+  report("chain", "atomic_lazy_thread_pool", depth, iterations, time_it(iterations, depth,
+                                                                         [&](int /*unused*/)
+                                                                         {
+                                                                           auto t = executor_chain(pool.get_executor(), static_cast<int>(depth));
+#if BOOST_OUTCOME_HAVE_NOOP_COROUTINE
+                                                                           t.await_suspend({}).resume();
+#else
+                                                                           t.await_suspend({});
+#endif
+                                                                           while(!t.await_ready())
+                                                                           {
+                                                                             std::this_thread::yield();
+                                                                           }
+                                                                           sink = t.await_resume().value();
+                                                                         }),
+         "ns/await");
+  BOOST_OUTCOME_BENCHMARK_CHECK(sink == depth);
+}
+
+// Reports the cost of awaiting atomic and non-atomic awaitables
+static void run_completion()
+{
+  using namespace coroutine_benchmark;
+  static constexpr long count = 1000, iterations = 1000;
+  volatile int sink = 0;
+  report("completion", "function", count, iterations, time_it(iterations, count,
+                                                              [&](int /*unused*/)
+                                                              {
+                                                                int sum = 0;
+                                                                for(int n = 0; n < count; n++)
+                                                                {
+                                                                  sum += plain_int(n).value();
+                                                                }
+                                                                sink = sum;
+                                                              }),
+         "ns/await");
+  report_completion<eager<result<int>>>("eager");
+  report_completion<atomic_eager<result<int>>>("atomic_eager");
+  report_completion<lazy<result<int>>>("lazy");
+  report_completion<atomic_lazy<result<int>>>("atomic_lazy");
+}
+
+// Reports the throughput of generators
+static void run_generator()
+{
+  using namespace coroutine_benchmark;
+  static constexpr long values = 1000000, iterations = 10;
+  volatile long sink = 0;
+  report("generator", "function", values, iterations, time_it(iterations, values,
+                                                              [&](int /*unused*/)
+                                                              {
+                                                                long sum = 0;
+                                                                for(int n = 0; n < values; n++)
+                                                                {
+                                                                  sum += plain_int(n).value();
+                                                                }
+                                                                sink = sum;
+                                                              }),
+         "ns/value");
+  report("generator", "generator", values, iterations, time_it(iterations, values,
+                                                               [&](int /*unused*/)
+                                                               {
+                                                                 long sum = 0;
+                                                                 auto t = counting<generator<result<int>>>(values);
+                                                                 while(t)
+                                                                 {
+                                                                   sum += t().value();
+                                                                 }
+                                                                 sink = sum;
+                                                               }),
+         "ns/value");
+#if __cpp_lib_span >= 202002L
+  report("generator", "batch_generator_64", values, iterations, time_it(iterations, values,
+                                                                        [&](int /*unused*/)
+                                                                        {
+                                                                          long sum = 0;
+                                                                          auto t = counting<outcome::awaitables::batch_generator<result<int>, 64>>(values);
+                                                                          while(t)
+                                                                          {
+                                                                            for(auto &r : t())
+                                                                            {
+                                                                              sum += r.value();
+                                                                            }
+                                                                          }
+                                                                          sink = sum;
+                                                                        }),
+         "ns/value");
+#endif
+  BOOST_OUTCOME_BENCHMARK_CHECK(sink == values * (values - 1) / 2);
+}
+
+int main(void)
+{
+  run_frame_size();
+  run_create_destroy();
+  run_frame_allocation();
+  run_chain();
+  run_executor_chain();
+  run_completion();
+  run_generator();
+  return 0;
+}
+#else
+int main(void)
+{
+  return 0;
+}
+#endif
@@ -0,0 +1,106 @@
+/* Benchmarks of converting exceptions to error codes
+(C) 2013-2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <boost/outcome/utils.hpp>
+
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/* `subject` is `dispatch` for error_from_exception(), which asks the C++ runtime which handler would
+catch the thrown type when BOOST_OUTCOME_ERROR_FROM_EXCEPTION_USE_TYPE_DISPATCH is on, or `rethrow`
+for rethrowing and catching each exception. `param` is the number of threads converting at once.
+*/
+namespace error_from_exception_benchmark
+{
+  namespace outcome = BOOST_OUTCOME_V2_NAMESPACE;
+  using boost_outcome_benchmark::report;
+
+  static constexpr long per_thread = 20000;
+
+  inline std::vector<std::exception_ptr> make_exceptions()
+  {
+    return {std::make_exception_ptr(std::invalid_argument("")), std::make_exception_ptr(std::out_of_range("")),
+            std::make_exception_ptr(std::system_error(std::make_error_code(std::errc::device_or_resource_busy))),
+            std::make_exception_ptr(std::runtime_error("")), std::make_exception_ptr(std::bad_alloc())};
+  }
+
+  inline void report_conversions(const char *subject, bool rethrow, unsigned threads)
+  {
+    const auto exceptions = make_exceptions();
+    std::atomic<unsigned> ready{0};
+    std::atomic<long> matched{0};
+    std::vector<std::thread> workers;
+    const auto begin = std::chrono::steady_clock::now();
+    for(unsigned t = 0; t < threads; t++)
+    {
+      workers.emplace_back(
+      [&]
+      {
+        ++ready;
+        while(ready < threads)
+        {
+          std::this_thread::yield();
+        }
+        long count = 0;
+        for(long n = 0; n < per_thread; n++)
+        {
+          std::exception_ptr e(exceptions[n % exceptions.size()]);
+          auto ec = rethrow ? outcome::detail::error_from_exception_rethrow(e, {}) : outcome::error_from_exception(std::move(e), {});
+          count += !!ec;
+        }
+        matched += count;
+      });
+    }
+    for(auto &w : workers)
+    {
+      w.join();
+    }
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+    BOOST_OUTCOME_BENCHMARK_CHECK(matched == per_thread * static_cast<long>(threads));
+    report("error_from_exception", subject, threads, per_thread, static_cast<double>(ns) / static_cast<double>(per_thread), "ns/conversion");
+  }
+}  // namespace error_from_exception_benchmark
+
+int main(void)
+{
+  using namespace error_from_exception_benchmark;
+  const unsigned max_threads = (std::max)(2U, (std::min)(8U, std::thread::hardware_concurrency()));
+  for(unsigned threads = 1; threads <= max_threads; threads *= 2)
+  {
+    report_conversions("rethrow", true, threads);
+    report_conversions("dispatch", false, threads);
+  }
+  return 0;
+}
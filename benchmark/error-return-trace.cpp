@@ -0,0 +1,105 @@
+/* Benchmarks of error return tracing
+(C) 2013-2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#define BOOST_OUTCOME_ENABLE_ERROR_RETURN_TRACE 1
+#include <boost/outcome.hpp>
+
+#include "benchmark.hpp"
+
+/* `subject` is `traced` for two levels of BOOST_OUTCOME_TRY with error return tracing enabled,
+or `untraced` for the same code without. `benchmark` is `try_success` for the success path, which
+should cost the same, or `try_failure` for the failure path, which records each site.
+*/
+namespace error_return_trace_benchmark
+{
+  namespace outcome = BOOST_OUTCOME_V2_NAMESPACE;
+  using boost_outcome_benchmark::report;
+  using boost_outcome_benchmark::time_it;
+
+  // Called through a pointer so that the compiler cannot see which way it will go
+  inline outcome::result<int> leaf_impl(int x)
+  {
+    if(x < 0)
+    {
+      return boost::system::errc::invalid_argument;
+    }
+    return x;
+  }
+  static outcome::result<int> (*volatile leaf)(int) = leaf_impl;
+  inline outcome::result<int> middle(int x)
+  {
+    BOOST_OUTCOME_TRY(auto v, leaf(x));
+    return v + 1;
+  }
+  inline outcome::result<int> top(int x)
+  {
+    BOOST_OUTCOME_TRY(auto v, middle(x));
+    return v * 2;
+  }
+}  // namespace error_return_trace_benchmark
+
+// The same functions without error return tracing
+#undef BOOST_OUTCOME_TRY_RECORD_ERROR_RETURN
+#define BOOST_OUTCOME_TRY_RECORD_ERROR_RETURN(f)
+
+namespace error_return_trace_benchmark
+{
+  inline outcome::result<int> untraced_middle(int x)
+  {
+    BOOST_OUTCOME_TRY(auto v, leaf(x));
+    return v + 1;
+  }
+  inline outcome::result<int> untraced_top(int x)
+  {
+    BOOST_OUTCOME_TRY(auto v, untraced_middle(x));
+    return v * 2;
+  }
+
+  static constexpr long iterations = 10000000;
+
+  inline void report_path(const char *benchmark, const char *subject, outcome::result<int> (*f)(int), bool fail)
+  {
+    volatile long sink = 0;
+    report(benchmark, subject, 0, iterations, time_it(iterations, 1, [&](int n) { sink = sink + f(fail ? -1 - (n & 0xff) : (n & 0xff)).has_value(); }),
+           "ns/call");
+    BOOST_OUTCOME_BENCHMARK_CHECK(sink == (fail ? 0 : iterations));
+  }
+}  // namespace error_return_trace_benchmark
+
+int main(void)
+{
+  using namespace error_return_trace_benchmark;
+  report_path("try_success", "untraced", untraced_top, false);
+  report_path("try_success", "traced", top, false);
+  report_path("try_failure", "untraced", untraced_top, true);
+  report_path("try_failure", "traced", top, true);
+  const auto trace = outcome::error_return_trace_of(top(-1));
+  BOOST_OUTCOME_BENCHMARK_CHECK(trace.size() == 2);
+  return 0;
+}
@@ -0,0 +1,131 @@
+/* Benchmarks of chaining results with the monadic operations
+(C) 2013-2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <boost/outcome.hpp>
+
+#include "benchmark.hpp"
+
+/* `subject` is `monadic` for a chain of `param` steps written with `and_then()`, `transform()`,
+`transform_error()` and `or_else()`, or `try` for the same chain written with BOOST_OUTCOME_TRY.
+`benchmark` is `chain`, with one call in every sixteen failing and being recovered at the end.
+*/
+namespace monadic_benchmark
+{
+  namespace outcome = BOOST_OUTCOME_V2_NAMESPACE;
+  using boost_outcome_benchmark::report;
+  using boost_outcome_benchmark::time_it;
+
+  // Called through pointers so that the compiler cannot see which way they will go
+  inline outcome::result<int> leaf_impl(int x)
+  {
+    if(x < 0)
+    {
+      return boost::system::errc::invalid_argument;
+    }
+    return x;
+  }
+  inline outcome::result<int> step_impl(int x)
+  {
+    if(x > (1 << 20))
+    {
+      return boost::system::errc::value_too_large;
+    }
+    return x * 2;
+  }
+  static outcome::result<int> (*volatile leaf)(int) = leaf_impl;
+  static outcome::result<int> (*volatile step)(int) = step_impl;
+
+  inline boost::system::error_code annotate(const boost::system::error_code &ec) noexcept
+  {
+    return (ec == boost::system::errc::invalid_argument) ? make_error_code(boost::system::errc::argument_out_of_domain) : ec;
+  }
+  inline outcome::result<int> recover(const boost::system::error_code &ec) noexcept
+  {
+    if(ec == boost::system::errc::argument_out_of_domain)
+    {
+      return -1;
+    }
+    return ec;
+  }
+
+  // Eight steps
+  inline outcome::result<int> monadic_chain(int x)
+  {
+    return leaf(x)
+    .and_then([](int v) { return step(v); })
+    .transform([](int v) { return v + 1; })
+    .and_then([](int v) { return step(v); })
+    .transform([](int v) { return v + 1; })
+    .and_then([](int v) { return step(v); })
+    .transform_error(annotate)
+    .or_else(recover);
+  }
+
+  // The same eight steps
+  inline outcome::result<int> try_steps(int x)
+  {
+    BOOST_OUTCOME_TRY(auto a, leaf(x));
+    BOOST_OUTCOME_TRY(auto b, step(a));
+    BOOST_OUTCOME_TRY(auto c, step(b + 1));
+    BOOST_OUTCOME_TRY(auto d, step(c + 1));
+    return d;
+  }
+  inline outcome::result<int> try_chain(int x)
+  {
+    auto r = try_steps(x);
+    if(r)
+    {
+      return r;
+    }
+    return recover(annotate(r.assume_error()));
+  }
+
+  static constexpr long iterations = 1000000;
+
+  inline void report_chain(const char *subject, outcome::result<int> (*f)(int))
+  {
+    volatile long sink = 0;
+    report("chain", subject, 8, iterations, time_it(iterations, 1, [&](int n) {
+             auto r = f((n & 15) == 0 ? -1 : (n & 0xff));
+             sink = sink + (r ? r.value() : -2);
+           }),
+           "ns/call");
+    BOOST_OUTCOME_BENCHMARK_CHECK(f(0).value() == 6);
+    BOOST_OUTCOME_BENCHMARK_CHECK(f(-1).value() == -1);
+    BOOST_OUTCOME_BENCHMARK_CHECK(f(1 << 21).error() == boost::system::errc::value_too_large);
+  }
+}  // namespace monadic_benchmark
+
+int main(void)
+{
+  using namespace monadic_benchmark;
+  report_chain("monadic", monadic_chain);
+  report_chain("try", try_chain);
+  return 0;
+}
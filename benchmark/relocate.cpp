@@ -0,0 +1,174 @@
+/* Benchmarks of growing buffers of status results with relocate_n()
+(C) 2013-2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <boost/outcome/experimental/status_result.hpp>
+
+#include "benchmark.hpp"
+
+#include <chrono>
+#include <new>
+#include <utility>
+#include <vector>
+
+/* `benchmark` is `vector` for pushing results into a `std::vector` without reserving, or `relocate_n`
+for pushing them into a buffer which doubles in capacity and moves its contents with `relocate_n()`.
+`subject` is the value type of the `status_result`: `int`, a type with throwing moves which is
+declared trivially relocatable, or the same type without that declaration.
+*/
+namespace relocate_benchmark
+{
+  namespace outcome = BOOST_OUTCOME_V2_NAMESPACE;
+  using boost_outcome_benchmark::report;
+
+  // Owns memory and has potentially throwing moves
+  template <bool Relocatable> struct boxed
+  {
+    int *p;
+    explicit boxed(int v)
+        : p(new int(v))
+    {
+    }
+    boxed(boxed &&o) noexcept(false)
+        : p(o.p)
+    {
+      o.p = nullptr;
+    }
+    boxed &operator=(boxed &&o) noexcept(false)
+    {
+      std::swap(p, o.p);
+      return *this;
+    }
+    ~boxed() { delete p; }
+    int get() const noexcept { return *p; }
+  };
+  inline int get(int v) noexcept { return v; }
+  template <bool Relocatable> inline int get(const boxed<Relocatable> &v) noexcept { return v.get(); }
+}  // namespace relocate_benchmark
+BOOST_OUTCOME_V2_NAMESPACE_BEGIN
+namespace trait
+{
+  template <> struct is_trivially_relocatable<relocate_benchmark::boxed<true>>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace trait
+BOOST_OUTCOME_V2_NAMESPACE_END
+
+namespace relocate_benchmark
+{
+  static constexpr long count = 1 << 20, iterations = 10;
+
+  template <class T> using result = outcome::experimental::status_result<T>;
+
+  static_assert(outcome::trait::is_trivially_relocatable<result<int>>::value, "status_result<int> is not trivially relocatable");
+  static_assert(outcome::trait::is_trivially_relocatable<result<boxed<true>>>::value, "status_result<boxed<true>> is not trivially relocatable");
+  static_assert(!outcome::trait::is_trivially_relocatable<result<boxed<false>>>::value, "status_result<boxed<false>> is trivially relocatable");
+
+  // One result in eight is a failure
+  template <class T> inline result<T> make_result(long n)
+  {
+    if(n % 8 == 5)
+    {
+      return outcome::experimental::generic_code(outcome::experimental::errc::invalid_argument);
+    }
+    return result<T>(outcome::in_place_type<T>, static_cast<int>(n));
+  }
+  template <class T> inline bool check(const result<T> &r, long n) noexcept
+  {
+    return (n % 8 == 5) ? r.has_error() : (r.has_value() && get(r.assume_value()) == static_cast<int>(n));
+  }
+
+  // The minimum a growable array needs: a doubling capacity, and relocate_n() to move into the new allocation
+  template <class T> class buffer
+  {
+    T *_begin{nullptr};
+    size_t _size{0}, _capacity{0};
+
+  public:
+    buffer() = default;
+    buffer(const buffer &) = delete;
+    buffer &operator=(const buffer &) = delete;
+    ~buffer()
+    {
+      for(size_t n = 0; n < _size; n++)
+      {
+        _begin[n].~T();
+      }
+      ::operator delete(_begin);
+    }
+    size_t size() const noexcept { return _size; }
+    const T &operator[](size_t n) const noexcept { return _begin[n]; }
+    void push_back(T &&v)
+    {
+      if(_size == _capacity)
+      {
+        const size_t capacity = (_capacity == 0) ? 1 : _capacity * 2;
+        T *p = static_cast<T *>(::operator new(capacity * sizeof(T)));
+        outcome::relocate_n(_begin, _size, p);
+        ::operator delete(_begin);
+        _begin = p;
+        _capacity = capacity;
+      }
+      new(_begin + _size) T(static_cast<T &&>(v));
+      ++_size;
+    }
+  };
+
+  template <class Container, class T> inline void report_growth(const char *benchmark, const char *subject)
+  {
+    std::chrono::nanoseconds::rep ns = 0;
+    for(long i = 0; i < iterations; i++)
+    {
+      Container results;
+      const auto begin = std::chrono::steady_clock::now();
+      for(long n = 0; n < count; n++)
+      {
+        results.push_back(make_result<T>(n));
+      }
+      ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+      BOOST_OUTCOME_BENCHMARK_CHECK(results.size() == static_cast<size_t>(count));
+      BOOST_OUTCOME_BENCHMARK_CHECK(check(results[5], 5) && check(results[count - 1], count - 1));
+    }
+    report(benchmark, subject, count, iterations, static_cast<double>(ns) / static_cast<double>(iterations * count), "ns/result");
+  }
+  template <class T> inline void report_both(const char *subject)
+  {
+    report_growth<std::vector<result<T>>, T>("vector", subject);
+    report_growth<buffer<result<T>>, T>("relocate_n", subject);
+  }
+}  // namespace relocate_benchmark
+
+int main(void)
+{
+  using namespace relocate_benchmark;
+  report_both<int>("int");
+  report_both<boxed<true>>("relocatable");
+  report_both<boxed<false>>("not_relocatable");
+  return 0;
+}
@@ -0,0 +1,156 @@
+/* Benchmarks of swapping and sorting results
+(C) 2013-2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <boost/outcome.hpp>
+
+#include "benchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <system_error>
+#include <vector>
+
+/* `subject` is the value type of the results: `int`, a type with throwing moves which is declared
+trivially relocatable and so swaps by exchanging bytes, or the same type without that declaration.
+*/
+namespace swap_benchmark
+{
+  namespace outcome = BOOST_OUTCOME_V2_NAMESPACE;
+  using boost_outcome_benchmark::report;
+
+  // Owns memory and has potentially throwing moves
+  template <bool Relocatable> struct boxed
+  {
+    int *p;
+    explicit boxed(int v)
+        : p(new int(v))
+    {
+    }
+    boxed(boxed &&o) noexcept(false)
+        : p(o.p)
+    {
+      o.p = nullptr;
+    }
+    boxed &operator=(boxed &&o) noexcept(false)
+    {
+      std::swap(p, o.p);
+      return *this;
+    }
+    ~boxed() { delete p; }
+    int get() const noexcept { return *p; }
+  };
+  inline int get(int v) noexcept { return v; }
+  template <bool Relocatable> inline int get(const boxed<Relocatable> &v) noexcept { return v.get(); }
+}  // namespace swap_benchmark
+BOOST_OUTCOME_V2_NAMESPACE_BEGIN
+namespace trait
+{
+  template <> struct is_trivially_relocatable<swap_benchmark::boxed<true>>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace trait
+BOOST_OUTCOME_V2_NAMESPACE_END
+
+namespace swap_benchmark
+{
+  static constexpr long count = 1 << 20, iterations = 10;
+
+  template <class T> using result = outcome::basic_result<T, std::error_code, outcome::policy::all_narrow>;
+
+  // One result in eight is a failure, and the values are scrambled
+  template <class T> inline std::vector<result<T>> make_results()
+  {
+    std::vector<result<T>> ret;
+    ret.reserve(count);
+    for(long n = 0; n < count; n++)
+    {
+      if(n % 8 == 5)
+      {
+        ret.emplace_back(std::make_error_code(std::errc::invalid_argument));
+      }
+      else
+      {
+        ret.emplace_back(outcome::in_place_type<T>, static_cast<int>((n * 2654435761UL) % count));
+      }
+    }
+    return ret;
+  }
+  template <class T> inline bool before(const result<T> &a, const result<T> &b) noexcept
+  {
+    if(a.has_error() || b.has_error())
+    {
+      return a.has_error() && !b.has_error();
+    }
+    return get(a.assume_value()) < get(b.assume_value());
+  }
+
+  template <class T> inline void report_swap(const char *subject)
+  {
+    auto results = make_results<T>();
+    const auto begin = std::chrono::steady_clock::now();
+    for(long i = 0; i < iterations; i++)
+    {
+      for(long n = 0; n < count / 2; n++)
+      {
+        swap(results[n], results[count - 1 - n]);
+      }
+    }
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+    report("swap", subject, count, iterations, static_cast<double>(ns) / static_cast<double>(iterations * (count / 2)), "ns/swap");
+    BOOST_OUTCOME_BENCHMARK_CHECK(results[5].has_error());
+  }
+  // std::sort partitions by swapping, and finishes with an insertion sort which moves
+  template <class T> inline void report_sort(const char *subject)
+  {
+    std::chrono::nanoseconds::rep ns = 0;
+    for(long i = 0; i < iterations; i++)
+    {
+      auto results = make_results<T>();
+      const auto begin = std::chrono::steady_clock::now();
+      std::sort(results.begin(), results.end(), before<T>);
+      ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+      BOOST_OUTCOME_BENCHMARK_CHECK(std::is_sorted(results.begin(), results.end(), before<T>));
+      BOOST_OUTCOME_BENCHMARK_CHECK(results[count / 8 - 1].has_error() && results[count / 8].has_value());
+    }
+    report("sort", subject, count, iterations, static_cast<double>(ns) / static_cast<double>(iterations * count), "ns/result");
+  }
+}  // namespace swap_benchmark
+
+int main(void)
+{
+  using namespace swap_benchmark;
+  report_swap<int>("int");
+  report_swap<boxed<true>>("relocatable");
+  report_swap<boxed<false>>("not_relocatable");
+  report_sort<int>("int");
+  report_sort<boxed<true>>("relocatable");
+  report_sort<boxed<false>>("not_relocatable");
+  return 0;
+}
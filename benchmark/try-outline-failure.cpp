@@ -0,0 +1,98 @@
+/* Benchmarks of TRY with outlined failure branches
+(C) 2013-2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#define BOOST_OUTCOME_TRY_OUTLINE_FAILURE 1
+#include <boost/outcome.hpp>
+
+#include "benchmark.hpp"
+
+/* `subject` is `outlined` for a chain of `param` BOOST_OUTCOME_TRY sites with outlined failure
+branches, or `inline` for the same chain with the failure branches expanded in place. `benchmark`
+is `try_chain`, with one call in every sixteen failing.
+*/
+namespace try_outline_failure_benchmark
+{
+  namespace outcome = BOOST_OUTCOME_V2_NAMESPACE;
+  using boost_outcome_benchmark::report;
+  using boost_outcome_benchmark::time_it;
+
+  // Called through a pointer so that the compiler cannot see which way it will go
+  inline outcome::result<int> leaf_impl(int x)
+  {
+    if(x < 0)
+    {
+      return boost::system::errc::invalid_argument;
+    }
+    return x;
+  }
+  static outcome::result<int> (*volatile leaf)(int) = leaf_impl;
+
+  template <int N> outcome::result<int> outlined_chain(int x)
+  {
+    BOOST_OUTCOME_TRY(auto v, outlined_chain<N - 1>(x));
+    return v + 1;
+  }
+  template <> inline outcome::result<int> outlined_chain<0>(int x) { return leaf(x); }
+}  // namespace try_outline_failure_benchmark
+
+// The same chain with the failure branches expanded in place
+#undef BOOST_OUTCOME_TRY_FAILURE_OPERAND
+#define BOOST_OUTCOME_TRY_FAILURE_OPERAND(...) __VA_ARGS__
+
+namespace try_outline_failure_benchmark
+{
+  template <int N> outcome::result<int> inline_chain(int x)
+  {
+    BOOST_OUTCOME_TRY(auto v, inline_chain<N - 1>(x));
+    return v + 1;
+  }
+  template <> inline outcome::result<int> inline_chain<0>(int x) { return leaf(x); }
+
+  static constexpr long iterations = 1000000;
+
+  inline void report_chain(const char *subject, outcome::result<int> (*f)(int))
+  {
+    volatile long sink = 0;
+    report("try_chain", subject, 64, iterations, time_it(iterations, 1, [&](int n) {
+             auto r = f((n & 15) == 0 ? -1 : (n & 0xff));
+             sink = sink + (r ? r.value() : -1);
+           }),
+           "ns/call");
+    BOOST_OUTCOME_BENCHMARK_CHECK(f(0).value() == 64);
+    BOOST_OUTCOME_BENCHMARK_CHECK(f(-1).has_error());
+  }
+}  // namespace try_outline_failure_benchmark
+
+int main(void)
+{
+  using namespace try_outline_failure_benchmark;
+  report_chain("inline", inline_chain<64>);
+  report_chain("outlined", outlined_chain<64>);
+  return 0;
+}
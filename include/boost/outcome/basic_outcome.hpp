@@ -179,6 +179,19 @@ SIGNATURE NOT RECOGNISED
 */
 template <class T> static constexpr bool is_basic_outcome_v = detail::is_basic_outcome<std::decay_t<T>>::value;
 
+namespace trait
+{
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class S, class P, class NoValuePolicy> struct is_trivially_relocatable<basic_outcome<R, S, P, NoValuePolicy>>
+  {
+    static constexpr bool value = is_trivially_relocatable<BOOST_OUTCOME_V2_NAMESPACE::detail::devoid<R>>::value &&
+                                  is_trivially_relocatable<BOOST_OUTCOME_V2_NAMESPACE::detail::devoid<S>>::value &&
+                                  is_trivially_relocatable<BOOST_OUTCOME_V2_NAMESPACE::detail::devoid<P>>::value;
+  };
+}  // namespace trait
+
 namespace concepts
 {
 #if defined(__cpp_concepts)
@@ -231,24 +244,47 @@ SIGNATURE NOT RECOGNISED
   constexpr inline void override_outcome_exception(basic_outcome<R, S, P, NoValuePolicy> *o, U &&v) noexcept;
 }  // namespace hooks
 
+namespace detail
+{
+  // Constructs an R holding the exception of o, or an empty one if that is void
+  template <class R, class O> constexpr inline R make_exception_from(std::false_type /*is void*/, O &&o)
+  {
+    return R(in_place_type<typename R::exception_type_if_enabled>, static_cast<O &&>(o).assume_exception());
+  }
+  template <class R, class O> constexpr inline R make_exception_from(std::true_type /*is void*/, O && /*unused*/)
+  {
+    return R(in_place_type<typename R::exception_type_if_enabled>);
+  }
+  // Adds the exception of o to r, which already holds an error
+  template <class R, class O> constexpr inline void copy_exception_into(std::false_type /*is void*/, R *r, O &&o)
+  {
+    hooks::override_outcome_exception(r, static_cast<O &&>(o).assume_exception());
+  }
+  template <class R, class O> constexpr inline void copy_exception_into(std::true_type /*is void*/, R * /*unused*/, O && /*unused*/) {}
+}  // namespace detail
+
 /*! AWAITING HUGO JSON CONVERSION TOOL
 type definition template <class R, class S, class P, class NoValuePolicy> basic_outcome. Potential doc page: `basic_outcome<T, EC, EP, NoValuePolicy>`
 */
 template <class R, class S, class P, class NoValuePolicy>  //
-class BOOST_OUTCOME_NODISCARD basic_outcome
+class BOOST_OUTCOME_NODISCARD BOOST_OUTCOME_TRIVIAL_ABI basic_outcome
 #if defined(BOOST_OUTCOME_DOXYGEN_IS_IN_THE_HOUSE) || defined(BOOST_OUTCOME_STANDARDESE_IS_IN_THE_HOUSE)
     : public detail::basic_outcome_failure_observers<detail::basic_result_final<R, S, P, NoValuePolicy>, R, S, P, NoValuePolicy>,
       public detail::basic_outcome_exception_observers<detail::basic_result_final<R, S, NoValuePolicy>, R, S, P, NoValuePolicy>,
       public detail::basic_result_final<R, S, NoValuePolicy>
 #else
     : public detail::select_basic_outcome_failure_observers<
-      detail::basic_outcome_exception_observers<detail::basic_result_final<R, S, NoValuePolicy>, R, S, P, NoValuePolicy>, R, S, P, NoValuePolicy>
+      detail::basic_outcome_exception_observers<detail::basic_outcome_exception_storage<detail::basic_result_final<R, S, NoValuePolicy>, R, S, P>, R, S, P, NoValuePolicy>,
+      R, S, P, NoValuePolicy>
 #endif
 {
   static_assert(trait::type_can_be_used_in_basic_result<P>, "The exception_type cannot be used");
   static_assert(std::is_void<P>::value || std::is_default_constructible<P>::value, "exception_type must be void or default constructible");
+  static_assert(!detail::is_niche_storable<R, S>::value,
+                "value_type and error_type cannot be a type with a niche and void, as the niche has no room for the exception");
   using base = detail::select_basic_outcome_failure_observers<
-  detail::basic_outcome_exception_observers<detail::basic_result_final<R, S, NoValuePolicy>, R, S, P, NoValuePolicy>, R, S, P, NoValuePolicy>;
+  detail::basic_outcome_exception_observers<detail::basic_outcome_exception_storage<detail::basic_result_final<R, S, NoValuePolicy>, R, S, P>, R, S, P, NoValuePolicy>, R,
+  S, P, NoValuePolicy>;
   friend struct policy::base;
   template <class T, class U, class V, class W>  //
   friend class basic_outcome;
@@ -418,9 +454,6 @@ public:
   using exception_type_if_enabled = std::conditional_t<std::is_same<exception_type, value_type>::value || std::is_same<exception_type, error_type>::value,
                                                        disable_in_place_exception_type, exception_type>;
 
-protected:
-  detail::devoid<exception_type> _ptr;
-
 public:
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
@@ -447,7 +480,6 @@ SIGNATURE NOT RECOGNISED
   constexpr basic_outcome(T &&t, value_converting_constructor_tag /*unused*/ = value_converting_constructor_tag()) noexcept(
   detail::is_nothrow_constructible<value_type, T>)  // NOLINT
       : base{in_place_type<typename base::_value_type>, static_cast<T &&>(t)}
-      , _ptr()
   {
     no_value_policy_type::on_outcome_construction(this, static_cast<T &&>(t));
   }
@@ -459,7 +491,6 @@ SIGNATURE NOT RECOGNISED
   constexpr basic_outcome(T &&t, error_converting_constructor_tag /*unused*/ = error_converting_constructor_tag()) noexcept(
   detail::is_nothrow_constructible<error_type, T>)  // NOLINT
       : base{in_place_type<typename base::_error_type>, static_cast<T &&>(t)}
-      , _ptr()
   {
     no_value_policy_type::on_outcome_construction(this, static_cast<T &&>(t));
   }
@@ -482,8 +513,7 @@ SIGNATURE NOT RECOGNISED
   BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(predicate::template enable_exception_converting_constructor<T>))
   constexpr basic_outcome(T &&t, exception_converting_constructor_tag /*unused*/ = exception_converting_constructor_tag()) noexcept(
   detail::is_nothrow_constructible<exception_type, T>)  // NOLINT
-      : base()
-      , _ptr(static_cast<T &&>(t))
+      : base{typename base::exception_tag(), static_cast<T &&>(t)}
   {
     this->_state._status.set_have_exception(true);
     no_value_policy_type::on_outcome_construction(this, static_cast<T &&>(t));
@@ -495,8 +525,7 @@ SIGNATURE NOT RECOGNISED
   BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(predicate::template enable_error_exception_converting_constructor<T, U>))
   constexpr basic_outcome(T &&a, U &&b, error_exception_converting_constructor_tag /*unused*/ = error_exception_converting_constructor_tag()) noexcept(
   detail::is_nothrow_constructible<error_type, T> &&detail::is_nothrow_constructible<exception_type, U>)  // NOLINT
-      : base{in_place_type<typename base::_error_type>, static_cast<T &&>(a)}
-      , _ptr(static_cast<U &&>(b))
+      : base{typename base::error_exception_tag(), true, static_cast<T &&>(a), static_cast<U &&>(b)}
   {
     this->_state._status.set_have_exception(true);
     no_value_policy_type::on_outcome_construction(this, static_cast<T &&>(a), static_cast<U &&>(b));
@@ -524,8 +553,7 @@ SIGNATURE NOT RECOGNISED
   explicit_compatible_copy_conversion_tag /*unused*/ =
   explicit_compatible_copy_conversion_tag()) noexcept(detail::is_nothrow_constructible<value_type, T> &&detail::is_nothrow_constructible<error_type, U>
                                                       &&detail::is_nothrow_constructible<exception_type, V>)
-      : base{typename base::compatible_conversion_tag(), o}
-      , _ptr(o._ptr)
+      : base{typename base::exception_conversion_tag(), o}
   {
     no_value_policy_type::on_outcome_copy_construction(this, o);
   }
@@ -539,8 +567,7 @@ SIGNATURE NOT RECOGNISED
   explicit_compatible_move_conversion_tag /*unused*/ =
   explicit_compatible_move_conversion_tag()) noexcept(detail::is_nothrow_constructible<value_type, T> &&detail::is_nothrow_constructible<error_type, U>
                                                       &&detail::is_nothrow_constructible<exception_type, V>)
-      : base{typename base::compatible_conversion_tag(), static_cast<basic_outcome<T, U, V, W> &&>(o)}
-      , _ptr(static_cast<typename basic_outcome<T, U, V, W>::exception_type &&>(o._ptr))
+      : base{typename base::exception_conversion_tag(), static_cast<basic_outcome<T, U, V, W> &&>(o)}
   {
     no_value_policy_type::on_outcome_move_construction(this, static_cast<basic_outcome<T, U, V, W> &&>(o));
   }
@@ -555,7 +582,6 @@ SIGNATURE NOT RECOGNISED
   explicit_compatible_copy_conversion_tag()) noexcept(detail::is_nothrow_constructible<value_type, T> &&detail::is_nothrow_constructible<error_type, U>
                                                       &&detail::is_nothrow_constructible<exception_type>)
       : base{typename base::compatible_conversion_tag(), o}
-      , _ptr()
   {
     no_value_policy_type::on_outcome_copy_construction(this, o);
   }
@@ -570,7 +596,6 @@ SIGNATURE NOT RECOGNISED
   explicit_compatible_move_conversion_tag()) noexcept(detail::is_nothrow_constructible<value_type, T> &&detail::is_nothrow_constructible<error_type, U>
                                                       &&detail::is_nothrow_constructible<exception_type>)
       : base{typename base::compatible_conversion_tag(), static_cast<basic_result<T, U, V> &&>(o)}
-      , _ptr()
   {
     no_value_policy_type::on_outcome_move_construction(this, static_cast<basic_result<T, U, V> &&>(o));
   }
@@ -585,7 +610,6 @@ SIGNATURE NOT RECOGNISED
                                                                                                        &&noexcept(make_error_code(std::declval<U>())) &&
                                                                                                        detail::is_nothrow_constructible<exception_type>)
       : base{typename base::make_error_code_compatible_conversion_tag(), o}
-      , _ptr()
   {
     no_value_policy_type::on_outcome_copy_construction(this, o);
   }
@@ -600,7 +624,6 @@ SIGNATURE NOT RECOGNISED
                                                                                                        &&noexcept(make_error_code(std::declval<U>())) &&
                                                                                                        detail::is_nothrow_constructible<exception_type>)
       : base{typename base::make_error_code_compatible_conversion_tag(), static_cast<basic_result<T, U, V> &&>(o)}
-      , _ptr()
   {
     no_value_policy_type::on_outcome_move_construction(this, static_cast<basic_result<T, U, V> &&>(o));
   }
@@ -613,7 +636,6 @@ SIGNATURE NOT RECOGNISED
   BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(predicate::template enable_inplace_value_constructor<Args...>))
   constexpr explicit basic_outcome(in_place_type_t<value_type_if_enabled> _, Args &&... args) noexcept(detail::is_nothrow_constructible<value_type, Args...>)
       : base{_, static_cast<Args &&>(args)...}
-      , _ptr()
   {
     no_value_policy_type::on_outcome_in_place_construction(this, in_place_type<value_type>, static_cast<Args &&>(args)...);
   }
@@ -625,7 +647,6 @@ SIGNATURE NOT RECOGNISED
   constexpr explicit basic_outcome(in_place_type_t<value_type_if_enabled> _, std::initializer_list<U> il,
                                    Args &&... args) noexcept(detail::is_nothrow_constructible<value_type, std::initializer_list<U>, Args...>)
       : base{_, il, static_cast<Args &&>(args)...}
-      , _ptr()
   {
     no_value_policy_type::on_outcome_in_place_construction(this, in_place_type<value_type>, il, static_cast<Args &&>(args)...);
   }
@@ -636,7 +657,6 @@ SIGNATURE NOT RECOGNISED
   BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(predicate::template enable_inplace_error_constructor<Args...>))
   constexpr explicit basic_outcome(in_place_type_t<error_type_if_enabled> _, Args &&... args) noexcept(detail::is_nothrow_constructible<error_type, Args...>)
       : base{_, static_cast<Args &&>(args)...}
-      , _ptr()
   {
     no_value_policy_type::on_outcome_in_place_construction(this, in_place_type<error_type>, static_cast<Args &&>(args)...);
   }
@@ -648,19 +668,39 @@ SIGNATURE NOT RECOGNISED
   constexpr explicit basic_outcome(in_place_type_t<error_type_if_enabled> _, std::initializer_list<U> il,
                                    Args &&... args) noexcept(detail::is_nothrow_constructible<error_type, std::initializer_list<U>, Args...>)
       : base{_, il, static_cast<Args &&>(args)...}
-      , _ptr()
   {
     no_value_policy_type::on_outcome_in_place_construction(this, in_place_type<error_type>, il, static_cast<Args &&>(args)...);
   }
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
+*/
+  template <class F, class... Args>
+  constexpr basic_outcome(detail::in_place_invoke_type_t<value_type_if_enabled> _, F &&f, Args &&... args) noexcept(
+  noexcept(static_cast<F &&>(f)(static_cast<Args &&>(args)...)) &&
+  detail::is_nothrow_constructible<value_type, decltype(static_cast<F &&>(f)(static_cast<Args &&>(args)...))>)
+      : base{_, static_cast<F &&>(f), static_cast<Args &&>(args)...}
+  {
+    no_value_policy_type::on_outcome_in_place_construction(this, in_place_type<value_type>);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F, class... Args>
+  constexpr basic_outcome(detail::in_place_invoke_type_t<error_type_if_enabled> _, F &&f, Args &&... args) noexcept(
+  noexcept(static_cast<F &&>(f)(static_cast<Args &&>(args)...)) &&
+  detail::is_nothrow_constructible<error_type, decltype(static_cast<F &&>(f)(static_cast<Args &&>(args)...))>)
+      : base{_, static_cast<F &&>(f), static_cast<Args &&>(args)...}
+  {
+    no_value_policy_type::on_outcome_in_place_construction(this, in_place_type<error_type>);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
 */
   BOOST_OUTCOME_TEMPLATE(class... Args)
   BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(predicate::template enable_inplace_exception_constructor<Args...>))
   constexpr explicit basic_outcome(in_place_type_t<exception_type_if_enabled> /*unused*/,
                                    Args &&... args) noexcept(detail::is_nothrow_constructible<exception_type, Args...>)
-      : base()
-      , _ptr(static_cast<Args &&>(args)...)
+      : base{typename base::exception_tag(), static_cast<Args &&>(args)...}
   {
     this->_state._status.set_have_exception(true);
     no_value_policy_type::on_outcome_in_place_construction(this, in_place_type<exception_type>, static_cast<Args &&>(args)...);
@@ -672,8 +712,7 @@ SIGNATURE NOT RECOGNISED
   BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(predicate::template enable_inplace_exception_constructor<std::initializer_list<U>, Args...>))
   constexpr explicit basic_outcome(in_place_type_t<exception_type_if_enabled> /*unused*/, std::initializer_list<U> il,
                                    Args &&... args) noexcept(detail::is_nothrow_constructible<exception_type, std::initializer_list<U>, Args...>)
-      : base()
-      , _ptr(il, static_cast<Args &&>(args)...)
+      : base{typename base::exception_tag(), il, static_cast<Args &&>(args)...}
   {
     this->_state._status.set_have_exception(true);
     no_value_policy_type::on_outcome_in_place_construction(this, in_place_type<exception_type>, il, static_cast<Args &&>(args)...);
@@ -731,7 +770,6 @@ SIGNATURE NOT RECOGNISED
   constexpr basic_outcome(const failure_type<T> &o,
                           error_failure_tag /*unused*/ = error_failure_tag()) noexcept(detail::is_nothrow_constructible<error_type, T>)  // NOLINT
       : base{in_place_type<typename base::_error_type>, detail::extract_error_from_failure<error_type>(o)}
-      , _ptr()
   {
     hooks::set_spare_storage(this, o.spare_storage());
     no_value_policy_type::on_outcome_copy_construction(this, o);
@@ -743,8 +781,7 @@ SIGNATURE NOT RECOGNISED
   BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(!std::is_void<T>::value && predicate::template enable_compatible_conversion<void, void, T, void>))
   constexpr basic_outcome(const failure_type<T> &o,
                           exception_failure_tag /*unused*/ = exception_failure_tag()) noexcept(detail::is_nothrow_constructible<exception_type, T>)  // NOLINT
-      : base()
-      , _ptr(detail::extract_exception_from_failure<exception_type>(o))
+      : base{typename base::exception_tag(), detail::extract_exception_from_failure<exception_type>(o)}
   {
     this->_state._status.set_have_exception(true);
     hooks::set_spare_storage(this, o.spare_storage());
@@ -759,7 +796,6 @@ SIGNATURE NOT RECOGNISED
                           explicit_make_error_code_compatible_copy_conversion_tag /*unused*/ =
                           explicit_make_error_code_compatible_copy_conversion_tag()) noexcept(noexcept(make_error_code(std::declval<T>())))  // NOLINT
       : base{in_place_type<typename base::_error_type>, make_error_code(detail::extract_error_from_failure<error_type>(o))}
-      , _ptr()
   {
     hooks::set_spare_storage(this, o.spare_storage());
     no_value_policy_type::on_outcome_copy_construction(this, o);
@@ -771,8 +807,8 @@ SIGNATURE NOT RECOGNISED
   BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(!std::is_void<U>::value && predicate::template enable_compatible_conversion<void, T, U, void>))
   constexpr basic_outcome(const failure_type<T, U> &o, explicit_compatible_copy_conversion_tag /*unused*/ = explicit_compatible_copy_conversion_tag()) noexcept(
   detail::is_nothrow_constructible<error_type, T> &&detail::is_nothrow_constructible<exception_type, U>)  // NOLINT
-      : base{in_place_type<typename base::_error_type>, detail::extract_error_from_failure<error_type>(o)}
-      , _ptr(detail::extract_exception_from_failure<exception_type>(o))
+      : base{typename base::error_exception_tag(), o.has_exception(), detail::extract_error_from_failure<error_type>(o),
+             detail::extract_exception_from_failure<exception_type>(o)}
   {
     if(!o.has_error())
     {
@@ -794,7 +830,6 @@ SIGNATURE NOT RECOGNISED
   constexpr basic_outcome(failure_type<T> &&o,
                           error_failure_tag /*unused*/ = error_failure_tag()) noexcept(detail::is_nothrow_constructible<error_type, T>)  // NOLINT
       : base{in_place_type<typename base::_error_type>, detail::extract_error_from_failure<error_type>(static_cast<failure_type<T> &&>(o))}
-      , _ptr()
   {
     hooks::set_spare_storage(this, o.spare_storage());
     no_value_policy_type::on_outcome_copy_construction(this, o);
@@ -806,8 +841,7 @@ SIGNATURE NOT RECOGNISED
   BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(!std::is_void<T>::value && predicate::template enable_compatible_conversion<void, void, T, void>))
   constexpr basic_outcome(failure_type<T> &&o,
                           exception_failure_tag /*unused*/ = exception_failure_tag()) noexcept(detail::is_nothrow_constructible<exception_type, T>)  // NOLINT
-      : base()
-      , _ptr(detail::extract_exception_from_failure<exception_type>(static_cast<failure_type<T> &&>(o)))
+      : base{typename base::exception_tag(), detail::extract_exception_from_failure<exception_type>(static_cast<failure_type<T> &&>(o))}
   {
     this->_state._status.set_have_exception(true);
     hooks::set_spare_storage(this, o.spare_storage());
@@ -822,7 +856,6 @@ SIGNATURE NOT RECOGNISED
                           explicit_make_error_code_compatible_move_conversion_tag /*unused*/ =
                           explicit_make_error_code_compatible_move_conversion_tag()) noexcept(noexcept(make_error_code(std::declval<T>())))  // NOLINT
       : base{in_place_type<typename base::_error_type>, make_error_code(detail::extract_error_from_failure<error_type>(static_cast<failure_type<T> &&>(o)))}
-      , _ptr()
   {
     hooks::set_spare_storage(this, o.spare_storage());
     no_value_policy_type::on_outcome_copy_construction(this, o);
@@ -834,8 +867,8 @@ SIGNATURE NOT RECOGNISED
   BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(!std::is_void<U>::value && predicate::template enable_compatible_conversion<void, T, U, void>))
   constexpr basic_outcome(failure_type<T, U> &&o, explicit_compatible_move_conversion_tag /*unused*/ = explicit_compatible_move_conversion_tag()) noexcept(
   detail::is_nothrow_constructible<error_type, T> &&detail::is_nothrow_constructible<exception_type, U>)  // NOLINT
-      : base{in_place_type<typename base::_error_type>, detail::extract_error_from_failure<error_type>(static_cast<failure_type<T, U> &&>(o))}
-      , _ptr(detail::extract_exception_from_failure<exception_type>(static_cast<failure_type<T, U> &&>(o)))
+      : base{typename base::error_exception_tag(), o.has_exception(), detail::extract_error_from_failure<error_type>(static_cast<failure_type<T, U> &&>(o)),
+             detail::extract_exception_from_failure<exception_type>(static_cast<failure_type<T, U> &&>(o))}
   {
     if(!o.has_error())
     {
@@ -868,20 +901,20 @@ SIGNATURE NOT RECOGNISED
   {
     if(this->_state._status.have_value() && o._state._status.have_value())
     {
-      return this->_state._value == o._state._value;  // NOLINT
+      return this->_state._value_ref() == o._state._value_ref();  // NOLINT
     }
     if(this->_state._status.have_error() && o._state._status.have_error()  //
        && this->_state._status.have_exception() && o._state._status.have_exception())
     {
-      return this->_state._error == o._state._error && this->_ptr == o._ptr;
+      return this->_state._error_ref() == o._state._error_ref() && this->_exception_storage() == o._exception_storage();
     }
     if(this->_state._status.have_error() && o._state._status.have_error())
     {
-      return this->_state._error == o._state._error;
+      return this->_state._error_ref() == o._state._error_ref();
     }
     if(this->_state._status.have_exception() && o._state._status.have_exception())
     {
-      return this->_ptr == o._ptr;
+      return this->_exception_storage() == o._exception_storage();
     }
     return false;
   }
@@ -897,15 +930,15 @@ SIGNATURE NOT RECOGNISED
     if(this->_state._status.have_error() && o._state._status.have_error()  //
        && this->_state._status.have_exception() && o._state._status.have_exception())
     {
-      return this->_state._error == o.error() && this->_ptr == o.exception();
+      return this->_state._error_ref() == o.error() && this->_exception_storage() == o.exception();
     }
     if(this->_state._status.have_error() && o._state._status.have_error())
     {
-      return this->_state._error == o.error();
+      return this->_state._error_ref() == o.error();
     }
     if(this->_state._status.have_exception() && o._state._status.have_exception())
     {
-      return this->_ptr == o.exception();
+      return this->_exception_storage() == o.exception();
     }
     return false;
   }
@@ -923,20 +956,20 @@ SIGNATURE NOT RECOGNISED
   {
     if(this->_state._status.have_value() && o._state._status.have_value())
     {
-      return this->_state._value != o._state._value;  // NOLINT
+      return this->_state._value_ref() != o._state._value_ref();  // NOLINT
     }
     if(this->_state._status.have_error() && o._state._status.have_error()  //
        && this->_state._status.have_exception() && o._state._status.have_exception())
     {
-      return this->_state._error != o._state._error || this->_ptr != o._ptr;
+      return this->_state._error_ref() != o._state._error_ref() || this->_exception_storage() != o._exception_storage();
     }
     if(this->_state._status.have_error() && o._state._status.have_error())
     {
-      return this->_state._error != o._state._error;
+      return this->_state._error_ref() != o._state._error_ref();
     }
     if(this->_state._status.have_exception() && o._state._status.have_exception())
     {
-      return this->_ptr != o._ptr;
+      return this->_exception_storage() != o._exception_storage();
     }
     return true;
   }
@@ -952,15 +985,15 @@ SIGNATURE NOT RECOGNISED
     if(this->_state._status.have_error() && o._state._status.have_error()  //
        && this->_state._status.have_exception() && o._state._status.have_exception())
     {
-      return this->_state._error != o.error() || this->_ptr != o.exception();
+      return this->_state._error_ref() != o.error() || this->_exception_storage() != o.exception();
     }
     if(this->_state._status.have_error() && o._state._status.have_error())
     {
-      return this->_state._error != o.error();
+      return this->_state._error_ref() != o.error();
     }
     if(this->_state._status.have_exception() && o._state._status.have_exception())
     {
-      return this->_ptr != o.exception();
+      return this->_exception_storage() != o.exception();
     }
     return true;
   }
@@ -968,13 +1001,24 @@ SIGNATURE NOT RECOGNISED
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-  constexpr void swap(basic_outcome &o) noexcept((std::is_void<value_type>::value || detail::is_nothrow_swappable<value_type>::value)     //
-                                                 && (std::is_void<error_type>::value || detail::is_nothrow_swappable<error_type>::value)  //
+  constexpr void swap(basic_outcome &o) noexcept((detail::is_bitwise_swappable<value_type, error_type>::value                                       //
+                                                  || ((std::is_void<value_type>::value || detail::is_nothrow_swappable<value_type>::value)   //
+                                                      && (std::is_void<error_type>::value || detail::is_nothrow_swappable<error_type>::value)))  //
                                                  && (std::is_void<exception_type>::value || detail::is_nothrow_swappable<exception_type>::value))
   {
+    _swap(o, std::integral_constant<bool, base::_exception_shares_value_storage>());
+  }
+
+private:
+  // The exception lives in the storage of the value, so it must be moved out of the way of the value + error swap
+  void _swap(basic_outcome &o, std::true_type /*unused*/) { this->_swap_exception_storage(o); }
+  constexpr void _swap(basic_outcome &o, std::false_type /*unused*/)
+  {
 #ifndef BOOST_NO_EXCEPTIONS
-    constexpr bool value_throws = !std::is_void<value_type>::value && !detail::is_nothrow_swappable<value_type>::value;
-    constexpr bool error_throws = !std::is_void<error_type>::value && !detail::is_nothrow_swappable<error_type>::value;
+    // Value and error storage which is swapped by exchanging bytes cannot throw
+    constexpr bool bitwise = detail::is_bitwise_swappable<value_type, error_type>::value;
+    constexpr bool value_throws = !bitwise && !std::is_void<value_type>::value && !detail::is_nothrow_swappable<value_type>::value;
+    constexpr bool error_throws = !bitwise && !std::is_void<error_type>::value && !detail::is_nothrow_swappable<error_type>::value;
     constexpr bool exception_throws = !std::is_void<exception_type>::value && !detail::is_nothrow_swappable<exception_type>::value;
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -1049,6 +1093,7 @@ SIGNATURE NOT RECOGNISED
 #endif
   }
 
+public:
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
@@ -1083,9 +1128,147 @@ SIGNATURE NOT RECOGNISED
     return failure_type<error_type, exception_type>(in_place_type<error_type>, static_cast<S &&>(this->assume_error()), hooks::spare_storage(this));
   }
 
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto and_then(F &&f) & { return _and_then(*this, static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto and_then(F &&f) const & { return _and_then(*this, static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto and_then(F &&f) && { return _and_then(static_cast<basic_outcome &&>(*this), static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto and_then(F &&f) const && { return _and_then(static_cast<const basic_outcome &&>(*this), static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto transform(F &&f) & { return _transform(*this, static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto transform(F &&f) const & { return _transform(*this, static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto transform(F &&f) && { return _transform(static_cast<basic_outcome &&>(*this), static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto transform(F &&f) const && { return _transform(static_cast<const basic_outcome &&>(*this), static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto or_else(F &&f) & { return _or_else(*this, static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto or_else(F &&f) const & { return _or_else(*this, static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto or_else(F &&f) && { return _or_else(static_cast<basic_outcome &&>(*this), static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto or_else(F &&f) const && { return _or_else(static_cast<const basic_outcome &&>(*this), static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto transform_error(F &&f) & { return _transform_error(*this, static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto transform_error(F &&f) const & { return _transform_error(*this, static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto transform_error(F &&f) && { return _transform_error(static_cast<basic_outcome &&>(*this), static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto transform_error(F &&f) const && { return _transform_error(static_cast<const basic_outcome &&>(*this), static_cast<F &&>(f)); }
+
 #ifdef __APPLE__
   failure_type<error_type, exception_type> _xcode_workaround_as_failure() &&;
 #endif
+
+protected:
+  // The outcome of a monadic operation which changes the value or error type
+  template <class T> using _rebind_value = basic_outcome<T, error_type, exception_type, typename detail::rebind_policy_value<NoValuePolicy, T>::type>;
+  template <class U> using _rebind_error = basic_outcome<value_type, U, exception_type, typename detail::rebind_policy_error<NoValuePolicy, U>::type>;
+
+  // Propagates the error and/or exception of a failed outcome into a U with the same error and exception types
+  template <class U, class Self> static constexpr U _propagate_failure(Self &&self)
+  {
+    static_assert(std::is_same<typename U::error_type, error_type>::value && std::is_same<typename U::exception_type, exception_type>::value,
+                  "Propagating a failure requires a basic_outcome with the same error_type and exception_type");
+    if(self.has_error())
+    {
+      U ret = detail::make_error_from<U>(std::is_void<error_type>(), static_cast<Self &&>(self));
+      if(self.has_exception())
+      {
+        detail::copy_exception_into(std::is_void<exception_type>(), &ret, static_cast<Self &&>(self));
+      }
+      return ret;
+    }
+    return detail::make_exception_from<U>(std::is_void<exception_type>(), static_cast<Self &&>(self));
+  }
+  template <class Self, class F, class U = detail::invoke_on_value_type<F, Self>> static constexpr U _and_then(Self &&self, F &&f)
+  {
+    static_assert(is_basic_outcome_v<U>, "and_then() requires a callable returning a basic_outcome");
+    if(self.has_value())
+    {
+      return detail::invoke_on_value(std::is_void<value_type>(), static_cast<F &&>(f), static_cast<Self &&>(self));
+    }
+    return _propagate_failure<U>(static_cast<Self &&>(self));
+  }
+  template <class Self, class F, class U = detail::invoke_on_value_type<F, Self>> static constexpr _rebind_value<U> _transform(Self &&self, F &&f)
+  {
+    if(self.has_value())
+    {
+      return detail::invoke_into_value<_rebind_value<U>>(std::is_void<U>(), std::is_void<value_type>(), static_cast<F &&>(f), static_cast<Self &&>(self));
+    }
+    return _propagate_failure<_rebind_value<U>>(static_cast<Self &&>(self));
+  }
+  template <class Self, class F, class U = detail::invoke_on_error_type<F, Self>> static constexpr U _or_else(Self &&self, F &&f)
+  {
+    static_assert(is_basic_outcome_v<U>, "or_else() requires a callable returning a basic_outcome");
+    static_assert(std::is_same<typename U::value_type, value_type>::value, "or_else() requires a callable returning a basic_outcome with the same value_type");
+    if(self.has_value())
+    {
+      return detail::make_value_from<U>(std::is_void<value_type>(), static_cast<Self &&>(self));
+    }
+    // Failures with an exception are not recoverable from their error alone
+    if(self.has_exception())
+    {
+      return _propagate_failure<U>(static_cast<Self &&>(self));
+    }
+    return detail::invoke_on_error(std::is_void<error_type>(), static_cast<F &&>(f), static_cast<Self &&>(self));
+  }
+  template <class Self, class F, class G = detail::invoke_on_error_type<F, Self>>
+  static constexpr _rebind_error<G> _transform_error(Self &&self, F &&f)
+  {
+    if(self.has_value())
+    {
+      return detail::make_value_from<_rebind_error<G>>(std::is_void<value_type>(), static_cast<Self &&>(self));
+    }
+    if(self.has_error())
+    {
+      _rebind_error<G> ret =
+      detail::invoke_into_error<_rebind_error<G>>(std::is_void<G>(), std::is_void<error_type>(), static_cast<F &&>(f), static_cast<Self &&>(self));
+      if(self.has_exception())
+      {
+        detail::copy_exception_into(std::is_void<exception_type>(), &ret, static_cast<Self &&>(self));
+      }
+      return ret;
+    }
+    return detail::make_exception_from<_rebind_error<G>>(std::is_void<exception_type>(), static_cast<Self &&>(self));
+  }
 };
 
 // C++ 20 operator== rewriting should take care of this for us, indeed
@@ -1130,7 +1313,7 @@ SIGNATURE NOT RECOGNISED
   template <class R, class S, class P, class NoValuePolicy, class U>
   constexpr inline void override_outcome_exception(basic_outcome<R, S, P, NoValuePolicy> *o, U &&v) noexcept
   {
-    o->_ptr = static_cast<U &&>(v);  // NOLINT
+    o->_assign_exception(static_cast<U &&>(v));  // NOLINT
     o->_state._status.set_have_exception(true);
   }
 }  // namespace hooks
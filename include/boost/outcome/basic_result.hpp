@@ -153,6 +153,110 @@ namespace detail
   }
   template <class T, class V> constexpr inline T extract_error_from_failure(const failure_type<void, V> & /*unused*/) { return T{}; }
 
+  /* Rebinds a no-value policy templated on the value, error and exception types, such as
+  error_code_throw_as_system_error<T, EC, E>, to a new value or error type. Other policies are left alone.
+  */
+  template <class Policy, class T> struct rebind_policy_value
+  {
+    using type = Policy;
+  };
+  template <template <class, class, class> class Policy, class T0, class EC, class E, class T> struct rebind_policy_value<Policy<T0, EC, E>, T>
+  {
+    using type = Policy<T, EC, E>;
+  };
+  template <class Policy, class EC> struct rebind_policy_error
+  {
+    using type = Policy;
+  };
+  template <template <class, class, class> class Policy, class T, class EC0, class E, class EC> struct rebind_policy_error<Policy<T, EC0, E>, EC>
+  {
+    using type = Policy<T, EC, E>;
+  };
+  template <template <class, class> class Policy, class EC0, class E, class EC> struct rebind_policy_error<Policy<EC0, E>, EC>
+  {
+    using type = Policy<EC, E>;
+  };
+
+  // Invokes f with the value or error of o, or with nothing if that is void
+  template <class F, class O> constexpr inline decltype(auto) invoke_on_value(std::false_type /*is void*/, F &&f, O &&o)
+  {
+    return static_cast<F &&>(f)(static_cast<O &&>(o).assume_value());
+  }
+  template <class F, class O> constexpr inline decltype(auto) invoke_on_value(std::true_type /*is void*/, F &&f, O && /*unused*/)
+  {
+    return static_cast<F &&>(f)();
+  }
+  template <class F, class O> constexpr inline decltype(auto) invoke_on_error(std::false_type /*is void*/, F &&f, O &&o)
+  {
+    return static_cast<F &&>(f)(static_cast<O &&>(o).assume_error());
+  }
+  template <class F, class O> constexpr inline decltype(auto) invoke_on_error(std::true_type /*is void*/, F &&f, O && /*unused*/)
+  {
+    return static_cast<F &&>(f)();
+  }
+  template <class F, class O> using invoke_on_value_type = std::decay_t<decltype(invoke_on_value(
+                                                           std::is_void<typename std::decay_t<O>::value_type>(), std::declval<F>(), std::declval<O>()))>;
+  template <class F, class O> using invoke_on_error_type = std::decay_t<decltype(invoke_on_error(
+                                                           std::is_void<typename std::decay_t<O>::error_type>(), std::declval<F>(), std::declval<O>()))>;
+
+  // Constructs an R holding the value or error of o, or an empty one if that is void
+  template <class R, class O> constexpr inline R make_value_from(std::false_type /*is void*/, O &&o)
+  {
+    return R(in_place_type<typename R::value_type_if_enabled>, static_cast<O &&>(o).assume_value());
+  }
+  template <class R, class O> constexpr inline R make_value_from(std::true_type /*is void*/, O && /*unused*/)
+  {
+    return R(in_place_type<typename R::value_type_if_enabled>);
+  }
+  template <class R, class O> constexpr inline R make_error_from(std::false_type /*is void*/, O &&o)
+  {
+    return R(in_place_type<typename R::error_type_if_enabled>, static_cast<O &&>(o).assume_error());
+  }
+  template <class R, class O> constexpr inline R make_error_from(std::true_type /*is void*/, O && /*unused*/)
+  {
+    return R(in_place_type<typename R::error_type_if_enabled>);
+  }
+
+  /* Constructs an R whose value or error is the return of invoking f with the value or error of o. The first
+  tag is whether R's value or error is void, the second whether o's is. The return is never moved.
+  */
+  template <class R, class F, class O> constexpr inline R invoke_into_value(std::false_type, std::false_type, F &&f, O &&o)
+  {
+    return R(in_place_invoke_type_t<typename R::value_type_if_enabled>(), static_cast<F &&>(f), static_cast<O &&>(o).assume_value());
+  }
+  template <class R, class F, class O> constexpr inline R invoke_into_value(std::false_type, std::true_type, F &&f, O && /*unused*/)
+  {
+    return R(in_place_invoke_type_t<typename R::value_type_if_enabled>(), static_cast<F &&>(f));
+  }
+  template <class R, class F, class O> constexpr inline R invoke_into_value(std::true_type, std::false_type, F &&f, O &&o)
+  {
+    static_cast<F &&>(f)(static_cast<O &&>(o).assume_value());
+    return R(in_place_type<typename R::value_type_if_enabled>);
+  }
+  template <class R, class F, class O> constexpr inline R invoke_into_value(std::true_type, std::true_type, F &&f, O && /*unused*/)
+  {
+    static_cast<F &&>(f)();
+    return R(in_place_type<typename R::value_type_if_enabled>);
+  }
+  template <class R, class F, class O> constexpr inline R invoke_into_error(std::false_type, std::false_type, F &&f, O &&o)
+  {
+    return R(in_place_invoke_type_t<typename R::error_type_if_enabled>(), static_cast<F &&>(f), static_cast<O &&>(o).assume_error());
+  }
+  template <class R, class F, class O> constexpr inline R invoke_into_error(std::false_type, std::true_type, F &&f, O && /*unused*/)
+  {
+    return R(in_place_invoke_type_t<typename R::error_type_if_enabled>(), static_cast<F &&>(f));
+  }
+  template <class R, class F, class O> constexpr inline R invoke_into_error(std::true_type, std::false_type, F &&f, O &&o)
+  {
+    static_cast<F &&>(f)(static_cast<O &&>(o).assume_error());
+    return R(in_place_type<typename R::error_type_if_enabled>);
+  }
+  template <class R, class F, class O> constexpr inline R invoke_into_error(std::true_type, std::true_type, F &&f, O && /*unused*/)
+  {
+    static_cast<F &&>(f)();
+    return R(in_place_type<typename R::error_type_if_enabled>);
+  }
+
   template <class T> struct is_basic_result
   {
     static constexpr bool value = false;
@@ -172,6 +276,18 @@ SIGNATURE NOT RECOGNISED
 */
 template <class T> static constexpr bool is_basic_result_v = detail::is_basic_result<std::decay_t<T>>::value;
 
+namespace trait
+{
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class R, class S, class NoValuePolicy> struct is_trivially_relocatable<basic_result<R, S, NoValuePolicy>>
+  {
+    static constexpr bool value =
+    is_trivially_relocatable<BOOST_OUTCOME_V2_NAMESPACE::detail::devoid<R>>::value && is_trivially_relocatable<BOOST_OUTCOME_V2_NAMESPACE::detail::devoid<S>>::value;
+  };
+}  // namespace trait
+
 namespace concepts
 {
 #if defined(__cpp_concepts)
@@ -217,17 +333,17 @@ namespace hooks
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-  template <class R, class S, class NoValuePolicy> constexpr inline uint16_t spare_storage(const detail::basic_result_storage<R, S, NoValuePolicy> *r) noexcept
+  template <class R, class S, class NoValuePolicy> constexpr inline spare_storage_type spare_storage(const detail::basic_result_storage<R, S, NoValuePolicy> *r) noexcept
   {
-    return r->_state._status.spare_storage_value;
+    return r->_state._status.spare_storage();
   }
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
   template <class R, class S, class NoValuePolicy>
-  constexpr inline void set_spare_storage(detail::basic_result_storage<R, S, NoValuePolicy> *r, uint16_t v) noexcept
+  constexpr inline void set_spare_storage(detail::basic_result_storage<R, S, NoValuePolicy> *r, spare_storage_type v) noexcept
   {
-    r->_state._status.spare_storage_value = v;
+    r->_state._status.set_spare_storage(v);
   }
 }  // namespace hooks
 
@@ -235,7 +351,7 @@ SIGNATURE NOT RECOGNISED
 type definition template <class R, class S, class NoValuePolicy> basic_result. Potential doc page: `basic_result<T, E, NoValuePolicy>`
 */
 template <class R, class S, class NoValuePolicy>  //
-class BOOST_OUTCOME_NODISCARD basic_result : public detail::basic_result_final<R, S, NoValuePolicy>
+class BOOST_OUTCOME_NODISCARD BOOST_OUTCOME_TRIVIAL_ABI basic_result : public detail::basic_result_final<R, S, NoValuePolicy>
 {
   static_assert(trait::type_can_be_used_in_basic_result<R>, "The type R cannot be used in a basic_result");
   static_assert(trait::type_can_be_used_in_basic_result<S>, "The type S cannot be used in a basic_result");
@@ -573,6 +689,28 @@ SIGNATURE NOT RECOGNISED
   }
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
+*/
+  template <class F, class... Args>
+  constexpr basic_result(detail::in_place_invoke_type_t<value_type_if_enabled> _, F &&f, Args &&... args) noexcept(
+  noexcept(static_cast<F &&>(f)(static_cast<Args &&>(args)...)) &&
+  detail::is_nothrow_constructible<value_type, decltype(static_cast<F &&>(f)(static_cast<Args &&>(args)...))>)
+      : base{_, static_cast<F &&>(f), static_cast<Args &&>(args)...}
+  {
+    no_value_policy_type::on_result_in_place_construction(this, in_place_type<value_type>);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F, class... Args>
+  constexpr basic_result(detail::in_place_invoke_type_t<error_type_if_enabled> _, F &&f, Args &&... args) noexcept(
+  noexcept(static_cast<F &&>(f)(static_cast<Args &&>(args)...)) &&
+  detail::is_nothrow_constructible<error_type, decltype(static_cast<F &&>(f)(static_cast<Args &&>(args)...))>)
+      : base{_, static_cast<F &&>(f), static_cast<Args &&>(args)...}
+  {
+    no_value_policy_type::on_result_in_place_construction(this, in_place_type<error_type>);
+  }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
 */
   BOOST_OUTCOME_TEMPLATE(class A1, class A2, class... Args)
   BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(predicate::template enable_inplace_value_error_constructor<A1, A2, Args...>))
@@ -694,8 +832,9 @@ SIGNATURE NOT RECOGNISED
   /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
-  constexpr void swap(basic_result &o) noexcept((std::is_void<value_type>::value || detail::is_nothrow_swappable<value_type>::value)  //
-                                                && (std::is_void<error_type>::value || detail::is_nothrow_swappable<error_type>::value))
+  constexpr void swap(basic_result &o) noexcept(detail::is_bitwise_swappable<value_type, error_type>::value                                     //
+                                                || ((std::is_void<value_type>::value || detail::is_nothrow_swappable<value_type>::value)  //
+                                                    && (std::is_void<error_type>::value || detail::is_nothrow_swappable<error_type>::value)))
   {
     this->_state.swap(o._state);
   }
@@ -713,9 +852,117 @@ SIGNATURE NOT RECOGNISED
     return failure(static_cast<basic_result &&>(*this).assume_error(), hooks::spare_storage(this));
   }
 
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto and_then(F &&f) & { return _and_then(*this, static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto and_then(F &&f) const & { return _and_then(*this, static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto and_then(F &&f) && { return _and_then(static_cast<basic_result &&>(*this), static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto and_then(F &&f) const && { return _and_then(static_cast<const basic_result &&>(*this), static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto transform(F &&f) & { return _transform(*this, static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto transform(F &&f) const & { return _transform(*this, static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto transform(F &&f) && { return _transform(static_cast<basic_result &&>(*this), static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto transform(F &&f) const && { return _transform(static_cast<const basic_result &&>(*this), static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto or_else(F &&f) & { return _or_else(*this, static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto or_else(F &&f) const & { return _or_else(*this, static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto or_else(F &&f) && { return _or_else(static_cast<basic_result &&>(*this), static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto or_else(F &&f) const && { return _or_else(static_cast<const basic_result &&>(*this), static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto transform_error(F &&f) & { return _transform_error(*this, static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto transform_error(F &&f) const & { return _transform_error(*this, static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto transform_error(F &&f) && { return _transform_error(static_cast<basic_result &&>(*this), static_cast<F &&>(f)); }
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class F> constexpr auto transform_error(F &&f) const && { return _transform_error(static_cast<const basic_result &&>(*this), static_cast<F &&>(f)); }
+
 #ifdef __APPLE__
   failure_type<error_type> _xcode_workaround_as_failure() &&;
 #endif
+
+protected:
+  // The result of a monadic operation which changes the value or error type
+  template <class T> using _rebind_value = basic_result<T, error_type, typename detail::rebind_policy_value<NoValuePolicy, T>::type>;
+  template <class U> using _rebind_error = basic_result<value_type, U, typename detail::rebind_policy_error<NoValuePolicy, U>::type>;
+
+  template <class Self, class F, class U = detail::invoke_on_value_type<F, Self>> static constexpr U _and_then(Self &&self, F &&f)
+  {
+    static_assert(is_basic_result_v<U>, "and_then() requires a callable returning a basic_result");
+    static_assert(std::is_same<typename U::error_type, error_type>::value, "and_then() requires a callable returning a basic_result with the same error_type");
+    if(self.has_value())
+    {
+      return detail::invoke_on_value(std::is_void<value_type>(), static_cast<F &&>(f), static_cast<Self &&>(self));
+    }
+    return detail::make_error_from<U>(std::is_void<error_type>(), static_cast<Self &&>(self));
+  }
+  template <class Self, class F, class U = detail::invoke_on_value_type<F, Self>> static constexpr _rebind_value<U> _transform(Self &&self, F &&f)
+  {
+    if(self.has_value())
+    {
+      return detail::invoke_into_value<_rebind_value<U>>(std::is_void<U>(), std::is_void<value_type>(), static_cast<F &&>(f), static_cast<Self &&>(self));
+    }
+    return detail::make_error_from<_rebind_value<U>>(std::is_void<error_type>(), static_cast<Self &&>(self));
+  }
+  template <class Self, class F, class U = detail::invoke_on_error_type<F, Self>> static constexpr U _or_else(Self &&self, F &&f)
+  {
+    static_assert(is_basic_result_v<U>, "or_else() requires a callable returning a basic_result");
+    static_assert(std::is_same<typename U::value_type, value_type>::value, "or_else() requires a callable returning a basic_result with the same value_type");
+    if(self.has_value())
+    {
+      return detail::make_value_from<U>(std::is_void<value_type>(), static_cast<Self &&>(self));
+    }
+    return detail::invoke_on_error(std::is_void<error_type>(), static_cast<F &&>(f), static_cast<Self &&>(self));
+  }
+  template <class Self, class F, class G = detail::invoke_on_error_type<F, Self>>
+  static constexpr _rebind_error<G> _transform_error(Self &&self, F &&f)
+  {
+    if(self.has_value())
+    {
+      return detail::make_value_from<_rebind_error<G>>(std::is_void<value_type>(), static_cast<Self &&>(self));
+    }
+    return detail::invoke_into_error<_rebind_error<G>>(std::is_void<G>(), std::is_void<error_type>(), static_cast<F &&>(f), static_cast<Self &&>(self));
+  }
 };
 
 /*! AWAITING HUGO JSON CONVERSION TOOL
@@ -0,0 +1,398 @@
+/* Collection of ranges of results into a result of a container
+(C) 2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2024
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef BOOST_OUTCOME_COLLECT_HPP
+#define BOOST_OUTCOME_COLLECT_HPP
+
+#include "basic_outcome.hpp"
+#include "policy/terminate.hpp"
+
+#include <exception>  // for std::terminate
+#include <iterator>
+#include <memory>  // for std::allocator
+#include <vector>
+
+BOOST_OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+type definition template <class T, size_t N> small_vector. Potential doc page: `small_vector<T, N>`
+*/
+template <class T, size_t N> class small_vector
+{
+  static_assert(N > 0, "small_vector needs an inline capacity of at least one");
+
+public:
+  using value_type = T;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using reference = T &;
+  using const_reference = const T &;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using iterator = T *;
+  using const_iterator = const T *;
+
+  //! The number of items which can be stored before allocating memory
+  static constexpr size_type inline_capacity = N;
+
+private:
+  T *_begin;
+  size_type _size{0}, _capacity{N};
+  alignas(T) unsigned char _inline[N * sizeof(T)];
+
+  T *_inline_ptr() noexcept { return reinterpret_cast<T *>(_inline); }
+  void _deallocate() noexcept
+  {
+    if(_begin != _inline_ptr())
+    {
+      std::allocator<T>().deallocate(_begin, _capacity);
+      _begin = _inline_ptr();
+      _capacity = N;
+    }
+  }
+  // Owns newly allocated storage until it is adopted
+  struct _allocation
+  {
+    T *mem;
+    size_type capacity;
+    explicit _allocation(size_type n)
+        : mem(std::allocator<T>().allocate(n))
+        , capacity(n)
+    {
+    }
+    _allocation(const _allocation &) = delete;
+    _allocation &operator=(const _allocation &) = delete;
+    ~_allocation()
+    {
+      if(mem != nullptr)
+      {
+        std::allocator<T>().deallocate(mem, capacity);
+      }
+    }
+  };
+  // Relocates the items into newly allocated storage. If a move constructor throws, all items are lost.
+  void _adopt(_allocation &a) noexcept(trait::is_trivially_relocatable<T>::value || std::is_nothrow_move_constructible<T>::value)
+  {
+    struct _
+    {
+      size_type *size;
+      ~_()
+      {
+        if(size != nullptr)
+        {
+          // relocate_n() leaves both ranges empty if a move constructor throws
+          *size = 0;
+        }
+      }
+    } _{&_size};
+    relocate_n(_begin, _size, a.mem);
+    _.size = nullptr;
+    _deallocate();
+    _begin = a.mem;
+    _capacity = a.capacity;
+    a.mem = nullptr;
+  }
+  void _steal(small_vector &o) noexcept(trait::is_trivially_relocatable<T>::value || std::is_nothrow_move_constructible<T>::value)
+  {
+    if(o._begin != o._inline_ptr())
+    {
+      _begin = o._begin;
+      _capacity = o._capacity;
+      o._begin = o._inline_ptr();
+      o._capacity = N;
+    }
+    else
+    {
+      relocate_n(o._begin, o._size, _begin);
+    }
+    _size = o._size;
+    o._size = 0;
+  }
+  size_type _grown_capacity(size_type n) const noexcept { return (n > 2 * _capacity) ? n : 2 * _capacity; }
+
+public:
+  //! Default constructor.
+  small_vector() noexcept
+      : _begin(_inline_ptr())
+  {
+  }
+  //! Copy constructor.
+  small_vector(const small_vector &o)
+      : small_vector()
+  {
+    reserve(o._size);
+    for(const auto &i : o)
+    {
+      push_back(i);
+    }
+  }
+  //! Move constructor. Steals any allocated storage, otherwise relocates the inline items.
+  small_vector(small_vector &&o) noexcept(trait::is_trivially_relocatable<T>::value || std::is_nothrow_move_constructible<T>::value)
+      : small_vector()
+  {
+    _steal(o);
+  }
+  //! Copy assignment.
+  small_vector &operator=(const small_vector &o)
+  {
+    if(this != &o)
+    {
+      clear();
+      reserve(o._size);
+      for(const auto &i : o)
+      {
+        push_back(i);
+      }
+    }
+    return *this;
+  }
+  //! Move assignment.
+  small_vector &operator=(small_vector &&o) noexcept(trait::is_trivially_relocatable<T>::value || std::is_nothrow_move_constructible<T>::value)
+  {
+    if(this != &o)
+    {
+      clear();
+      _deallocate();
+      _steal(o);
+    }
+    return *this;
+  }
+  ~small_vector()
+  {
+    clear();
+    _deallocate();
+  }
+
+  //! True if the items are stored inline, and no memory has been allocated.
+  bool is_inline() const noexcept { return _begin == reinterpret_cast<const T *>(_inline); }
+  //! True if empty.
+  bool empty() const noexcept { return _size == 0; }
+  //! The number of items.
+  size_type size() const noexcept { return _size; }
+  //! The number of items which can be stored without allocating memory.
+  size_type capacity() const noexcept { return _capacity; }
+
+  T *data() noexcept { return _begin; }
+  const T *data() const noexcept { return _begin; }
+  iterator begin() noexcept { return _begin; }
+  const_iterator begin() const noexcept { return _begin; }
+  iterator end() noexcept { return _begin + _size; }
+  const_iterator end() const noexcept { return _begin + _size; }
+  reference operator[](size_type idx) noexcept { return _begin[idx]; }
+  const_reference operator[](size_type idx) const noexcept { return _begin[idx]; }
+  reference front() noexcept { return _begin[0]; }
+  const_reference front() const noexcept { return _begin[0]; }
+  reference back() noexcept { return _begin[_size - 1]; }
+  const_reference back() const noexcept { return _begin[_size - 1]; }
+
+  //! Ensures there is capacity for at least `n` items.
+  void reserve(size_type n)
+  {
+    if(n > _capacity)
+    {
+      _allocation a(n);
+      _adopt(a);
+    }
+  }
+  //! Constructs an item at the end. The basic guarantee only is provided if growing the storage is needed, and moving `T` can throw.
+  template <class... Args> reference emplace_back(Args &&... args)
+  {
+    if(_size < _capacity)
+    {
+      new(_begin + _size) T(static_cast<Args &&>(args)...);
+      return _begin[_size++];
+    }
+    // Construct the new item before relocating the old ones, as args may refer to them
+    _allocation a(_grown_capacity(_size + 1));
+    T *item = new(a.mem + _size) T(static_cast<Args &&>(args)...);
+    struct _
+    {
+      T *item;
+      ~_()
+      {
+        if(item != nullptr)
+        {
+          item->~T();
+        }
+      }
+    } _{item};
+    _adopt(a);
+    _.item = nullptr;
+    return _begin[_size++];
+  }
+  //! Copies an item onto the end.
+  void push_back(const T &v) { emplace_back(v); }
+  //! Moves an item onto the end.
+  void push_back(T &&v) { emplace_back(static_cast<T &&>(v)); }
+  //! Destroys the last item.
+  void pop_back() noexcept { _begin[--_size].~T(); }
+  //! Destroys all items, retaining any allocated storage.
+  void clear() noexcept
+  {
+    while(_size > 0)
+    {
+      pop_back();
+    }
+  }
+};
+
+namespace detail
+{
+  template <class Range> using collect_iterator = decltype(std::begin(std::declval<Range &>()));
+  // Moves out of the items of ranges passed as rvalues, copies out of the items of ranges passed as lvalues
+  template <class Range>
+  using collect_item_ref = std::conditional_t<std::is_lvalue_reference<Range>::value, decltype(*std::declval<collect_iterator<Range>>()),
+                                              std::remove_reference_t<decltype(*std::declval<collect_iterator<Range>>())> &&>;
+  template <class Range> using collect_item = std::decay_t<collect_item_ref<Range>>;
+
+  template <class Range> using collect_has_size = decltype(std::declval<Range &>().size());
+  template <class Container> using collect_has_reserve = decltype(std::declval<Container &>().reserve(size_t(0)));
+  template <class Container, class T> using collect_has_push_back = decltype(std::declval<Container &>().push_back(std::declval<T>()));
+
+  // Returns the size of the range if it can be known without walking it, otherwise zero
+  template <class Range> inline size_t collect_size(Range &r, std::true_type /*has size()*/) { return static_cast<size_t>(r.size()); }
+  template <class Range> inline size_t collect_size(Range &r, std::false_type /*has size()*/)
+  {
+    using category = typename std::iterator_traits<collect_iterator<Range>>::iterator_category;
+    return std::is_base_of<std::random_access_iterator_tag, category>::value ? static_cast<size_t>(std::distance(std::begin(r), std::end(r))) : 0;
+  }
+  template <class Container> inline void collect_reserve(Container &c, size_t n, std::true_type /*has reserve()*/)
+  {
+    if(n > 0)
+    {
+      c.reserve(n);
+    }
+  }
+  template <class Container> inline void collect_reserve(Container & /*unused*/, size_t /*unused*/, std::false_type /*has reserve()*/) {}
+  template <class Range, class Container> inline void collect_prepare(Range &r, Container &c)
+  {
+    collect_reserve(c, collect_size(r, std::integral_constant<bool, trait::detail::is_detected<collect_has_size, Range>::value>()),
+                    std::integral_constant<bool, trait::detail::is_detected<collect_has_reserve, Container>::value>());
+  }
+
+  template <class Container, class T> inline void collect_append(Container &c, T &&v, std::true_type /*has push_back()*/) { c.push_back(static_cast<T &&>(v)); }
+  template <class Container, class T> inline void collect_append(Container &c, T &&v, std::false_type /*has push_back()*/)
+  {
+    c.insert(c.end(), static_cast<T &&>(v));
+  }
+  template <class Container, class T> inline void collect_append(Container &c, T &&v)
+  {
+    collect_append(c, static_cast<T &&>(v), std::integral_constant<bool, trait::detail::is_detected<collect_has_push_back, Container, T &&>::value>());
+  }
+
+  // Never invoked, this exists only to have transform() propagate a failure into a result of the container
+  template <class Container> struct collect_failure
+  {
+    template <class... Args> Container operator()(Args &&... /*unused*/) const { std::terminate(); }
+  };
+
+  template <class Range> struct collect_traits
+  {
+    using item_ref = collect_item_ref<Range>;
+    using item_type = collect_item<Range>;
+    static_assert(is_basic_result_v<item_type> || is_basic_outcome_v<item_type>, "collect() requires a range of basic_result or basic_outcome");
+    using value_type = typename item_type::value_type;
+    static_assert(!std::is_void<value_type>::value, "collect() requires a range of basic_result or basic_outcome with a non-void value_type");
+    using error_type = typename item_type::error_type;
+    template <class Container> using container_type = std::conditional_t<std::is_void<Container>::value, std::vector<value_type>, Container>;
+    template <class Container> using result_type = decltype(std::declval<item_ref>().transform(collect_failure<container_type<Container>>()));
+    // Results gather their errors, outcomes their failures, so no exception is lost
+    using error_item_type = std::conditional_t<is_basic_outcome_v<item_type>, decltype(std::declval<item_ref>().as_failure()), error_type>;
+    template <class Errors> using errors_type = std::conditional_t<std::is_void<Errors>::value, small_vector<error_item_type, 4>, Errors>;
+  };
+
+  template <class ItemRef> inline auto collect_error(std::true_type /*is outcome*/, ItemRef &&item) { return static_cast<ItemRef &&>(item).as_failure(); }
+  template <class ItemRef> inline auto collect_error(std::false_type /*is outcome*/, ItemRef &&item) -> decltype(static_cast<ItemRef &&>(item).assume_error())
+  {
+    return static_cast<ItemRef &&>(item).assume_error();
+  }
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class Container = void, class Range>
+inline typename detail::collect_traits<Range &&>::template result_type<Container> collect(Range &&r)
+{
+  using traits = detail::collect_traits<Range &&>;
+  using container_type = typename traits::template container_type<Container>;
+  using result_type = typename traits::template result_type<Container>;
+  container_type c;
+  detail::collect_prepare(r, c);
+  for(auto &&i : r)
+  {
+    auto &&item = static_cast<typename traits::item_ref>(i);
+    if(!item.has_value())
+    {
+      return static_cast<typename traits::item_ref>(item).transform(detail::collect_failure<container_type>());
+    }
+    detail::collect_append(c, static_cast<typename traits::item_ref>(item).assume_value());
+  }
+  return result_type{in_place_type<container_type>, static_cast<container_type &&>(c)};
+}
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class Container = void, class Errors = void, class Range>
+inline basic_result<typename detail::collect_traits<Range &&>::template container_type<Container>,
+                    typename detail::collect_traits<Range &&>::template errors_type<Errors>, policy::terminate>
+collect_errors(Range &&r)
+{
+  using traits = detail::collect_traits<Range &&>;
+  using container_type = typename traits::template container_type<Container>;
+  using errors_type = typename traits::template errors_type<Errors>;
+  using result_type = basic_result<container_type, errors_type, policy::terminate>;
+  container_type c;
+  errors_type errors;
+  detail::collect_prepare(r, c);
+  for(auto &&i : r)
+  {
+    auto &&item = static_cast<typename traits::item_ref>(i);
+    if(!item.has_value())
+    {
+      detail::collect_append(errors, detail::collect_error(std::integral_constant<bool, is_basic_outcome_v<typename traits::item_type>>(),
+                                                           static_cast<typename traits::item_ref>(item)));
+    }
+    else if(errors.empty())
+    {
+      detail::collect_append(c, static_cast<typename traits::item_ref>(item).assume_value());
+    }
+  }
+  if(!errors.empty())
+  {
+    return result_type{in_place_type<errors_type>, static_cast<errors_type &&>(errors)};
+  }
+  return result_type{in_place_type<container_type>, static_cast<container_type &&>(c)};
+}
+
+BOOST_OUTCOME_V2_NAMESPACE_END
+
+#endif
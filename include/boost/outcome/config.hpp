@@ -121,12 +121,60 @@ DEALINGS IN THE SOFTWARE.
 #define BOOST_OUTCOME_ENABLE_LEGACY_SUPPORT_FOR 220  // the v2.2 Outcome release
 #endif
 
+#ifndef BOOST_OUTCOME_OVERLAP_NONTRIVIAL_STORAGE
+#define BOOST_OUTCOME_OVERLAP_NONTRIVIAL_STORAGE 0  // the v2.2 Outcome layout keeps separate value and error storage
+#endif
+
+#ifndef BOOST_OUTCOME_COMPACT_OUTCOME_STORAGE
+#define BOOST_OUTCOME_COMPACT_OUTCOME_STORAGE 0  // the v2.2 Outcome layout keeps separate exception storage
+#endif
+
+#ifndef BOOST_OUTCOME_SPARE_STORAGE_BITS
+#define BOOST_OUTCOME_SPARE_STORAGE_BITS 16  // the v2.2 Outcome layout has a sixteen bit status and sixteen bits of spare storage
+#endif
+#if BOOST_OUTCOME_SPARE_STORAGE_BITS != 0 && BOOST_OUTCOME_SPARE_STORAGE_BITS != 16 && BOOST_OUTCOME_SPARE_STORAGE_BITS != 48
+#error BOOST_OUTCOME_SPARE_STORAGE_BITS must be one of 0, 16 or 48
+#endif
+
+/* The storage layout macros change the layout of basic_result and basic_outcome, so translation
+units compiled with different settings must not see the same types. Any setting other than the
+v2.2 default therefore places everything into an inline namespace naming that layout.
+*/
+#if BOOST_OUTCOME_OVERLAP_NONTRIVIAL_STORAGE
+#define BOOST_OUTCOME_LAYOUT_NAMESPACE_OVERLAP _overlap
+#else
+#define BOOST_OUTCOME_LAYOUT_NAMESPACE_OVERLAP
+#endif
+#if BOOST_OUTCOME_SPARE_STORAGE_BITS == 0
+#define BOOST_OUTCOME_LAYOUT_NAMESPACE_SPARE _spare0
+#elif BOOST_OUTCOME_SPARE_STORAGE_BITS == 48
+#define BOOST_OUTCOME_LAYOUT_NAMESPACE_SPARE _spare48
+#else
+#define BOOST_OUTCOME_LAYOUT_NAMESPACE_SPARE
+#endif
+#if BOOST_OUTCOME_COMPACT_OUTCOME_STORAGE
+#define BOOST_OUTCOME_LAYOUT_NAMESPACE_COMPACT _compact
+#else
+#define BOOST_OUTCOME_LAYOUT_NAMESPACE_COMPACT
+#endif
+#define BOOST_OUTCOME_LAYOUT_NAMESPACE_CAT2(a, b, c) layout##a##b##c
+#define BOOST_OUTCOME_LAYOUT_NAMESPACE_CAT(a, b, c) BOOST_OUTCOME_LAYOUT_NAMESPACE_CAT2(a, b, c)
+#if BOOST_OUTCOME_OVERLAP_NONTRIVIAL_STORAGE || BOOST_OUTCOME_SPARE_STORAGE_BITS != 16 || BOOST_OUTCOME_COMPACT_OUTCOME_STORAGE
+#define BOOST_OUTCOME_LAYOUT_NAMESPACE                                                                                                                         \
+  BOOST_OUTCOME_LAYOUT_NAMESPACE_CAT(BOOST_OUTCOME_LAYOUT_NAMESPACE_OVERLAP, BOOST_OUTCOME_LAYOUT_NAMESPACE_SPARE, BOOST_OUTCOME_LAYOUT_NAMESPACE_COMPACT)
+#endif
+
 namespace boost
 {
 #define BOOST_OUTCOME_V2
   //! The Boost.Outcome namespace
   namespace outcome_v2
   {
+#ifdef BOOST_OUTCOME_LAYOUT_NAMESPACE
+    inline namespace BOOST_OUTCOME_LAYOUT_NAMESPACE
+    {
+    }
+#endif
   }
 }
 /*! The namespace of this Boost.Outcome v2.
@@ -134,25 +182,52 @@ namespace boost
 #define BOOST_OUTCOME_V2_NAMESPACE boost::outcome_v2
 /*! Expands into the appropriate namespace markup to enter the Boost.Outcome v2 namespace.
 */
+#ifdef BOOST_OUTCOME_LAYOUT_NAMESPACE
+#define BOOST_OUTCOME_V2_NAMESPACE_BEGIN                                                                                                                                                                                                                                                                                       \
+  namespace boost                                                                                                                                                                                                                                                                                                              \
+  {                                                                                                                                                                                                                                                                                                                            \
+    namespace outcome_v2                                                                                                                                                                                                                                                                                                       \
+    {                                                                                                                                                                                                                                                                                                                          \
+      inline namespace BOOST_OUTCOME_LAYOUT_NAMESPACE                                                                                                                                                                                                                                                                          \
+      {
+#else
 #define BOOST_OUTCOME_V2_NAMESPACE_BEGIN                                                                                                                                                                                                                                                                                       \
   namespace boost                                                                                                                                                                                                                                                                                                              \
   {                                                                                                                                                                                                                                                                                                                            \
     namespace outcome_v2                                                                                                                                                                                                                                                                                                       \
     {
+#endif
 /*! Expands into the appropriate namespace markup to enter the C++ module
 exported Boost.Outcome v2 namespace.
 */
+#ifdef BOOST_OUTCOME_LAYOUT_NAMESPACE
+#define BOOST_OUTCOME_V2_NAMESPACE_EXPORT_BEGIN                                                                                                                                                                                                                                                                                \
+  namespace boost                                                                                                                                                                                                                                                                                                              \
+  {                                                                                                                                                                                                                                                                                                                            \
+    namespace outcome_v2                                                                                                                                                                                                                                                                                                       \
+    {                                                                                                                                                                                                                                                                                                                          \
+      inline namespace BOOST_OUTCOME_LAYOUT_NAMESPACE                                                                                                                                                                                                                                                                          \
+      {
+#else
 #define BOOST_OUTCOME_V2_NAMESPACE_EXPORT_BEGIN                                                                                                                                                                                                                                                                                \
   namespace boost                                                                                                                                                                                                                                                                                                              \
   {                                                                                                                                                                                                                                                                                                                            \
     namespace outcome_v2                                                                                                                                                                                                                                                                                                       \
     {
+#endif
 /*! \brief Expands into the appropriate namespace markup to exit the Boost.Outcome v2 namespace.
 \ingroup config
 */
+#ifdef BOOST_OUTCOME_LAYOUT_NAMESPACE
+#define BOOST_OUTCOME_V2_NAMESPACE_END                                                                                                                                                                                                                                                                                         \
+  }                                                                                                                                                                                                                                                                                                                            \
+  }                                                                                                                                                                                                                                                                                                                            \
+  }
+#else
 #define BOOST_OUTCOME_V2_NAMESPACE_END                                                                                                                                                                                                                                                                                         \
   }                                                                                                                                                                                                                                                                                                                            \
   }
+#endif
 
 #include <cstdint>  // for uint32_t etc
 #include <initializer_list>
@@ -208,6 +283,13 @@ BOOST_OUTCOME_V2_NAMESPACE_END
 #endif
 
 BOOST_OUTCOME_V2_NAMESPACE_BEGIN
+//! The type used to convey the spare storage within a `basic_result` or `basic_outcome`.
+#if BOOST_OUTCOME_SPARE_STORAGE_BITS > 16
+using spare_storage_type = uint64_t;
+#else
+using spare_storage_type = uint16_t;
+#endif
+
 namespace detail
 {
   // Test if type is an in_place_type_t
@@ -45,6 +45,17 @@ DEALINGS IN THE SOFTWARE.
   }                                                                                                                                                                                                                                                                                                                            \
   BOOST_OUTCOME_V2_NAMESPACE_END
 
+#include "boost/system/error_code.hpp"
+BOOST_OUTCOME_V2_NAMESPACE_BEGIN
+namespace awaitables
+{
+  namespace detail
+  {
+    inline boost::system::errc::errc_t operation_canceled_error(const boost::system::error_code * /*unused*/, int /*unused*/) noexcept { return boost::system::errc::operation_canceled; }
+  }  // namespace detail
+}  // namespace awaitables
+BOOST_OUTCOME_V2_NAMESPACE_END
+
 #ifndef BOOST_NO_EXCEPTIONS
 #include "utils.hpp"
 BOOST_OUTCOME_V2_NAMESPACE_BEGIN
@@ -31,13 +31,13 @@ DEALINGS IN THE SOFTWARE.
 #ifndef BOOST_OUTCOME_BASIC_OUTCOME_EXCEPTION_OBSERVERS_HPP
 #define BOOST_OUTCOME_BASIC_OUTCOME_EXCEPTION_OBSERVERS_HPP
 
-#include "basic_result_storage.hpp"
+#include "basic_outcome_exception_storage.hpp"
 
 BOOST_OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
 namespace detail
 {
-  template <class Base, class R, class S, class P, class NoValuePolicy> class basic_outcome_exception_observers : public Base
+  template <class Base, class R, class S, class P, class NoValuePolicy> class BOOST_OUTCOME_TRIVIAL_ABI basic_outcome_exception_observers : public Base
   {
   public:
     using exception_type = P;
@@ -55,7 +55,7 @@ namespace detail
   };
 
   // Exception observers not present
-  template <class Base, class R, class S, class NoValuePolicy> class basic_outcome_exception_observers<Base, R, S, void, NoValuePolicy> : public Base
+  template <class Base, class R, class S, class NoValuePolicy> class BOOST_OUTCOME_TRIVIAL_ABI basic_outcome_exception_observers<Base, R, S, void, NoValuePolicy> : public Base
   {
   public:
     using Base::Base;
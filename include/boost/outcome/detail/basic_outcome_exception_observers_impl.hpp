@@ -41,8 +41,8 @@ namespace policy
 {
   template <class R, class S, class P, class NoValuePolicy, class Impl> inline constexpr auto &&base::_exception(Impl &&self) noexcept
   {
-    // Impl will be some internal implementation class which has no knowledge of the _ptr stored
-    // beneath it. So statically cast, preserving rvalue and constness, to the derived class.
+    // Impl will be some internal implementation class which has no knowledge of where the exception
+    // is stored beneath it. So statically cast, preserving rvalue and constness, to the derived class.
     using Outcome = BOOST_OUTCOME_V2_NAMESPACE::detail::rebind_type<basic_outcome<R, S, P, NoValuePolicy>, decltype(self)>;
 #if defined(_MSC_VER) && _MSC_VER < 1920
     // VS2017 tries a copy construction in the correct implementation despite that Outcome is always a rvalue or lvalue ref! :(
@@ -50,7 +50,7 @@ namespace policy
 #else
     Outcome _self = static_cast<Outcome>(self);  // NOLINT
 #endif
-    return static_cast<Outcome>(_self)._ptr;
+    return static_cast<BOOST_OUTCOME_V2_NAMESPACE::detail::rebind_type<BOOST_OUTCOME_V2_NAMESPACE::detail::devoid<P>, decltype(self)>>(_self._exception_storage());
   }
 }  // namespace policy
 
@@ -0,0 +1,401 @@
+/* Exception storage for outcome type
+(C) 2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2024
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef BOOST_OUTCOME_BASIC_OUTCOME_EXCEPTION_STORAGE_HPP
+#define BOOST_OUTCOME_BASIC_OUTCOME_EXCEPTION_STORAGE_HPP
+
+#include "basic_result_storage.hpp"
+
+#include <new>
+
+BOOST_OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  /* Whether basic_outcome keeps its exception in the storage of its value, which is unused whenever
+  no value is present. This needs BOOST_OUTCOME_COMPACT_OUTCOME_STORAGE, an exception which fits into
+  the storage of the value, and an error with storage of its own, as the error may be present at the
+  same time as the exception. The exception must also be nothrow to move around.
+  */
+  template <class R, class S, class P, bool = BOOST_OUTCOME_COMPACT_OUTCOME_STORAGE && !std::is_void<P>::value && !std::is_same<R, S>::value>
+  struct outcome_exception_shares_value_storage : std::false_type
+  {
+  };
+  template <class R, class S, class P>
+  struct outcome_exception_shares_value_storage<R, S, P, true>
+      : std::integral_constant<bool, value_storage_select_impl<R, S>::template _can_share_value_storage<P>             //
+                                     && std::is_nothrow_move_constructible<P>::value                                  //
+                                     && (!std::is_copy_constructible<P>::value || std::is_nothrow_copy_constructible<P>::value)  //
+                                     && std::is_nothrow_destructible<P>::value>
+  {
+  };
+
+  template <class Base, class P> class basic_outcome_shared_exception_storage;
+
+  // The exception has storage of its own, which is the v2.2 Outcome layout
+  template <class Base, class R, class S, class P, bool = outcome_exception_shares_value_storage<R, S, P>::value>
+  class BOOST_OUTCOME_TRIVIAL_ABI basic_outcome_exception_storage : public Base
+  {
+    template <class T, class U, class V, class W, bool X> friend class basic_outcome_exception_storage;
+    template <class T, class U> friend class basic_outcome_shared_exception_storage;
+
+  protected:
+    static constexpr bool _exception_shares_value_storage = false;
+
+    devoid<P> _ptr{};
+
+    constexpr devoid<P> &_exception_storage() noexcept { return _ptr; }
+    constexpr const devoid<P> &_exception_storage() const noexcept { return _ptr; }
+    constexpr const devoid<P> &_forward_exception_storage() const & noexcept { return _ptr; }
+    constexpr devoid<P> &&_forward_exception_storage() && noexcept { return static_cast<devoid<P> &&>(_ptr); }
+    template <class U> constexpr void _assign_exception(U &&v) { _ptr = static_cast<U &&>(v); }
+
+  public:
+    struct exception_tag
+    {
+    };
+    struct error_exception_tag
+    {
+    };
+    struct exception_conversion_tag
+    {
+    };
+
+    using Base::Base;
+
+    template <class... Args>
+    constexpr explicit basic_outcome_exception_storage(exception_tag /*unused*/, Args &&... args) noexcept(detail::is_nothrow_constructible<devoid<P>, Args...>)
+        : Base()
+        , _ptr(static_cast<Args &&>(args)...)
+    {
+    }
+    template <class T, class U>
+    constexpr basic_outcome_exception_storage(error_exception_tag /*unused*/, bool /*unused*/, T &&a, U &&b) noexcept(
+    detail::is_nothrow_constructible<typename Base::_error_type, T> &&detail::is_nothrow_constructible<devoid<P>, U>)
+        : Base{in_place_type<typename Base::_error_type>, static_cast<T &&>(a)}
+        , _ptr(static_cast<U &&>(b))
+    {
+    }
+    template <class O>
+    constexpr basic_outcome_exception_storage(exception_conversion_tag /*unused*/, O &&o)
+        : Base{typename Base::compatible_conversion_tag(), static_cast<O &&>(o)}
+        , _ptr(static_cast<O &&>(o)._forward_exception_storage())
+    {
+    }
+  };
+
+  /* The exception lives in the storage of the value whenever the status says there is an exception,
+  and there is then never a value. The value storage knows nothing of the exception, so it must be
+  moved out of the way before the value storage is assigned or swapped.
+  */
+  template <class Base, class P> class BOOST_OUTCOME_TRIVIAL_ABI basic_outcome_shared_exception_storage : public Base
+  {
+    template <class T, class U, class V, class W, bool X> friend class basic_outcome_exception_storage;
+    template <class T, class U> friend class basic_outcome_shared_exception_storage;
+
+  protected:
+    static constexpr bool _exception_shares_value_storage = true;
+
+    P *_exception_slot() noexcept { return this->_state.template _value_storage_as<P>(); }
+    const P *_exception_slot() const noexcept { return this->_state.template _value_storage_as<P>(); }
+
+    P &_exception_storage() noexcept { return *_exception_slot(); }
+    const P &_exception_storage() const noexcept { return *_exception_slot(); }
+    P _forward_exception_storage() const & { return this->_state._status.have_exception() ? *_exception_slot() : P(); }
+    P _forward_exception_storage() && { return this->_state._status.have_exception() ? static_cast<P &&>(*_exception_slot()) : P(); }
+
+    template <class... Args> void _emplace_exception(Args &&... args) noexcept(detail::is_nothrow_constructible<P, Args...>)
+    {
+      new(_exception_slot()) P(static_cast<Args &&>(args)...);
+      this->_state._status.set_have_exception(true);
+    }
+    void _destroy_exception() noexcept
+    {
+      if(this->_state._status.have_exception())
+      {
+        _exception_slot()->~P();
+        this->_state._status.set_have_exception(false);
+      }
+    }
+    template <class U> void _assign_exception(U &&v)
+    {
+      if(this->_state._status.have_exception())
+      {
+        *_exception_slot() = static_cast<U &&>(v);
+        return;
+      }
+      if(this->_state._status.have_value())
+      {
+        // A value cannot be present at the same time as an exception in this layout
+        using value_type = typename Base::_state_type::_value_type_;
+        this->_state._value_ref().~value_type();
+        this->_state._status.set_have_value(false);
+      }
+      _emplace_exception(static_cast<U &&>(v));
+    }
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"  // the holders are only read when they were filled
+#endif
+    void _swap_exception_storage(basic_outcome_shared_exception_storage &o)
+    {
+      struct _
+      {
+        union holder
+        {
+          empty_type _empty;
+          P e;
+          constexpr holder() noexcept
+              : _empty()
+          {
+          }
+          ~holder() {}
+        };
+        basic_outcome_shared_exception_storage &a, &b;
+        bool ahad, bhad;
+        holder ae, be;
+        bool all_good{false};
+        _(basic_outcome_shared_exception_storage &_a, basic_outcome_shared_exception_storage &_b) noexcept
+            : a(_a)
+            , b(_b)
+            , ahad(_a._state._status.have_exception())
+            , bhad(_b._state._status.have_exception())
+        {
+          take(a, ae, ahad);
+          take(b, be, bhad);
+        }
+        _(const _ &) = delete;
+        _(_ &&) = delete;
+        _ &operator=(const _ &) = delete;
+        _ &operator=(_ &&) = delete;
+        ~_()
+        {
+          // If the value + error swap threw an exception, return the exceptions to where they came from
+          place(all_good ? b : a, ae, ahad);
+          place(all_good ? a : b, be, bhad);
+        }
+        static void take(basic_outcome_shared_exception_storage &x, holder &h, bool had) noexcept
+        {
+          if(had)
+          {
+            new(&h.e) P(static_cast<P &&>(*x._exception_slot()));
+            x._destroy_exception();
+          }
+        }
+        static void place(basic_outcome_shared_exception_storage &x, holder &h, bool had) noexcept
+        {
+          if(had)
+          {
+            if(x._state._status.have_value())
+            {
+              // Nowhere to put it
+              x._state._status.set_have_lost_consistency(true);
+            }
+            else
+            {
+              x._emplace_exception(static_cast<P &&>(h.e));
+            }
+            h.e.~P();
+          }
+        }
+      } _{*this, o};
+      this->_state.swap(o._state);
+      _.all_good = true;
+    }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+  public:
+    struct exception_tag
+    {
+    };
+    struct error_exception_tag
+    {
+    };
+    struct exception_conversion_tag
+    {
+    };
+
+    using Base::Base;
+
+    template <class... Args>
+    explicit basic_outcome_shared_exception_storage(exception_tag /*unused*/, Args &&... args) noexcept(detail::is_nothrow_constructible<P, Args...>)
+        : Base()
+    {
+      _emplace_exception(static_cast<Args &&>(args)...);
+    }
+    template <class T, class U>
+    basic_outcome_shared_exception_storage(error_exception_tag /*unused*/, bool have_exception, T &&a, U &&b) noexcept(
+    detail::is_nothrow_constructible<typename Base::_error_type, T> &&detail::is_nothrow_constructible<P, U>)
+        : Base{in_place_type<typename Base::_error_type>, static_cast<T &&>(a)}
+    {
+      if(have_exception)
+      {
+        _emplace_exception(static_cast<U &&>(b));
+      }
+    }
+    template <class O>
+    basic_outcome_shared_exception_storage(exception_conversion_tag /*unused*/, O &&o)
+        : Base{typename Base::compatible_conversion_tag(), static_cast<O &&>(o)}
+    {
+      if(this->_state._status.have_exception())
+      {
+        this->_state._status.set_have_exception(false);
+        _emplace_exception(static_cast<O &&>(o)._forward_exception_storage());
+      }
+    }
+
+    basic_outcome_shared_exception_storage() = default;
+    basic_outcome_shared_exception_storage(const basic_outcome_shared_exception_storage &o) noexcept(
+    std::is_nothrow_copy_constructible<typename Base::_state_type>::value)
+        : Base(o)
+    {
+      if(o._state._status.have_exception())
+      {
+        new(_exception_slot()) P(*o._exception_slot());
+      }
+    }
+    basic_outcome_shared_exception_storage(basic_outcome_shared_exception_storage &&o) noexcept(
+    std::is_nothrow_move_constructible<typename Base::_state_type>::value)  // NOLINT
+        : Base(static_cast<Base &&>(o))
+    {
+      if(o._state._status.have_exception())
+      {
+        new(_exception_slot()) P(static_cast<P &&>(*o._exception_slot()));
+      }
+    }
+    basic_outcome_shared_exception_storage &operator=(const basic_outcome_shared_exception_storage &o) noexcept(
+    std::is_nothrow_copy_assignable<typename Base::_state_type>::value)
+    {
+      if(this != &o)
+      {
+        _destroy_exception();
+        Base::operator=(o);
+        if(o._state._status.have_exception())
+        {
+          new(_exception_slot()) P(*o._exception_slot());
+        }
+      }
+      return *this;
+    }
+    basic_outcome_shared_exception_storage &operator=(basic_outcome_shared_exception_storage &&o) noexcept(
+    std::is_nothrow_move_assignable<typename Base::_state_type>::value)  // NOLINT
+    {
+      if(this != &o)
+      {
+        _destroy_exception();
+        Base::operator=(static_cast<Base &&>(o));
+        if(o._state._status.have_exception())
+        {
+          new(_exception_slot()) P(static_cast<P &&>(*o._exception_slot()));
+        }
+      }
+      return *this;
+    }
+    ~basic_outcome_shared_exception_storage()
+    {
+      if(this->_state._status.have_exception())
+      {
+        _exception_slot()->~P();
+      }
+    }
+  };
+
+  // Empty bases which delete whichever special members the value, error or exception cannot provide
+  template <bool> struct outcome_exception_storage_copy_constructor
+  {
+  };
+  template <> struct outcome_exception_storage_copy_constructor<false>
+  {
+    outcome_exception_storage_copy_constructor() = default;
+    outcome_exception_storage_copy_constructor(const outcome_exception_storage_copy_constructor &) = delete;
+    outcome_exception_storage_copy_constructor(outcome_exception_storage_copy_constructor &&) = default;  // NOLINT
+    outcome_exception_storage_copy_constructor &operator=(const outcome_exception_storage_copy_constructor &) = default;
+    outcome_exception_storage_copy_constructor &operator=(outcome_exception_storage_copy_constructor &&) = default;  // NOLINT
+    ~outcome_exception_storage_copy_constructor() = default;
+  };
+  template <bool> struct outcome_exception_storage_move_constructor
+  {
+  };
+  template <> struct outcome_exception_storage_move_constructor<false>
+  {
+    outcome_exception_storage_move_constructor() = default;
+    outcome_exception_storage_move_constructor(const outcome_exception_storage_move_constructor &) = default;
+    outcome_exception_storage_move_constructor(outcome_exception_storage_move_constructor &&) = delete;
+    outcome_exception_storage_move_constructor &operator=(const outcome_exception_storage_move_constructor &) = default;
+    outcome_exception_storage_move_constructor &operator=(outcome_exception_storage_move_constructor &&) = default;  // NOLINT
+    ~outcome_exception_storage_move_constructor() = default;
+  };
+  template <bool> struct outcome_exception_storage_copy_assignment
+  {
+  };
+  template <> struct outcome_exception_storage_copy_assignment<false>
+  {
+    outcome_exception_storage_copy_assignment() = default;
+    outcome_exception_storage_copy_assignment(const outcome_exception_storage_copy_assignment &) = default;
+    outcome_exception_storage_copy_assignment(outcome_exception_storage_copy_assignment &&) = default;  // NOLINT
+    outcome_exception_storage_copy_assignment &operator=(const outcome_exception_storage_copy_assignment &) = delete;
+    outcome_exception_storage_copy_assignment &operator=(outcome_exception_storage_copy_assignment &&) = default;  // NOLINT
+    ~outcome_exception_storage_copy_assignment() = default;
+  };
+  template <bool> struct outcome_exception_storage_move_assignment
+  {
+  };
+  template <> struct outcome_exception_storage_move_assignment<false>
+  {
+    outcome_exception_storage_move_assignment() = default;
+    outcome_exception_storage_move_assignment(const outcome_exception_storage_move_assignment &) = default;
+    outcome_exception_storage_move_assignment(outcome_exception_storage_move_assignment &&) = default;  // NOLINT
+    outcome_exception_storage_move_assignment &operator=(const outcome_exception_storage_move_assignment &) = default;
+    outcome_exception_storage_move_assignment &operator=(outcome_exception_storage_move_assignment &&) = delete;
+    ~outcome_exception_storage_move_assignment() = default;
+  };
+
+  // The exception shares the storage of the value
+  template <class Base, class R, class S, class P>
+  class BOOST_OUTCOME_TRIVIAL_ABI basic_outcome_exception_storage<Base, R, S, P, true>
+      : public basic_outcome_shared_exception_storage<Base, P>,
+        outcome_exception_storage_copy_constructor<std::is_copy_constructible<devoid<R>>::value && std::is_copy_constructible<devoid<S>>::value
+                                                   && std::is_copy_constructible<P>::value>,
+        outcome_exception_storage_move_constructor<std::is_move_constructible<devoid<R>>::value && std::is_move_constructible<devoid<S>>::value>,
+        outcome_exception_storage_copy_assignment<is_copy_assignable<devoid<R>>::value && is_copy_assignable<devoid<S>>::value
+                                                  && std::is_copy_constructible<P>::value>,
+        outcome_exception_storage_move_assignment<is_move_assignable<devoid<R>>::value && is_move_assignable<devoid<S>>::value>
+  {
+  public:
+    using basic_outcome_shared_exception_storage<Base, P>::basic_outcome_shared_exception_storage;
+  };
+}  // namespace detail
+
+BOOST_OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -33,6 +33,8 @@ DEALINGS IN THE SOFTWARE.
 
 #include "basic_result_storage.hpp"
 
+#include "per_thread_cache.hpp"
+
 BOOST_OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
 namespace detail
@@ -57,10 +59,38 @@ namespace detail
   template <class S, class P> inline void _delayed_lookup_basic_outcome_failure_exception_from_error(...) = delete;  // NOLINT No specialisation for these error and exception types available!
 #endif
 
+  /* Synthesising an exception from an error usually allocates, so for error types opted in
+  by trait::is_failure_exception_cached, remember the exception last synthesised for each
+  (category, value) per thread. Every outcome with an equal error on the same thread is
+  therefore handed the same exception object, which callers must not modify.
+  */
+  template <class P, class S> inline P cached_basic_outcome_failure_exception_from_error(const S &ec)
+  {
+    struct cache_entry
+    {
+      const void *category{nullptr};
+      int value{0};
+      P exception{};
+    };
+    static thread_local boost::outcome_detail::per_thread_cache<cache_entry> cache;
+    const void *category = &ec.category();
+    const int value = ec.value();
+    auto &entry = cache.lookup(category, static_cast<uintptr_t>(value));
+    if(entry.category == category && entry.value == value && entry.exception)
+    {
+      return entry.exception;
+    }
+    P ret = _delayed_lookup_basic_outcome_failure_exception_from_error(ec, adl::search_detail_adl());
+    entry.category = category;
+    entry.value = value;
+    entry.exception = ret;
+    return ret;
+  }
+
   template <class exception_type> inline exception_type current_exception_or_fatal(std::exception_ptr e) { std::rethrow_exception(e); }
   template <> inline std::exception_ptr current_exception_or_fatal<std::exception_ptr>(std::exception_ptr e) { return e; }
 
-  template <class Base, class R, class S, class P, class NoValuePolicy> class basic_outcome_failure_observers : public Base
+  template <class Base, class R, class S, class P, class NoValuePolicy> class BOOST_OUTCOME_TRIVIAL_ABI basic_outcome_failure_observers : public Base
   {
   public:
     using exception_type = P;
@@ -78,7 +108,7 @@ namespace detail
         }
         if(this->_state._status.have_error())
         {
-          return _delayed_lookup_basic_outcome_failure_exception_from_error(this->assume_error(), adl::search_detail_adl());
+          return _exception_from_error(std::integral_constant<bool, trait::is_failure_exception_cached<S>::value>());
         }
         return exception_type();
       }
@@ -91,6 +121,16 @@ namespace detail
       }
 #endif
     }
+
+  private:
+    exception_type _exception_from_error(std::false_type /*cached*/) const
+    {
+      return _delayed_lookup_basic_outcome_failure_exception_from_error(this->assume_error(), adl::search_detail_adl());
+    }
+    exception_type _exception_from_error(std::true_type /*cached*/) const
+    {
+      return cached_basic_outcome_failure_exception_from_error<exception_type>(this->assume_error());
+    }
   };
 
 }  // namespace detail
@@ -37,7 +37,7 @@ BOOST_OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
 namespace detail
 {
-  template <class Base, class EC, class NoValuePolicy> class basic_result_error_observers : public Base
+  template <class Base, class EC, class NoValuePolicy> class BOOST_OUTCOME_TRIVIAL_ABI basic_result_error_observers : public Base
   {
   public:
     using error_type = EC;
@@ -46,43 +46,43 @@ namespace detail
     constexpr error_type &assume_error() & noexcept
     {
       NoValuePolicy::narrow_error_check(static_cast<basic_result_error_observers &>(*this));
-      return this->_state._error;
+      return this->_state._error_ref();
     }
     constexpr const error_type &assume_error() const &noexcept
     {
       NoValuePolicy::narrow_error_check(static_cast<const basic_result_error_observers &>(*this));
-      return this->_state._error;
+      return this->_state._error_ref();
     }
     constexpr error_type &&assume_error() && noexcept
     {
       NoValuePolicy::narrow_error_check(static_cast<basic_result_error_observers &&>(*this));
-      return static_cast<error_type &&>(this->_state._error);
+      return static_cast<error_type &&>(this->_state._error_ref());
     }
     constexpr const error_type &&assume_error() const &&noexcept
     {
       NoValuePolicy::narrow_error_check(static_cast<const basic_result_error_observers &&>(*this));
-      return static_cast<const error_type &&>(this->_state._error);
+      return static_cast<const error_type &&>(this->_state._error_ref());
     }
 
     constexpr error_type &error() &
     {
       NoValuePolicy::wide_error_check(static_cast<basic_result_error_observers &>(*this));
-      return this->_state._error;
+      return this->_state._error_ref();
     }
     constexpr const error_type &error() const &
     {
       NoValuePolicy::wide_error_check(static_cast<const basic_result_error_observers &>(*this));
-      return this->_state._error;
+      return this->_state._error_ref();
     }
     constexpr error_type &&error() &&
     {
       NoValuePolicy::wide_error_check(static_cast<basic_result_error_observers &&>(*this));
-      return static_cast<error_type &&>(this->_state._error);
+      return static_cast<error_type &&>(this->_state._error_ref());
     }
     constexpr const error_type &&error() const &&
     {
       NoValuePolicy::wide_error_check(static_cast<const basic_result_error_observers &&>(*this));
-      return static_cast<const error_type &&>(this->_state._error);
+      return static_cast<const error_type &&>(this->_state._error_ref());
     }
   };
   template <class Base, class NoValuePolicy> class basic_result_error_observers<Base, void, NoValuePolicy> : public Base
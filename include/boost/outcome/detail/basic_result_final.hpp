@@ -41,7 +41,7 @@ namespace detail
   template <class R, class EC, class NoValuePolicy> using select_basic_result_impl = basic_result_error_observers<basic_result_value_observers<basic_result_storage<R, EC, NoValuePolicy>, R, NoValuePolicy>, EC, NoValuePolicy>;
 
   template <class R, class S, class NoValuePolicy>
-  class basic_result_final
+  class BOOST_OUTCOME_TRIVIAL_ABI basic_result_final
 #if defined(BOOST_OUTCOME_DOXYGEN_IS_IN_THE_HOUSE)
   : public basic_result_error_observers<basic_result_value_observers<basic_result_storage<R, S, NoValuePolicy>, R, NoValuePolicy>, S, NoValuePolicy>
 #else
@@ -68,11 +68,11 @@ namespace detail
     {
       if(this->_state._status.have_value() && o._state._status.have_value())
       {
-        return this->_state._value == o._state._value;  // NOLINT
+        return this->_state._value_ref() == o._state._value_ref();  // NOLINT
       }
       if(this->_state._status.have_error() && o._state._status.have_error())
       {
-        return this->_state._error == o._state._error;
+        return this->_state._error_ref() == o._state._error_ref();
       }
       return false;
     }
@@ -83,7 +83,7 @@ namespace detail
     {
       if(this->_state._status.have_value())
       {
-        return this->_state._value == o.value();
+        return this->_state._value_ref() == o.value();
       }
       return false;
     }
@@ -99,7 +99,7 @@ namespace detail
     {
       if(this->_state._status.have_error())
       {
-        return this->_state._error == o.error();
+        return this->_state._error_ref() == o.error();
       }
       return false;
     }
@@ -111,11 +111,11 @@ namespace detail
     {
       if(this->_state._status.have_value() && o._state._status.have_value())
       {
-        return this->_state._value != o._state._value;
+        return this->_state._value_ref() != o._state._value_ref();
       }
       if(this->_state._status.have_error() && o._state._status.have_error())
       {
-        return this->_state._error != o._state._error;
+        return this->_state._error_ref() != o._state._error_ref();
       }
       return true;
     }
@@ -126,7 +126,7 @@ namespace detail
     {
       if(this->_state._status.have_value())
       {
-        return this->_state._value != o.value();
+        return this->_state._value_ref() != o.value();
       }
       return false;
     }
@@ -142,7 +142,7 @@ namespace detail
     {
       if(this->_state._status.have_error())
       {
-        return this->_state._error != o.error();
+        return this->_state._error_ref() != o.error();
       }
       return true;
     }
@@ -44,9 +44,9 @@ namespace detail
 
 namespace hooks
 {
-  template <class R, class S, class NoValuePolicy> constexpr inline uint16_t spare_storage(const detail::basic_result_storage<R, S, NoValuePolicy> *r) noexcept;
+  template <class R, class S, class NoValuePolicy> constexpr inline spare_storage_type spare_storage(const detail::basic_result_storage<R, S, NoValuePolicy> *r) noexcept;
   template <class R, class S, class NoValuePolicy>
-  constexpr inline void set_spare_storage(detail::basic_result_storage<R, S, NoValuePolicy> *r, uint16_t v) noexcept;
+  constexpr inline void set_spare_storage(detail::basic_result_storage<R, S, NoValuePolicy> *r, spare_storage_type v) noexcept;
 }  // namespace hooks
 
 namespace policy
@@ -57,7 +57,7 @@ namespace policy
 namespace detail
 {
   template <class R, class EC, class NoValuePolicy>  //
-  class basic_result_storage
+  class BOOST_OUTCOME_TRIVIAL_ABI basic_result_storage
   {
     static_assert(trait::type_can_be_used_in_basic_result<R>, "The type R cannot be used in a basic_result");
     static_assert(trait::type_can_be_used_in_basic_result<EC>, "The type S cannot be used in a basic_result");
@@ -67,9 +67,9 @@ namespace detail
     friend class basic_result_storage;
     template <class T, class U, class V> friend class basic_result_final;
     template <class T, class U, class V>
-    friend constexpr inline uint16_t hooks::spare_storage(const detail::basic_result_storage<T, U, V> *r) noexcept;  // NOLINT
+    friend constexpr inline spare_storage_type hooks::spare_storage(const detail::basic_result_storage<T, U, V> *r) noexcept;  // NOLINT
     template <class T, class U, class V>
-    friend constexpr inline void hooks::set_spare_storage(detail::basic_result_storage<T, U, V> *r, uint16_t v) noexcept;  // NOLINT
+    friend constexpr inline void hooks::set_spare_storage(detail::basic_result_storage<T, U, V> *r, spare_storage_type v) noexcept;  // NOLINT
 
     struct disable_in_place_value_type
     {
@@ -127,6 +127,18 @@ namespace detail
         : _state{_, il, static_cast<Args &&>(args)...}
     {
     }
+    template <class F, class... Args>
+    constexpr basic_result_storage(in_place_invoke_type_t<_value_type> _, F &&f, Args &&... args) noexcept(
+    noexcept(_state_type(_, static_cast<F &&>(f), static_cast<Args &&>(args)...)))
+        : _state{_, static_cast<F &&>(f), static_cast<Args &&>(args)...}
+    {
+    }
+    template <class F, class... Args>
+    constexpr basic_result_storage(in_place_invoke_type_t<_error_type> _, F &&f, Args &&... args) noexcept(
+    noexcept(_state_type(_, static_cast<F &&>(f), static_cast<Args &&>(args)...)))
+        : _state{_, static_cast<F &&>(f), static_cast<Args &&>(args)...}
+    {
+    }
 
     struct compatible_conversion_tag
     {
@@ -150,15 +162,15 @@ namespace detail
     template <class T, class U, class V>
     constexpr basic_result_storage(make_error_code_compatible_conversion_tag /*unused*/, const basic_result_storage<T, U, V> &o) noexcept(
     detail::is_nothrow_constructible<_value_type, T> &&noexcept(make_error_code(std::declval<U>())))
-        : _state(o._state._status.have_value() ? _state_type(in_place_type<_value_type>, o._state._value) :
-                                                 _state_type(in_place_type<_error_type>, make_error_code(o._state._error)))
+        : _state(o._state._status.have_value() ? _state_type(in_place_type<_value_type>, o._state._value_ref()) :
+                                                 _state_type(in_place_type<_error_type>, make_error_code(o._state._error_ref())))
     {
     }
     template <class T, class U, class V>
     constexpr basic_result_storage(make_error_code_compatible_conversion_tag /*unused*/, basic_result_storage<T, U, V> &&o) noexcept(
     detail::is_nothrow_constructible<_value_type, T> &&noexcept(make_error_code(std::declval<U>())))
-        : _state(o._state._status.have_value() ? _state_type(in_place_type<_value_type>, static_cast<T &&>(o._state._value)) :
-                                                 _state_type(in_place_type<_error_type>, make_error_code(static_cast<U &&>(o._state._error))))
+        : _state(o._state._status.have_value() ? _state_type(in_place_type<_value_type>, static_cast<T &&>(o._state._value_ref())) :
+                                                 _state_type(in_place_type<_error_type>, make_error_code(static_cast<U &&>(o._state._error_ref()))))
     {
     }
 
@@ -168,15 +180,15 @@ namespace detail
     template <class T, class U, class V>
     constexpr basic_result_storage(make_exception_ptr_compatible_conversion_tag /*unused*/, const basic_result_storage<T, U, V> &o) noexcept(
     detail::is_nothrow_constructible<_value_type, T> &&noexcept(make_exception_ptr(std::declval<U>())))
-        : _state(o._state._status.have_value() ? _state_type(in_place_type<_value_type>, o._state._value) :
-                                                 _state_type(in_place_type<_error_type>, make_exception_ptr(o._state._error)))
+        : _state(o._state._status.have_value() ? _state_type(in_place_type<_value_type>, o._state._value_ref()) :
+                                                 _state_type(in_place_type<_error_type>, make_exception_ptr(o._state._error_ref())))
     {
     }
     template <class T, class U, class V>
     constexpr basic_result_storage(make_exception_ptr_compatible_conversion_tag /*unused*/, basic_result_storage<T, U, V> &&o) noexcept(
     detail::is_nothrow_constructible<_value_type, T> &&noexcept(make_exception_ptr(std::declval<U>())))
-        : _state(o._state._status.have_value() ? _state_type(in_place_type<_value_type>, static_cast<T &&>(o._state._value)) :
-                                                 _state_type(in_place_type<_error_type>, make_exception_ptr(static_cast<U &&>(o._state._error))))
+        : _state(o._state._status.have_value() ? _state_type(in_place_type<_value_type>, static_cast<T &&>(o._state._value_ref())) :
+                                                 _state_type(in_place_type<_error_type>, make_exception_ptr(static_cast<U &&>(o._state._error_ref()))))
     {
     }
   };
@@ -37,7 +37,7 @@ BOOST_OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
 namespace detail
 {
-  template <class Base, class R, class NoValuePolicy> class basic_result_value_observers : public Base
+  template <class Base, class R, class NoValuePolicy> class BOOST_OUTCOME_TRIVIAL_ABI basic_result_value_observers : public Base
   {
   public:
     using value_type = R;
@@ -46,43 +46,43 @@ namespace detail
     constexpr value_type &assume_value() & noexcept
     {
       NoValuePolicy::narrow_value_check(static_cast<basic_result_value_observers &>(*this));
-      return this->_state._value;  // NOLINT
+      return this->_state._value_ref();  // NOLINT
     }
     constexpr const value_type &assume_value() const &noexcept
     {
       NoValuePolicy::narrow_value_check(static_cast<const basic_result_value_observers &>(*this));
-      return this->_state._value;  // NOLINT
+      return this->_state._value_ref();  // NOLINT
     }
     constexpr value_type &&assume_value() && noexcept
     {
       NoValuePolicy::narrow_value_check(static_cast<basic_result_value_observers &&>(*this));
-      return static_cast<value_type &&>(this->_state._value);  // NOLINT
+      return static_cast<value_type &&>(this->_state._value_ref());  // NOLINT
     }
     constexpr const value_type &&assume_value() const &&noexcept
     {
       NoValuePolicy::narrow_value_check(static_cast<const basic_result_value_observers &&>(*this));
-      return static_cast<const value_type &&>(this->_state._value);  // NOLINT
+      return static_cast<const value_type &&>(this->_state._value_ref());  // NOLINT
     }
 
     constexpr value_type &value() &
     {
       NoValuePolicy::wide_value_check(static_cast<basic_result_value_observers &>(*this));
-      return this->_state._value;  // NOLINT
+      return this->_state._value_ref();  // NOLINT
     }
     constexpr const value_type &value() const &
     {
       NoValuePolicy::wide_value_check(static_cast<const basic_result_value_observers &>(*this));
-      return this->_state._value;  // NOLINT
+      return this->_state._value_ref();  // NOLINT
     }
     constexpr value_type &&value() &&
     {
       NoValuePolicy::wide_value_check(static_cast<basic_result_value_observers &&>(*this));
-      return static_cast<value_type &&>(this->_state._value);  // NOLINT
+      return static_cast<value_type &&>(this->_state._value_ref());  // NOLINT
     }
     constexpr const value_type &&value() const &&
     {
       NoValuePolicy::wide_value_check(static_cast<const basic_result_value_observers &&>(*this));
-      return static_cast<const value_type &&>(this->_state._value);  // NOLINT
+      return static_cast<const value_type &&>(this->_state._value_ref());  // NOLINT
     }
   };
   template <class Base, class NoValuePolicy> class basic_result_value_observers<Base, void, NoValuePolicy> : public Base
@@ -37,6 +37,14 @@ DEALINGS IN THE SOFTWARE.
 
 #include <atomic>
 #include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <system_error>  // for std::errc
+
+#ifndef BOOST_OUTCOME_COROUTINE_FRAME_POOL_MAX_SIZE
+#define BOOST_OUTCOME_COROUTINE_FRAME_POOL_MAX_SIZE 1024  // coroutine frames up to this size are recycled per thread
+#endif
 
 #if __cpp_impl_coroutine || (defined(_MSC_VER) && __cpp_coroutines) || (defined(__clang__) && __cpp_coroutines)
 #ifndef BOOST_OUTCOME_HAVE_NOOP_COROUTINE
@@ -86,6 +94,23 @@ BOOST_OUTCOME_V2_NAMESPACE_END
 #endif
 #endif
 
+#ifndef BOOST_OUTCOME_HAVE_STOP_TOKEN
+#if defined(BOOST_OUTCOME_FOUND_COROUTINE_HEADER) && __has_include(<stop_token>)
+#include <stop_token>
+#endif
+#if __cpp_lib_jthread >= 201911L
+#define BOOST_OUTCOME_HAVE_STOP_TOKEN 1
+#else
+#define BOOST_OUTCOME_HAVE_STOP_TOKEN 0
+#endif
+#elif BOOST_OUTCOME_HAVE_STOP_TOKEN
+#include <stop_token>
+#endif
+
+#if defined(BOOST_OUTCOME_FOUND_COROUTINE_HEADER) && __has_include(<span>)
+#include <span>  // for batch_generator
+#endif
+
 BOOST_OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 namespace awaitables
 {
@@ -118,6 +143,18 @@ namespace awaitables
     BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(BOOST_OUTCOME_V2_NAMESPACE::detail::is_constructible<U, T>))
     inline void set_or_rethrow(T &e, U *result) { new(result) U(e); }
     template <class T> inline void set_or_rethrow(T &e, ...) { rethrow_exception(e); }
+    // Cancelled coroutines complete with the operation_canceled_error() for their error type, which for most is this
+    template <class E> inline std::errc operation_canceled_error(const E * /*unused*/, ...) noexcept { return std::errc::operation_canceled; }
+    template <class U, class = void> struct can_set_operation_canceled : std::false_type
+    {
+    };
+    template <class U>
+    struct can_set_operation_canceled<
+    U, std::enable_if_t<BOOST_OUTCOME_V2_NAMESPACE::detail::is_constructible<U, decltype(operation_canceled_error(static_cast<const typename U::error_type *>(nullptr), 5))>>>
+        : std::true_type
+    {
+    };
+    template <class U> inline void set_operation_canceled(U *result) { new(result) U(operation_canceled_error(static_cast<const typename U::error_type *>(nullptr), 5)); }
     template <class T> class fake_atomic
     {
       T _v;
@@ -129,10 +166,522 @@ namespace awaitables
       }
       T load(std::memory_order /*unused*/) { return _v; }
       void store(T v, std::memory_order /*unused*/) { _v = v; }
+      T fetch_or(T v, std::memory_order /*unused*/)
+      {
+        T ret = _v;
+        _v |= v;
+        return ret;
+      }
     };
 
 #ifdef BOOST_OUTCOME_FOUND_COROUTINE_HEADER
-    template <class Awaitable, bool suspend_initial, bool use_atomic, bool is_void> struct outcome_promise_type
+    /* Every frame ends with the function which frees it, after which frames allocated with an
+    allocator keep a copy of it.
+    */
+    using frame_deallocator_type = void (*)(void *, size_t) noexcept;
+    constexpr inline size_t frame_align_up(size_t bytes, size_t align) noexcept { return (bytes + align - 1) & ~(align - 1); }
+    constexpr inline size_t frame_deallocator_offset(size_t bytes) noexcept { return frame_align_up(bytes, alignof(frame_deallocator_type)); }
+    inline frame_deallocator_type &frame_deallocator(void *frame, size_t bytes) noexcept
+    {
+      return *reinterpret_cast<frame_deallocator_type *>(static_cast<char *>(frame) + frame_deallocator_offset(bytes));
+    }
+
+    /* Frames freed by a thread are kept for its next coroutines of the same size class, up to
+    a limit per class. Frames allocated by one thread may be freed by another.
+    */
+    class frame_pool
+    {
+      static constexpr size_t _granularity = 64, _classes = (BOOST_OUTCOME_COROUTINE_FRAME_POOL_MAX_SIZE + _granularity - 1) / _granularity,
+                              _max_free_per_class = 16;
+      struct free_frame
+      {
+        free_frame *next;
+      };
+      // Trivial, so usable right up until the thread exits
+      struct free_lists
+      {
+        free_frame *free[_classes + 1];
+        uint8_t count[_classes + 1];
+        bool reaper_registered, exited;
+      };
+      // Frees the lists when the thread exits
+      struct reaper
+      {
+        reaper() = default;
+        reaper(const reaper &) = delete;
+        reaper(reaper &&) = delete;
+        reaper &operator=(const reaper &) = delete;
+        reaper &operator=(reaper &&) = delete;
+        ~reaper()
+        {
+          auto &l = _lists();
+          for(auto *f : l.free)
+          {
+            while(f != nullptr)
+            {
+              auto *n = f->next;
+              ::operator delete(f);
+              f = n;
+            }
+          }
+          l = free_lists{};
+          l.exited = true;
+        }
+      };
+      static free_lists &_lists() noexcept
+      {
+        static BOOST_OUTCOME_THREAD_LOCAL free_lists v;
+        return v;
+      }
+      static void _register_reaper() noexcept
+      {
+        static BOOST_OUTCOME_THREAD_LOCAL reaper v;
+        (void) v;
+        _lists().reaper_registered = true;
+      }
+      static constexpr size_t _class(size_t bytes) noexcept { return (bytes + _granularity - 1) / _granularity; }
+      static void _deallocate(void *frame, size_t bytes) noexcept
+      {
+        const size_t c = _class(frame_deallocator_offset(bytes) + sizeof(frame_deallocator_type));
+        auto &l = _lists();
+        if(c > _classes || l.exited || l.count[c] >= _max_free_per_class)
+        {
+          ::operator delete(frame);
+          return;
+        }
+        if(!l.reaper_registered)
+        {
+          _register_reaper();
+        }
+        auto *f = static_cast<free_frame *>(frame);
+        f->next = l.free[c];
+        l.free[c] = f;
+        ++l.count[c];
+      }
+
+    public:
+      //! Allocates a frame of `bytes`, preferably one freed earlier by this thread.
+      static void *allocate(size_t bytes)  // could throw bad_alloc
+      {
+        const size_t total = frame_deallocator_offset(bytes) + sizeof(frame_deallocator_type), c = _class(total);
+        void *ret = nullptr;
+        if(c > _classes)
+        {
+          ret = ::operator new(total);
+        }
+        else
+        {
+          auto &l = _lists();
+          if(l.free[c] != nullptr)
+          {
+            ret = l.free[c];
+            l.free[c] = l.free[c]->next;
+            --l.count[c];
+          }
+          else
+          {
+            ret = ::operator new(c * _granularity);
+          }
+        }
+        frame_deallocator(ret, bytes) = &frame_pool::_deallocate;
+        return ret;
+      }
+    };
+
+    // Allocates frames with a copy of an allocator kept at the end of the frame
+    template <class Alloc> struct frame_allocator
+    {
+      struct alignas(std::max_align_t) block
+      {
+        char bytes[alignof(std::max_align_t)];
+      };
+      using allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<block>;
+      using traits = std::allocator_traits<allocator_type>;
+
+      static constexpr size_t allocator_offset(size_t bytes) noexcept
+      {
+        return frame_align_up(frame_deallocator_offset(bytes) + sizeof(frame_deallocator_type), alignof(allocator_type));
+      }
+      static constexpr size_t blocks(size_t bytes) noexcept { return (allocator_offset(bytes) + sizeof(allocator_type) + sizeof(block) - 1) / sizeof(block); }
+
+      static void *allocate(size_t bytes, const Alloc &alloc)  // could throw
+      {
+        allocator_type a(alloc);
+        void *ret = std::addressof(*traits::allocate(a, blocks(bytes)));
+        new(static_cast<char *>(ret) + allocator_offset(bytes)) allocator_type(static_cast<allocator_type &&>(a));
+        frame_deallocator(ret, bytes) = &frame_allocator::deallocate;
+        return ret;
+      }
+      static void deallocate(void *frame, size_t bytes) noexcept
+      {
+        auto *stored = reinterpret_cast<allocator_type *>(static_cast<char *>(frame) + allocator_offset(bytes));
+        allocator_type a(static_cast<allocator_type &&>(*stored));
+        stored->~allocator_type();
+        traits::deallocate(a, std::pointer_traits<typename traits::pointer>::pointer_to(*static_cast<block *>(frame)), blocks(bytes));
+      }
+    };
+
+    /* Coroutines whose parameters are `std::allocator_arg_t, const Alloc &, ...`, or for member functions
+    follow the object, allocate their frame with that allocator. All others use the frame pool.
+    */
+    struct promise_frame_allocation
+    {
+      static void *operator new(size_t bytes) { return frame_pool::allocate(bytes); }
+      template <class Alloc, class... Args> static void *operator new(size_t bytes, std::allocator_arg_t /*unused*/, const Alloc &alloc, const Args &... /*unused*/)
+      {
+        return frame_allocator<Alloc>::allocate(bytes, alloc);
+      }
+      template <class This, class Alloc, class... Args>
+      static void *operator new(size_t bytes, const This & /*unused*/, std::allocator_arg_t /*unused*/, const Alloc &alloc, const Args &... /*unused*/)
+      {
+        return frame_allocator<Alloc>::allocate(bytes, alloc);
+      }
+      static void operator delete(void *frame, size_t bytes) noexcept { frame_deallocator(frame, bytes)(frame, bytes); }
+    };
+
+    /* An executor either has `.post(coroutine_handle<>)`, or is a standard style executor with `.execute(F)`
+    which ASIO's executors are. Anything else is not used, as before executors were supported.
+    */
+    template <class E> inline auto executor_post(E &ex, coroutine_handle<> h, int /*unused*/) -> decltype(ex.post(h), void()) { ex.post(h); }
+    template <class E> inline auto executor_post(E &ex, coroutine_handle<> h, ...) -> decltype(ex.execute(h), void()) { ex.execute(h); }
+    template <class E> inline auto is_coroutine_executor(int /*unused*/) -> decltype(executor_post(std::declval<E &>(), coroutine_handle<>(), 5), std::true_type())
+    {
+      return {};
+    }
+    template <class E> inline std::false_type is_coroutine_executor(...) { return {}; }
+
+    // Captures the first coroutine parameter which is the executor
+    template <class Executor, bool = decltype(is_coroutine_executor<Executor>(5))::value> class promise_executor
+    {
+      union
+      {
+        BOOST_OUTCOME_V2_NAMESPACE::detail::empty_type _default{};
+        Executor _executor;
+      };
+      bool _has_executor{false};
+
+      template <class T> void _capture(std::true_type /*unused*/, T &v)
+      {
+        if(!_has_executor)
+        {
+          new(&_executor) Executor(v);  // could throw
+          _has_executor = true;
+        }
+      }
+      template <class T> void _capture(std::false_type /*unused*/, T & /*unused*/) {}
+
+    public:
+      promise_executor() noexcept {}
+      template <class... Args> explicit promise_executor(Args &...args)
+      {
+        int x[] = {0, (_capture(std::is_convertible<Args &, const Executor &>(), args), 0)...};
+        (void) x;
+      }
+      promise_executor(const promise_executor &) = delete;
+      promise_executor(promise_executor &&) = delete;
+      promise_executor &operator=(const promise_executor &) = delete;
+      promise_executor &operator=(promise_executor &&) = delete;
+      ~promise_executor()
+      {
+        if(_has_executor)
+        {
+          _executor.~Executor();
+        }
+      }
+      const Executor *executor() const noexcept { return _has_executor ? &_executor : nullptr; }
+      bool post_through_executor(coroutine_handle<> h)  // could throw
+      {
+        if(!_has_executor)
+        {
+          return false;
+        }
+        detail::executor_post(_executor, h, 5);
+        return true;
+      }
+    };
+    template <class Executor> class promise_executor<Executor, false>
+    {
+    public:
+      promise_executor() noexcept {}
+      template <class... Args> explicit promise_executor(Args &... /*unused*/) noexcept {}
+      const Executor *executor() const noexcept { return nullptr; }
+      bool post_through_executor(coroutine_handle<> /*unused*/) noexcept { return false; }
+    };
+
+#if BOOST_OUTCOME_HAVE_STOP_TOKEN
+    // Captures the first coroutine parameter which is a std::stop_token
+    class promise_stop_token
+    {
+      std::stop_token _stop_token;
+      bool _has_stop_token{false};
+
+      template <class T> void _capture(std::true_type /*unused*/, T &v) noexcept
+      {
+        if(!_has_stop_token)
+        {
+          _stop_token = v;
+          _has_stop_token = true;
+        }
+      }
+      template <class T> void _capture(std::false_type /*unused*/, T & /*unused*/) noexcept {}
+
+    public:
+      promise_stop_token() noexcept {}
+      template <class... Args> explicit promise_stop_token(Args &...args) noexcept
+      {
+        int x[] = {0, (_capture(std::is_same<std::decay_t<Args>, std::stop_token>(), args), 0)...};
+        (void) x;
+      }
+      const std::stop_token *stop_token() const noexcept { return _has_stop_token ? &_stop_token : nullptr; }
+      bool stop_requested() const noexcept { return _stop_token.stop_requested(); }
+      // Only before the coroutine has begun, as it may otherwise be reading its stop token concurrently
+      void inherit_stop_token(const std::stop_token *v) noexcept
+      {
+        if(!_has_stop_token && v != nullptr)
+        {
+          _stop_token = *v;
+          _has_stop_token = true;
+        }
+      }
+    };
+
+    // Awaitables of Outcome's coroutines inherit the stop token of the coroutine awaiting them
+    template <class T> inline auto inherit_stop_token(T &v, const std::stop_token *t, int /*unused*/) -> decltype(v._inherit_stop_token(t), void())
+    {
+      v._inherit_stop_token(t);
+    }
+    template <class T> inline void inherit_stop_token(T & /*unused*/, const std::stop_token * /*unused*/, ...) {}
+
+    // What co_await does to find the awaiter of an awaitable
+    template <class T> inline auto get_awaiter(T &&v, int /*unused*/) -> decltype(static_cast<T &&>(v).operator co_await())
+    {
+      return static_cast<T &&>(v).operator co_await();
+    }
+    template <class T> inline auto get_awaiter(T &&v, long /*unused*/) -> decltype(operator co_await(static_cast<T &&>(v)))
+    {
+      return operator co_await(static_cast<T &&>(v));
+    }
+    template <class T> inline T &&get_awaiter(T &&v, ...) { return static_cast<T &&>(v); }
+
+    /* Checks the stop token of the awaiting coroutine before suspending. If stop was requested, the coroutine
+    completes with operation_canceled at this suspension point instead, and is never resumed.
+    */
+    template <class Promise, class Awaiter> struct cancellable_awaiter
+    {
+      Awaiter awaiter;
+      Promise *promise;
+
+      bool await_ready() { return !promise->stop_requested() && awaiter.await_ready(); }
+      decltype(auto) await_resume() { return awaiter.await_resume(); }
+#if BOOST_OUTCOME_HAVE_NOOP_COROUTINE
+      coroutine_handle<> await_suspend(coroutine_handle<Promise> h)  // could throw
+      {
+        if(promise->stop_requested())
+        {
+          promise->set_operation_canceled();
+          return promise->complete(h);
+        }
+        using result_type = decltype(awaiter.await_suspend(h));
+        if constexpr(std::is_void<result_type>::value)
+        {
+          awaiter.await_suspend(h);
+          return noop_coroutine();
+        }
+        else if constexpr(std::is_same<result_type, bool>::value)
+        {
+          return awaiter.await_suspend(h) ? noop_coroutine() : coroutine_handle<>(h);
+        }
+        else
+        {
+          return awaiter.await_suspend(h);
+        }
+      }
+#else
+      bool await_suspend(coroutine_handle<Promise> h)  // could throw
+      {
+        if(promise->stop_requested())
+        {
+          promise->set_operation_canceled();
+          promise->complete(h);
+          return true;
+        }
+        using result_type = decltype(awaiter.await_suspend(h));
+        if constexpr(std::is_void<result_type>::value)
+        {
+          awaiter.await_suspend(h);
+          return true;
+        }
+        else if constexpr(std::is_same<result_type, bool>::value)
+        {
+          return awaiter.await_suspend(h);
+        }
+        else
+        {
+          awaiter.await_suspend(h).resume();
+          return true;
+        }
+      }
+#endif
+    };
+#else
+    class promise_stop_token
+    {
+    public:
+      promise_stop_token() noexcept {}
+      template <class... Args> explicit promise_stop_token(Args &... /*unused*/) noexcept {}
+      bool stop_requested() const noexcept { return false; }
+    };
+#endif
+
+    // If the awaiting coroutine has an executor, it is resumed through that
+    using continuation_poster_type = bool (*)(coroutine_handle<>);
+    template <class P> inline bool post_continuation_through_executor(coroutine_handle<> h)
+    {
+      return coroutine_handle<P>::from_address(h.address()).promise().post_through_executor(h);
+    }
+    template <class P>
+    inline auto continuation_poster(int /*unused*/) -> decltype(std::declval<P &>().post_through_executor(coroutine_handle<>()), continuation_poster_type())
+    {
+      return &post_continuation_through_executor<P>;
+    }
+    template <class P> inline continuation_poster_type continuation_poster(...) { return nullptr; }
+
+    /* Whichever of the awaiter and the completion of the coroutine comes second resumes the awaiter,
+    as the coroutine may complete on another thread. Once completed, the coroutine may be destroyed
+    at any time unless it was already being awaited. A detached coroutine destroys itself upon completion.
+    */
+    template <class Executor, bool suspend_initial, bool use_atomic> struct outcome_promise_base : promise_frame_allocation, promise_executor<Executor>, promise_stop_token
+    {
+      static constexpr uint8_t awaited_bit = 1, completed_bit = 2, detached_bit = 4;
+      using handoff_type = std::conditional_t<use_atomic, std::atomic<uint8_t>, fake_atomic<uint8_t>>;
+      handoff_type handoff{0};
+      coroutine_handle<> continuation;
+      continuation_poster_type post_continuation{nullptr};
+      // If set, only the completion which counts this down to zero resumes the continuation
+      std::atomic<size_t> *countdown{nullptr};
+
+      outcome_promise_base() noexcept {}
+      template <class... Args>
+      explicit outcome_promise_base(Args &...args)
+          : promise_executor<Executor>(args...)
+          , promise_stop_token(args...)
+      {
+      }
+
+      bool completed() noexcept { return (handoff.load(std::memory_order_acquire) & completed_bit) != 0; }
+      // Called from the final suspension point, so if the executor fails to post, the continuation is resumed here instead
+      bool try_post_continuation() noexcept
+      {
+        if(post_continuation == nullptr)
+        {
+          return false;
+        }
+#ifndef BOOST_NO_EXCEPTIONS
+        try
+        {
+          return post_continuation(continuation);
+        }
+        catch(...)
+        {
+          return false;
+        }
+#else
+        return post_continuation(continuation);
+#endif
+      }
+      coroutine_handle<> continuation_to_resume() noexcept
+      {
+        // Once counted down, the coroutine may be destroyed at any time unless it resumes the continuation
+        const bool resume = (countdown == nullptr || countdown->fetch_sub(1, std::memory_order_acq_rel) == 1) && continuation;
+#if BOOST_OUTCOME_HAVE_NOOP_COROUTINE
+        if(!resume || try_post_continuation())
+        {
+          return noop_coroutine();
+        }
+#else
+        if(!resume || try_post_continuation())
+        {
+          return {};
+        }
+#endif
+        return continuation;
+      }
+      template <class P> void set_continuation(coroutine_handle<P> cont) noexcept
+      {
+        continuation = cont;
+        post_continuation = detail::continuation_poster<P>(5);
+      }
+      // Called once the result is set, from the final or any earlier suspension point
+#if BOOST_OUTCOME_HAVE_NOOP_COROUTINE
+      coroutine_handle<> complete(coroutine_handle<> h) noexcept
+      {
+        const auto state = handoff.fetch_or(completed_bit, std::memory_order_acq_rel);
+        if(state & detached_bit)
+        {
+          h.destroy();
+          return noop_coroutine();
+        }
+        if(!(state & awaited_bit))
+        {
+          return noop_coroutine();
+        }
+        return continuation_to_resume();
+      }
+#else
+      void complete(coroutine_handle<> h) noexcept
+      {
+        const auto state = handoff.fetch_or(completed_bit, std::memory_order_acq_rel);
+        if(state & detached_bit)
+        {
+          return h.destroy();
+        }
+        if(state & awaited_bit)
+        {
+          if(auto c = continuation_to_resume())
+          {
+            return c.resume();
+          }
+        }
+      }
+#endif
+
+      auto initial_suspend() noexcept
+      {
+        struct awaiter
+        {
+          outcome_promise_base *self;
+          bool await_ready() noexcept { return !suspend_initial && self->executor() == nullptr; }
+          void await_resume() noexcept {}
+          void await_suspend(coroutine_handle<> h)  // could throw
+          {
+            // Eager coroutines with an executor begin upon it
+            if(!suspend_initial)
+            {
+              self->post_through_executor(h);
+            }
+          }
+        };
+        return awaiter{this};
+      }
+      auto final_suspend() noexcept
+      {
+        struct awaiter
+        {
+          outcome_promise_base *self;
+          bool await_ready() noexcept { return false; }
+          void await_resume() noexcept {}
+#if BOOST_OUTCOME_HAVE_NOOP_COROUTINE
+          coroutine_handle<> await_suspend(coroutine_handle<> h) noexcept { return self->complete(h); }
+#else
+          void await_suspend(coroutine_handle<> h) noexcept { self->complete(h); }
+#endif
+        };
+        return awaiter{this};
+      }
+    };
+
+    template <class Awaitable, bool suspend_initial, bool use_atomic, bool is_void>
+    struct outcome_promise_type : outcome_promise_base<typename Awaitable::executor_type, suspend_initial, use_atomic>
     {
       using container_type = typename Awaitable::container_type;
       using result_set_type = std::conditional_t<use_atomic, std::atomic<bool>, fake_atomic<bool>>;
@@ -142,9 +691,13 @@ namespace awaitables
         container_type result;
       };
       result_set_type result_set{false};
-      coroutine_handle<> continuation;
 
       outcome_promise_type() noexcept {}
+      template <class... Args>
+      explicit outcome_promise_type(Args &...args)
+          : outcome_promise_base<typename Awaitable::executor_type, suspend_initial, use_atomic>(args...)
+      {
+      }
       outcome_promise_type(const outcome_promise_type &) = delete;
       outcome_promise_type(outcome_promise_type &&) = delete;
       outcome_promise_type &operator=(const outcome_promise_type &) = delete;
@@ -200,48 +753,43 @@ namespace awaitables
 #endif
         result_set.store(true, std::memory_order_release);
       }
-      auto initial_suspend() noexcept
+#if BOOST_OUTCOME_HAVE_STOP_TOKEN
+      void set_operation_canceled()
       {
-        struct awaiter
-        {
-          bool await_ready() noexcept { return !suspend_initial; }
-          void await_resume() noexcept {}
-          void await_suspend(coroutine_handle<> /*unused*/) noexcept {}
-        };
-        return awaiter{};
+        assert(!result_set.load(std::memory_order_acquire));
+        detail::set_operation_canceled(&result);  // could throw
+        result_set.store(true, std::memory_order_release);
       }
-      auto final_suspend() noexcept
+      // Coroutines whose result can be operation_canceled check their stop token at every co_await
+      template <class T> decltype(auto) await_transform(T &&v)
       {
-        struct awaiter
+        detail::inherit_stop_token(v, this->stop_token(), 5);
+        if constexpr(detail::can_set_operation_canceled<container_type>::value)
         {
-          bool await_ready() noexcept { return false; }
-          void await_resume() noexcept {}
-#if BOOST_OUTCOME_HAVE_NOOP_COROUTINE
-          coroutine_handle<> await_suspend(coroutine_handle<outcome_promise_type> self) noexcept
-          {
-            return self.promise().continuation ? self.promise().continuation : noop_coroutine();
-          }
-#else
-          void await_suspend(coroutine_handle<outcome_promise_type> self)
-          {
-            if(self.promise().continuation)
-            {
-              return self.promise().continuation.resume();
-            }
-          }
-#endif
-        };
-        return awaiter{};
+          using awaiter_type = decltype(detail::get_awaiter(static_cast<T &&>(v), 5));
+          return detail::cancellable_awaiter<outcome_promise_type, awaiter_type>{detail::get_awaiter(static_cast<T &&>(v), 5), this};
+        }
+        else
+        {
+          return static_cast<T &&>(v);
+        }
       }
+#endif
     };
-    template <class Awaitable, bool suspend_initial, bool use_atomic> struct outcome_promise_type<Awaitable, suspend_initial, use_atomic, true>
+    template <class Awaitable, bool suspend_initial, bool use_atomic>
+    struct outcome_promise_type<Awaitable, suspend_initial, use_atomic, true>
+        : outcome_promise_base<typename Awaitable::executor_type, suspend_initial, use_atomic>
     {
       using container_type = void;
       using result_set_type = std::conditional_t<use_atomic, std::atomic<bool>, fake_atomic<bool>>;
       result_set_type result_set{false};
-      coroutine_handle<> continuation;
 
       outcome_promise_type() {}
+      template <class... Args>
+      explicit outcome_promise_type(Args &...args)
+          : outcome_promise_base<typename Awaitable::executor_type, suspend_initial, use_atomic>(args...)
+      {
+      }
       outcome_promise_type(const outcome_promise_type &) = delete;
       outcome_promise_type(outcome_promise_type &&) = delete;
       outcome_promise_type &operator=(const outcome_promise_type &) = delete;
@@ -261,39 +809,6 @@ namespace awaitables
         assert(!result_set.load(std::memory_order_acquire));
         std::rethrow_exception(std::current_exception());  // throws
       }
-      auto initial_suspend() noexcept
-      {
-        struct awaiter
-        {
-          bool await_ready() noexcept { return !suspend_initial; }
-          void await_resume() noexcept {}
-          void await_suspend(coroutine_handle<> /*unused*/) noexcept {}
-        };
-        return awaiter{};
-      }
-      auto final_suspend() noexcept
-      {
-        struct awaiter
-        {
-          bool await_ready() noexcept { return false; }
-          void await_resume() noexcept {}
-#if BOOST_OUTCOME_HAVE_NOOP_COROUTINE
-          coroutine_handle<> await_suspend(coroutine_handle<outcome_promise_type> self) noexcept
-          {
-            return self.promise().continuation ? self.promise().continuation : noop_coroutine();
-          }
-#else
-          void await_suspend(coroutine_handle<outcome_promise_type> self)
-          {
-            if(self.promise().continuation)
-            {
-              return self.promise().continuation.resume();
-            }
-          }
-#endif
-        };
-        return awaiter{};
-      }
     };
     template <class Awaitable, bool suspend_initial, bool use_atomic>
     constexpr inline auto move_result_from_promise_if_not_void(outcome_promise_type<Awaitable, suspend_initial, use_atomic, false> &p)
@@ -321,9 +836,12 @@ namespace awaitables
       awaitable(const awaitable &o) = delete;
       awaitable &operator=(awaitable &&) = delete;  // as per P1056
       awaitable &operator=(const awaitable &) = delete;
+      /* An atomic coroutine, or one with an executor, which has begun but not completed may be running
+      elsewhere, so destroys itself upon completion. Anything else can only be suspended, so is destroyed.
+      */
       ~awaitable()
       {
-        if(_h)
+        if(_h && !((use_atomic || executor() != nullptr) && _begun() && _detach()))
         {
           _h.destroy();
         }
@@ -333,7 +851,8 @@ namespace awaitables
       {
       }
       bool valid() const noexcept { return _h != nullptr; }
-      bool await_ready() noexcept { return _h.promise().result_set.load(std::memory_order_acquire); }
+      const executor_type *executor() const noexcept { return _h.promise().executor(); }
+      bool await_ready() noexcept { return _h.promise().completed(); }
       container_type await_resume()
       {
         assert(_h.promise().result_set.load(std::memory_order_acquire));
@@ -344,18 +863,104 @@ namespace awaitables
         return detail::move_result_from_promise_if_not_void(_h.promise());
       }
 #if BOOST_OUTCOME_HAVE_NOOP_COROUTINE
-      coroutine_handle<> await_suspend(coroutine_handle<> cont) noexcept
+      // Without a continuation, whoever began this polls await_ready() instead of being resumed
+      template <class P = void> coroutine_handle<> await_suspend(coroutine_handle<P> cont)  // could throw
       {
-        _h.promise().continuation = cont;
-        return _h;
+        auto &p = _h.promise();
+        if(suspend_initial)
+        {
+          // Not yet begun, so nothing can race. Marked as awaited even without a continuation, so it is seen to have begun.
+          if(cont)
+          {
+            p.set_continuation(cont);
+          }
+          p.handoff.store(p.awaited_bit, std::memory_order_release);
+          if(p.post_through_executor(_h))
+          {
+            return noop_coroutine();
+          }
+          return _h;
+        }
+        // Begun, so may be completing concurrently
+        if(!cont)
+        {
+          return noop_coroutine();
+        }
+        p.set_continuation(cont);
+        if(p.handoff.fetch_or(p.awaited_bit, std::memory_order_acq_rel) & p.completed_bit)
+        {
+          return cont;
+        }
+        return noop_coroutine();
       }
 #else
-      void await_suspend(coroutine_handle<> cont)
+      template <class P = void> bool await_suspend(coroutine_handle<P> cont)  // could throw
       {
-        _h.promise().continuation = cont;
-        _h.resume();
+        auto &p = _h.promise();
+        if(suspend_initial)
+        {
+          if(cont)
+          {
+            p.set_continuation(cont);
+          }
+          p.handoff.store(p.awaited_bit, std::memory_order_release);
+          if(!p.post_through_executor(_h))
+          {
+            _h.resume();
+          }
+          return true;
+        }
+        if(!cont)
+        {
+          return true;
+        }
+        p.set_continuation(cont);
+        return !(p.handoff.fetch_or(p.awaited_bit, std::memory_order_acq_rel) & p.completed_bit);
+      }
+#endif
+
+      /* For awaiting alongside other awaitables. Begins or joins the coroutine, whose completion counts
+      down `*countdown` and resumes `cont` if that reached zero. Returns false if it had already completed,
+      in which case it does not count down.
+      */
+      template <class P> bool _await_counted(coroutine_handle<P> cont, std::atomic<size_t> *countdown)  // could throw
+      {
+        auto &p = _h.promise();
+        p.countdown = countdown;
+        p.set_continuation(cont);
+        if(suspend_initial)
+        {
+          p.handoff.store(p.awaited_bit, std::memory_order_release);
+          if(!p.post_through_executor(_h))
+          {
+            _h.resume();
+          }
+          return true;
+        }
+        return !(p.handoff.fetch_or(p.awaited_bit, std::memory_order_acq_rel) & p.completed_bit);
+      }
+#if BOOST_OUTCOME_HAVE_STOP_TOKEN
+      // Only lazy coroutines not yet begun inherit a stop token
+      void _inherit_stop_token(const std::stop_token *t) noexcept
+      {
+        if(suspend_initial && _h.promise().handoff.load(std::memory_order_acquire) == 0)
+        {
+          _h.promise().inherit_stop_token(t);
+        }
       }
 #endif
+      // Eager coroutines begin when created, lazy ones when first awaited
+      bool _begun() noexcept { return !suspend_initial || _h.promise().handoff.load(std::memory_order_acquire) != 0; }
+      // Lets a begun coroutine destroy itself upon completion. Returns false if it had already completed.
+      bool _detach() noexcept
+      {
+        if(_h.promise().handoff.fetch_or(promise_type::detached_bit, std::memory_order_acq_rel) & promise_type::completed_bit)
+        {
+          return false;
+        }
+        _h = nullptr;
+        return true;
+      }
     };
 
     template <class ContType, class Executor, bool suspend_initial, bool use_atomic> struct generator
@@ -363,7 +968,7 @@ namespace awaitables
       using container_type = ContType;
       using value_type = ContType;
       using executor_type = Executor;
-      class promise_type
+      class promise_type : public promise_frame_allocation
       {
         friend struct generator;
         using result_set_type = std::conditional_t<use_atomic, std::atomic<int8_t>, fake_atomic<int8_t>>;
@@ -543,6 +1148,152 @@ namespace awaitables
       }
 #endif
     };
+
+#if __cpp_lib_span >= 202002L
+    // Fills a buffer of N values before suspending, so the consumer resumes the coroutine once per batch
+    template <class ContType, size_t N, class Executor> struct batch_generator
+    {
+      static_assert(N > 0, "batch_generator must be able to hold at least one value");
+      using container_type = ContType;
+      using value_type = ContType;
+      using executor_type = Executor;
+      static constexpr size_t batch_size = N;
+      class promise_type : public promise_frame_allocation
+      {
+        friend struct batch_generator;
+        union
+        {
+          BOOST_OUTCOME_V2_NAMESPACE::detail::empty_type _default{};
+          container_type results[N];
+        };
+        size_t count{0};
+        bool handed_out{false};  // results have been returned to the consumer
+        bool finished{false};
+
+        void _clear()
+        {
+          while(count > 0)
+          {
+            results[--count].~container_type();  // could throw
+          }
+        }
+        auto _yielded() noexcept
+        {
+          struct awaiter
+          {
+            bool full;
+            bool await_ready() noexcept { return !full; }
+            void await_resume() noexcept {}
+            void await_suspend(coroutine_handle<> /*unused*/) noexcept {}
+          };
+          return awaiter{++count == N};
+        }
+
+      public:
+        promise_type() {}
+        promise_type(const promise_type &) = delete;
+        promise_type(promise_type &&) = delete;
+        promise_type &operator=(const promise_type &) = delete;
+        promise_type &operator=(promise_type &&) = delete;
+        ~promise_type() { _clear(); }
+
+        auto get_return_object()
+        {
+          return batch_generator{*this};  // could throw bad_alloc
+        }
+        void return_void() noexcept { finished = true; }
+        auto yield_value(container_type &&value)
+        {
+          assert(count < N);
+          new(&results[count]) container_type(static_cast<container_type &&>(value));  // could throw
+          return _yielded();
+        }
+        auto yield_value(const container_type &value)
+        {
+          assert(count < N);
+          new(&results[count]) container_type(value);  // could throw
+          return _yielded();
+        }
+        void unhandled_exception()
+        {
+          // The coroutine only runs with room left in its buffer, so the failure becomes the last value
+          assert(count < N);
+          finished = true;
+#ifndef BOOST_NO_EXCEPTIONS
+          auto e = std::current_exception();
+          auto ec = detail::error_from_exception(static_cast<decltype(e) &&>(e), {});
+          // Try to set error code first
+          if(!detail::error_is_set(ec) || !detail::try_set_error(static_cast<decltype(ec) &&>(ec), &results[count]))
+          {
+            detail::set_or_rethrow(e, &results[count]);  // could throw
+          }
+#else
+          std::terminate();
+#endif
+          ++count;
+        }
+        suspend_always initial_suspend() noexcept { return {}; }
+        suspend_always final_suspend() noexcept { return {}; }
+      };
+      coroutine_handle<promise_type> _h;
+
+      batch_generator(batch_generator &&o) noexcept
+          : _h(static_cast<coroutine_handle<promise_type> &&>(o._h))
+      {
+        o._h = nullptr;
+      }
+      batch_generator(const batch_generator &o) = delete;
+      batch_generator &operator=(batch_generator &&) = delete;  // as per P1056
+      batch_generator &operator=(const batch_generator &) = delete;
+      ~batch_generator()
+      {
+        if(_h)
+        {
+          _h.destroy();
+        }
+      }
+      explicit batch_generator(promise_type &p)  // could throw
+          : _h(coroutine_handle<promise_type>::from_promise(p))
+      {
+      }
+      explicit operator bool() const  // could throw
+      {
+        return valid();
+      }
+      bool valid() const  // could throw
+      {
+        const_cast<batch_generator *>(this)->_fill();
+        return _h.promise().count > 0;
+      }
+      // The values are valid until the next call to valid() or operator()(), and may be moved from
+      std::span<container_type> operator()()  // could throw
+      {
+        _fill();
+        auto &p = _h.promise();
+        if(p.count == 0)
+        {
+          std::terminate();
+        }
+        p.handed_out = true;
+        return {p.results, p.count};
+      }
+
+    private:
+      void _fill()
+      {
+        auto &p = _h.promise();
+        if(p.handed_out || (p.count == 0 && !p.finished))
+        {
+          p._clear();
+          p.handed_out = false;
+          if(!p.finished)
+          {
+            _h();
+          }
+        }
+      }
+    };
+#endif
 #endif
   }  // namespace detail
 
@@ -579,5 +1330,12 @@ SIGNATURE NOT RECOGNISED
 */
 template <class T, class Executor = void> using generator = BOOST_OUTCOME_V2_NAMESPACE::awaitables::detail::generator<T, Executor, true, false>;
 
+#if __cpp_lib_span >= 202002L
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T, size_t N, class Executor = void> using batch_generator = BOOST_OUTCOME_V2_NAMESPACE::awaitables::detail::batch_generator<T, N, Executor>;
+#endif
+
 BOOST_OUTCOME_COROUTINE_SUPPORT_NAMESPACE_END
 #endif
@@ -0,0 +1,70 @@
+/* Small per thread caches shared by the exception conversions
+(C) 2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2024
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef BOOST_OUTCOME_DETAIL_PER_THREAD_CACHE_HPP
+#define BOOST_OUTCOME_DETAIL_PER_THREAD_CACHE_HPP
+
+#include <cstddef>  // for size_t
+#include <cstdint>  // for uintptr_t
+#include <cstring>  // for memcpy
+#include <exception>
+
+/* This is shared by Outcome and by the bundled status code, which do not share a namespace,
+so it lives in its own. Nothing here depends upon configuration macros.
+*/
+namespace boost
+{
+  namespace outcome_detail
+  {
+    /* A small direct mapped cache. Declare it `static thread_local` so there is no contention
+    between threads. Entries are found by hashing an address, mixed with an optional salt,
+    ignoring the low bits which alignment leaves zero.
+    */
+    template <class Entry, size_t Size = 16> struct per_thread_cache
+    {
+      Entry entries[Size];
+
+      Entry &lookup(const void *key, uintptr_t salt = 0) noexcept { return entries[((reinterpret_cast<uintptr_t>(key) >> 4) ^ salt) % Size]; }
+    };
+
+#ifdef __GLIBCXX__
+    // The thrown object, which is what a libstdc++ exception_ptr points at
+    inline void *exception_ptr_object(const std::exception_ptr &ep) noexcept
+    {
+      static_assert(sizeof(std::exception_ptr) == sizeof(void *), "std::exception_ptr is not a pointer to the thrown object");
+      void *ret;
+      memcpy(&ret, &ep, sizeof(ret));
+      return ret;
+    }
+#endif
+  }  // namespace outcome_detail
+}  // namespace boost
+
+#endif
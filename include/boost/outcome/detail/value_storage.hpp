@@ -34,6 +34,8 @@ DEALINGS IN THE SOFTWARE.
 #include "../config.hpp"
 
 #include <cassert>
+#include <cstring>  // for memcpy and memmove
+#include <functional>  // for std::less
 
 BOOST_OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
 
@@ -234,6 +236,107 @@ constexpr inline void strong_placement(bool &allgood, T *a, T *b, F &&f) noexcep
 
 namespace detail
 {
+  template <class T, bool trivial> struct relocate_n_impl
+  {
+    static T *relocate(T *first, size_t count, T *dest) noexcept
+    {
+      if(count > 0 && first != dest)
+      {
+        memmove(static_cast<void *>(dest), static_cast<const void *>(first), count * sizeof(T));
+      }
+      return dest + count;
+    }
+  };
+  template <class T> struct relocate_n_impl<T, false>
+  {
+    static T *relocate(T *first, size_t count, T *dest) noexcept(std::is_nothrow_move_constructible<T>::value)
+    {
+      if(first == dest)
+      {
+        return dest + count;
+      }
+      // If the destination overlaps the tail of the source, work backwards so nothing gets overwritten before it is relocated
+      struct _
+      {
+        T *first, *dest;
+        size_t count, done;
+        bool backwards;
+        size_t index(size_t n) const noexcept { return backwards ? count - 1 - n : n; }
+        ~_()
+        {
+          // If a move constructor threw, destroy everything so both ranges are left empty
+          if(done != count)
+          {
+            for(size_t n = 0; n < count; n++)
+            {
+              (n < done) ? dest[index(n)].~T() : first[index(n)].~T();
+            }
+          }
+        }
+      } _{first, dest, count, 0, std::less<T *>()(first, dest) && std::less<T *>()(dest, first + count)};
+      for(; _.done < count; ++_.done)
+      {
+        const size_t idx = _.index(_.done);
+        new(dest + idx) T(static_cast<T &&>(first[idx]));
+        first[idx].~T();
+      }
+      return dest + count;
+    }
+  };
+}  // namespace detail
+
+/*!
+ */
+BOOST_OUTCOME_TEMPLATE(class T)
+BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(trait::is_trivially_relocatable<T>::value || std::is_move_constructible<T>::value))
+inline T *relocate_n(T *first, size_t count, T *dest) noexcept(trait::is_trivially_relocatable<T>::value || std::is_nothrow_move_constructible<T>::value)
+{
+  return detail::relocate_n_impl<T, trait::is_trivially_relocatable<T>::value>::relocate(first, count, dest);
+}
+
+namespace detail
+{
+  // Tags construction of the value or error from the return of a callable, so it is never moved
+  template <class T> struct in_place_invoke_type_t
+  {
+  };
+
+  // True if the value and error storage can be swapped by exchanging their bytes
+  template <class T, class E>
+  struct is_bitwise_swappable
+      : std::integral_constant<bool, trait::is_trivially_relocatable<devoid<T>>::value && trait::is_trivially_relocatable<devoid<E>>::value>
+  {
+  };
+
+  /* Exchanges the live bytes of two non-overlapping regions, where `a_bytes` and `b_bytes` are the
+  sizes of the objects living in each, or zero if there are none. Bytes beyond those are never read,
+  as they may be uninitialised.
+  */
+  inline void swap_bytes(void *a, size_t a_bytes, void *b, size_t b_bytes) noexcept
+  {
+    auto *x = static_cast<unsigned char *>(a), *y = static_cast<unsigned char *>(b);
+    size_t bytes = (a_bytes < b_bytes) ? a_bytes : b_bytes;
+    if(a_bytes > bytes)
+    {
+      memcpy(y + bytes, x + bytes, a_bytes - bytes);
+    }
+    else if(b_bytes > bytes)
+    {
+      memcpy(x + bytes, y + bytes, b_bytes - bytes);
+    }
+    unsigned char temp[64];
+    while(bytes > 0)
+    {
+      const size_t n = (bytes < sizeof(temp)) ? bytes : sizeof(temp);
+      memcpy(temp, x, n);
+      memcpy(x, y, n);
+      memcpy(y, temp, n);
+      x += n;
+      y += n;
+      bytes -= n;
+    }
+  }
+
   template <class T>
   constexpr
 #ifdef _MSC_VER
@@ -259,12 +362,16 @@ namespace detail
   even then unreliably. https://wg21.link/P1886 "Error speed benchmarking" showed just how
   poorly clang and MSVC fails to optimise outcome-using code, if you manually set bits.
 
-  Outcome v2.2 therefore uses an enum with fixed values, and constexpr manipulation functions
-  to change the value to one of the enum's values. This is stupid to look at in source code,
-  but it make clang's optimiser do the right thing, so it's worth it.
+  Outcome v2.2 therefore uses an enum with fixed values. It also had an alternative mode,
+  BOOST_OUTCOME_USE_CONSTEXPR_ENUM_STATUS, whose constexpr manipulation functions switched over
+  every enum value. That mode was never enabled by default, and has been removed, so the status
+  bits are always observed and changed bitwise as below.
   */
-#define BOOST_OUTCOME_USE_CONSTEXPR_ENUM_STATUS 0
+#if BOOST_OUTCOME_SPARE_STORAGE_BITS == 0
+  enum class status : uint8_t
+#else
   enum class status : uint16_t
+#endif
   {
     // WARNING: These bits are not tracked by abi-dumper, but changing them will break ABI!
     none = 0,
@@ -295,17 +402,22 @@ namespace detail
   struct status_bitfield_type
   {
     status status_value{status::none};
+#if BOOST_OUTCOME_SPARE_STORAGE_BITS >= 16
     uint16_t spare_storage_value{0};  // hooks::spare_storage()
+#endif
+#if BOOST_OUTCOME_SPARE_STORAGE_BITS == 48
+    uint32_t spare_storage_value_high{0};  // top 32 bits of hooks::spare_storage()
+#endif
 
     constexpr status_bitfield_type() = default;
     constexpr status_bitfield_type(status v) noexcept
         : status_value(v)
     {
     }  // NOLINT
-    constexpr status_bitfield_type(status v, uint16_t s) noexcept
+    constexpr status_bitfield_type(status v, spare_storage_type s) noexcept
         : status_value(v)
-        , spare_storage_value(s)
     {
+      set_spare_storage(s);
     }
     constexpr status_bitfield_type(const status_bitfield_type &) = default;
     constexpr status_bitfield_type(status_bitfield_type &&) = default;
@@ -313,529 +425,96 @@ namespace detail
     constexpr status_bitfield_type &operator=(status_bitfield_type &&) = default;
     //~status_bitfield_type() = default;  // Do NOT uncomment this, it breaks older clangs!
 
-    constexpr bool have_value() const noexcept
+    constexpr spare_storage_type spare_storage() const noexcept
     {
-#if BOOST_OUTCOME_USE_CONSTEXPR_ENUM_STATUS
-      return (status_value == status::have_value)                      //
-             || (status_value == status::have_value_lost_consistency)  //
-      ;
+#if BOOST_OUTCOME_SPARE_STORAGE_BITS == 48
+      return (static_cast<spare_storage_type>(spare_storage_value_high) << 16U) | spare_storage_value;
+#elif BOOST_OUTCOME_SPARE_STORAGE_BITS == 16
+      return spare_storage_value;
 #else
-      return (static_cast<uint16_t>(status_value) & static_cast<uint16_t>(status::have_value)) != 0;
+      return 0;
 #endif
     }
+    constexpr status_bitfield_type &set_spare_storage(spare_storage_type v) noexcept
+    {
+#if BOOST_OUTCOME_SPARE_STORAGE_BITS == 48
+      // Only the bottom 48 bits of the uint64_t are kept
+      spare_storage_value = static_cast<uint16_t>(v);
+      spare_storage_value_high = static_cast<uint32_t>(v >> 16U);
+#elif BOOST_OUTCOME_SPARE_STORAGE_BITS == 16
+      spare_storage_value = v;
+#else
+      (void) v;
+#endif
+      return *this;
+    }
+
+    constexpr bool have_value() const noexcept
+    {
+      return (static_cast<uint16_t>(status_value) & static_cast<uint16_t>(status::have_value)) != 0;
+    }
     constexpr bool have_error() const noexcept
     {
-#if BOOST_OUTCOME_USE_CONSTEXPR_ENUM_STATUS
-      return (status_value == status::have_error)                                               //
-             || (status_value == status::have_error_exception)                                  //
-             || (status_value == status::have_error_lost_consistency)                           //
-             || (status_value == status::have_error_exception_lost_consistency)                 //
-             || (status_value == status::have_error_error_is_errno)                             //
-             || (status_value == status::have_error_exception_error_is_errno)                   //
-             || (status_value == status::have_error_lost_consistency_error_is_errno)            //
-             || (status_value == status::have_error_exception_lost_consistency_error_is_errno)  //
-      ;
-#else
       return (static_cast<uint16_t>(status_value) & static_cast<uint16_t>(status::have_error)) != 0;
-#endif
     }
     constexpr bool have_exception() const noexcept
     {
-#if BOOST_OUTCOME_USE_CONSTEXPR_ENUM_STATUS
-      return (status_value == status::have_exception)                                           //
-             || (status_value == status::have_error_exception)                                  //
-             || (status_value == status::have_exception_lost_consistency)                       //
-             || (status_value == status::have_error_exception_lost_consistency)                 //
-             || (status_value == status::have_error_exception_error_is_errno)                   //
-             || (status_value == status::have_error_exception_lost_consistency_error_is_errno)  //
-      ;
-#else
       return (static_cast<uint16_t>(status_value) & static_cast<uint16_t>(status::have_exception)) != 0;
-#endif
     }
     constexpr bool have_lost_consistency() const noexcept
     {
-#if BOOST_OUTCOME_USE_CONSTEXPR_ENUM_STATUS
-      return (status_value == status::have_value_lost_consistency)                              //
-             || (status_value == status::have_error_lost_consistency)                           //
-             || (status_value == status::have_exception_lost_consistency)                       //
-             || (status_value == status::have_error_lost_consistency_error_is_errno)            //
-             || (status_value == status::have_error_exception_lost_consistency_error_is_errno)  //
-      ;
-#else
       return (static_cast<uint16_t>(status_value) & static_cast<uint16_t>(status::have_lost_consistency)) != 0;
-#endif
     }
     constexpr bool have_error_is_errno() const noexcept
     {
-#if BOOST_OUTCOME_USE_CONSTEXPR_ENUM_STATUS
-      return (status_value == status::have_error_error_is_errno)                                //
-             || (status_value == status::have_error_exception_error_is_errno)                   //
-             || (status_value == status::have_error_lost_consistency_error_is_errno)            //
-             || (status_value == status::have_error_exception_lost_consistency_error_is_errno)  //
-      ;
-#else
       return (static_cast<uint16_t>(status_value) & static_cast<uint16_t>(status::have_error_is_errno)) != 0;
-#endif
     }
     constexpr bool have_moved_from() const noexcept
     {
-#if BOOST_OUTCOME_USE_CONSTEXPR_ENUM_STATUS
-#error Fixme
-#else
       return (static_cast<uint16_t>(status_value) & static_cast<uint16_t>(status::have_moved_from)) != 0;
-#endif
     }
 
     constexpr status_bitfield_type &set_have_value(bool v) noexcept
     {
-#if BOOST_OUTCOME_USE_CONSTEXPR_ENUM_STATUS
-      switch(status_value)
-      {
-      case status::none:
-        if(v)
-        {
-          status_value = status::have_value;
-        }
-        break;
-      case status::have_value:
-        if(!v)
-        {
-          status_value = status::none;
-        }
-        break;
-      case status::have_error:
-        if(v)
-        {
-          make_ub(*this);
-        }
-        break;
-      case status::have_exception:
-        if(v)
-        {
-          make_ub(*this);
-        }
-        break;
-      case status::have_error_exception:
-        if(v)
-        {
-          make_ub(*this);
-        }
-        break;
-      case status::have_value_lost_consistency:
-        if(!v)
-        {
-          status_value = status::none;
-        }
-        break;
-      case status::have_error_lost_consistency:
-        if(v)
-        {
-          make_ub(*this);
-        }
-        break;
-      case status::have_exception_lost_consistency:
-        if(v)
-        {
-          make_ub(*this);
-        }
-        break;
-      case status::have_error_exception_lost_consistency:
-        if(v)
-        {
-          make_ub(*this);
-        }
-        break;
-      case status::have_error_error_is_errno:
-        if(v)
-        {
-          make_ub(*this);
-        }
-        break;
-      case status::have_error_exception_error_is_errno:
-        if(v)
-        {
-          make_ub(*this);
-        }
-        break;
-      case status::have_error_lost_consistency_error_is_errno:
-        if(v)
-        {
-          make_ub(*this);
-        }
-        break;
-      case status::have_error_exception_lost_consistency_error_is_errno:
-        if(v)
-        {
-          make_ub(*this);
-        }
-        break;
-      }
-#else
       status_value = static_cast<status>(v ? (static_cast<uint16_t>(status_value) | static_cast<uint16_t>(status::have_value)) :
                                              (static_cast<uint16_t>(status_value) & ~static_cast<uint16_t>(status::have_value)));
-#endif
       return *this;
     }
     constexpr status_bitfield_type &set_have_error(bool v) noexcept
     {
-#if BOOST_OUTCOME_USE_CONSTEXPR_ENUM_STATUS
-      switch(status_value)
-      {
-      case status::none:
-        if(v)
-        {
-          status_value = status::have_error;
-        }
-        break;
-      case status::have_value:
-        if(v)
-        {
-          make_ub(*this);
-        }
-        break;
-      case status::have_error:
-        if(!v)
-        {
-          status_value = status::none;
-        }
-        break;
-      case status::have_exception:
-        if(v)
-        {
-          status_value = status::have_error_exception;
-        }
-        break;
-      case status::have_error_exception:
-        if(!v)
-        {
-          status_value = status::have_exception;
-        }
-        break;
-      case status::have_value_lost_consistency:
-        if(v)
-        {
-          make_ub(*this);
-        }
-        break;
-      case status::have_error_lost_consistency:
-        if(!v)
-        {
-          status_value = status::none;
-        }
-        break;
-      case status::have_exception_lost_consistency:
-        if(v)
-        {
-          status_value = status::have_error_exception_lost_consistency;
-        }
-        break;
-      case status::have_error_exception_lost_consistency:
-        if(!v)
-        {
-          status_value = status::have_exception_lost_consistency;
-        }
-        break;
-      case status::have_error_error_is_errno:
-        if(!v)
-        {
-          status_value = status::none;
-        }
-        break;
-      case status::have_error_exception_error_is_errno:
-        if(!v)
-        {
-          status_value = status::have_exception;
-        }
-        break;
-      case status::have_error_lost_consistency_error_is_errno:
-        if(!v)
-        {
-          status_value = status::none;
-        }
-        break;
-      case status::have_error_exception_lost_consistency_error_is_errno:
-        if(!v)
-        {
-          status_value = status::have_exception_lost_consistency;
-        }
-        break;
-      }
-#else
       status_value = static_cast<status>(v ? (static_cast<uint16_t>(status_value) | static_cast<uint16_t>(status::have_error)) :
                                              (static_cast<uint16_t>(status_value) & ~static_cast<uint16_t>(status::have_error)));
-#endif
       return *this;
     }
     constexpr status_bitfield_type &set_have_exception(bool v) noexcept
     {
-#if BOOST_OUTCOME_USE_CONSTEXPR_ENUM_STATUS
-      switch(status_value)
-      {
-      case status::none:
-        if(v)
-        {
-          status_value = status::have_exception;
-        }
-        break;
-      case status::have_value:
-        if(v)
-        {
-          make_ub(*this);
-        }
-        break;
-      case status::have_error:
-        if(v)
-        {
-          status_value = status::have_error_exception;
-        }
-        break;
-      case status::have_exception:
-        if(!v)
-        {
-          status_value = status::none;
-        }
-        break;
-      case status::have_error_exception:
-        if(!v)
-        {
-          status_value = status::have_error;
-        }
-        break;
-      case status::have_value_lost_consistency:
-        if(v)
-        {
-          make_ub(*this);
-        }
-        break;
-      case status::have_error_lost_consistency:
-        if(v)
-        {
-          status_value = status::have_error_exception_lost_consistency;
-        }
-        break;
-      case status::have_exception_lost_consistency:
-        if(!v)
-        {
-          status_value = status::none;
-        }
-        break;
-      case status::have_error_exception_lost_consistency:
-        if(!v)
-        {
-          status_value = status::have_error_lost_consistency;
-        }
-        break;
-      case status::have_error_error_is_errno:
-        if(v)
-        {
-          status_value = status::have_error_exception_error_is_errno;
-        }
-        break;
-      case status::have_error_exception_error_is_errno:
-        if(!v)
-        {
-          status_value = status::have_error_error_is_errno;
-        }
-        break;
-      case status::have_error_lost_consistency_error_is_errno:
-        if(v)
-        {
-          status_value = status::have_error_exception_lost_consistency_error_is_errno;
-        }
-        break;
-      case status::have_error_exception_lost_consistency_error_is_errno:
-        if(!v)
-        {
-          status_value = status::have_error_lost_consistency_error_is_errno;
-        }
-        break;
-      }
-#else
       status_value = static_cast<status>(v ? (static_cast<uint16_t>(status_value) | static_cast<uint16_t>(status::have_exception)) :
                                              (static_cast<uint16_t>(status_value) & ~static_cast<uint16_t>(status::have_exception)));
-#endif
       return *this;
     }
     constexpr status_bitfield_type &set_have_error_is_errno(bool v) noexcept
     {
-#if BOOST_OUTCOME_USE_CONSTEXPR_ENUM_STATUS
-      switch(status_value)
-      {
-      case status::none:
-        make_ub(*this);
-        break;
-      case status::have_value:
-        make_ub(*this);
-        break;
-      case status::have_error:
-        if(v)
-        {
-          status_value = status::have_error_error_is_errno;
-        }
-        break;
-      case status::have_exception:
-        make_ub(*this);
-        break;
-      case status::have_error_exception:
-        if(v)
-        {
-          status_value = status::have_error_exception_error_is_errno;
-        }
-        break;
-      case status::have_value_lost_consistency:
-        make_ub(*this);
-        break;
-      case status::have_error_lost_consistency:
-        if(v)
-        {
-          status_value = status::have_error_lost_consistency_error_is_errno;
-        }
-        break;
-      case status::have_exception_lost_consistency:
-        make_ub(*this);
-        break;
-      case status::have_error_exception_lost_consistency:
-        if(v)
-        {
-          status_value = status::have_error_exception_lost_consistency_error_is_errno;
-        }
-        break;
-      case status::have_error_error_is_errno:
-        if(!v)
-        {
-          status_value = status::have_error;
-        }
-        break;
-      case status::have_error_exception_error_is_errno:
-        if(!v)
-        {
-          status_value = status::have_error_exception;
-        }
-        break;
-      case status::have_error_lost_consistency_error_is_errno:
-        if(!v)
-        {
-          status_value = status::have_error_lost_consistency;
-        }
-        break;
-      case status::have_error_exception_lost_consistency_error_is_errno:
-        if(!v)
-        {
-          status_value = status::have_error_exception_lost_consistency;
-        }
-        break;
-      }
-#else
       status_value = static_cast<status>(v ? (static_cast<uint16_t>(status_value) | static_cast<uint16_t>(status::have_error_is_errno)) :
                                              (static_cast<uint16_t>(status_value) & ~static_cast<uint16_t>(status::have_error_is_errno)));
-#endif
       return *this;
     }
     constexpr status_bitfield_type &set_have_lost_consistency(bool v) noexcept
     {
-#if BOOST_OUTCOME_USE_CONSTEXPR_ENUM_STATUS
-      switch(status_value)
-      {
-      case status::none:
-        if(v)
-        {
-          make_ub(*this);
-        }
-        break;
-      case status::have_value:
-        if(v)
-        {
-          status_value = status::have_value_lost_consistency;
-        }
-        break;
-      case status::have_error:
-        if(v)
-        {
-          status_value = status::have_error_lost_consistency;
-        }
-        break;
-      case status::have_exception:
-        if(v)
-        {
-          status_value = status::have_exception_lost_consistency;
-        }
-        break;
-      case status::have_error_exception:
-        if(v)
-        {
-          status_value = status::have_error_exception_lost_consistency;
-        }
-        break;
-      case status::have_value_lost_consistency:
-        if(!v)
-        {
-          status_value = status::have_value;
-        }
-        break;
-      case status::have_error_lost_consistency:
-        if(!v)
-        {
-          status_value = status::have_error;
-        }
-        break;
-      case status::have_exception_lost_consistency:
-        if(!v)
-        {
-          status_value = status::have_exception;
-        }
-        break;
-      case status::have_error_exception_lost_consistency:
-        if(!v)
-        {
-          status_value = status::have_error_exception;
-        }
-        break;
-      case status::have_error_error_is_errno:
-        if(v)
-        {
-          status_value = status::have_error_lost_consistency_error_is_errno;
-        }
-        break;
-      case status::have_error_exception_error_is_errno:
-        if(v)
-        {
-          status_value = status::have_error_exception_lost_consistency_error_is_errno;
-        }
-        break;
-      case status::have_error_lost_consistency_error_is_errno:
-        if(!v)
-        {
-          status_value = status::have_error_exception_error_is_errno;
-        }
-        break;
-      case status::have_error_exception_lost_consistency_error_is_errno:
-        if(!v)
-        {
-          status_value = status::have_error_exception_error_is_errno;
-        }
-        break;
-      }
-#else
       status_value = static_cast<status>(v ? (static_cast<uint16_t>(status_value) | static_cast<uint16_t>(status::have_lost_consistency)) :
                                              (static_cast<uint16_t>(status_value) & ~static_cast<uint16_t>(status::have_lost_consistency)));
-#endif
       return *this;
     }
     constexpr status_bitfield_type &set_have_moved_from(bool v) noexcept
     {
-#if BOOST_OUTCOME_USE_CONSTEXPR_ENUM_STATUS
-#error Fixme
-#else
       status_value = static_cast<status>(v ? (static_cast<uint16_t>(status_value) | static_cast<uint16_t>(status::have_moved_from)) :
                                              (static_cast<uint16_t>(status_value) & ~static_cast<uint16_t>(status::have_moved_from)));
-#endif
       return *this;
     }
   };
 #if !defined(NDEBUG)
   // Check is trivial in all ways except default constructibility
-  static_assert(sizeof(status_bitfield_type) == 4, "status_bitfield_type is not sized 4 bytes!");
+  static_assert(sizeof(status_bitfield_type) == (BOOST_OUTCOME_SPARE_STORAGE_BITS == 0 ? 1 : (BOOST_OUTCOME_SPARE_STORAGE_BITS == 48 ? 8 : 4)),
+                "status_bitfield_type is not sized correctly!");
   static_assert(std::is_trivially_copyable<status_bitfield_type>::value, "status_bitfield_type is not trivially copyable!");
   static_assert(std::is_trivially_assignable<status_bitfield_type, status_bitfield_type>::value, "status_bitfield_type is not trivially assignable!");
   static_assert(std::is_trivially_destructible<status_bitfield_type>::value, "status_bitfield_type is not trivially destructible!");
@@ -849,13 +528,16 @@ namespace detail
 
   template <class State> constexpr inline void _set_error_is_errno(State & /*unused*/) {}
 
+  template <class T, class E> struct value_storage_nontrivial;
+  template <class T, class E> struct value_storage_niche;
+
 #ifdef _MSC_VER
 #pragma warning(push)
 #pragma warning(disable : 4127)  // conditional expression is constant
 #pragma warning(disable : 4624)  // destructor was implicitly defined as deleted
 #endif
   // Used if both T and E are trivial
-  template <class T, class E> struct value_storage_trivial
+  template <class T, class E> struct BOOST_OUTCOME_TRIVIAL_ABI value_storage_trivial
   {
     using value_type = T;
     using error_type = E;
@@ -879,6 +561,15 @@ namespace detail
       _error_type_ _error;
     };
     status_bitfield_type _status;
+
+    constexpr _value_type_ &_value_ref() noexcept { return _value; }
+    constexpr const _value_type_ &_value_ref() const noexcept { return _value; }
+    constexpr _error_type_ &_error_ref() noexcept { return _error; }
+    constexpr const _error_type_ &_error_ref() const noexcept { return _error; }
+
+    // The error shares the value's storage, so nothing else can ever live there
+    template <class X> static constexpr bool _can_share_value_storage = false;
+
     constexpr value_storage_trivial() noexcept
         : _empty{}
     {
@@ -923,6 +614,21 @@ namespace detail
     {
       _set_error_is_errno(*this);
     }
+    template <class F, class... Args>
+    constexpr value_storage_trivial(in_place_invoke_type_t<_value_type> /*unused*/, F &&f, Args &&...args) noexcept(
+    noexcept(_value_type_(static_cast<F &&>(f)(static_cast<Args &&>(args)...))))
+        : _value(static_cast<F &&>(f)(static_cast<Args &&>(args)...))
+        , _status(status::have_value)
+    {
+    }
+    template <class F, class... Args>
+    constexpr value_storage_trivial(in_place_invoke_type_t<_error_type> /*unused*/, F &&f, Args &&...args) noexcept(
+    noexcept(_error_type_(static_cast<F &&>(f)(static_cast<Args &&>(args)...))))
+        : _error(static_cast<F &&>(f)(static_cast<Args &&>(args)...))
+        , _status(status::have_error)
+    {
+      _set_error_is_errno(*this);
+    }
 
     struct nonvoid_converting_constructor_tag
     {
@@ -1005,6 +711,22 @@ namespace detail
     {
       _status = o._status;
     }
+
+    struct niche_converting_constructor_tag
+    {
+    };
+    template <class U, class V>
+    static constexpr bool enable_niche_converting_constructor =
+    std::is_void<U>::value == std::is_void<value_type>::value && std::is_void<V>::value == std::is_void<error_type>::value  //
+    && (std::is_void<U>::value || detail::is_constructible<value_type, U>) && (std::is_void<V>::value || detail::is_constructible<error_type, V>);
+    BOOST_OUTCOME_TEMPLATE(class U, class V)
+    BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(enable_niche_converting_constructor<U, V>))
+    constexpr explicit value_storage_trivial(const value_storage_niche<U, V> &o, niche_converting_constructor_tag /*unused*/ = {}) noexcept(
+    detail::is_nothrow_constructible<_value_type_, devoid<U>> &&detail::is_nothrow_constructible<_error_type_, devoid<V>>)
+        : value_storage_trivial(o._status.have_value() ? value_storage_trivial(in_place_type<value_type>, o._value_ref()) :
+                                                         value_storage_trivial(in_place_type<error_type>, o._error_ref()))
+    {
+    }
     constexpr void swap(value_storage_trivial &o) noexcept
     {
       // storage is trivial, so just use assignment
@@ -1014,10 +736,270 @@ namespace detail
     }
   };
 
+  /* The status of a value_storage_niche, which is encoded in the niche of whichever of T and E is
+  not void, and so takes no storage of its own. The void side is present exactly when the niche is.
+  That leaves no room for the other status bits, so setting those does nothing, and spare storage
+  always reads as zero. The stored type is the only member, so it is always the active one, and the
+  void side lives in the empty base.
+  */
+  template <class T, class E> struct niche_status_type : void_type
+  {
+    using _stored_type = std::conditional_t<std::is_void<T>::value, E, T>;
+    using _niche = trait::has_niche<_stored_type>;
+    static constexpr bool _niche_is_value = std::is_void<T>::value;
+
+    _stored_type _stored;
+
+    constexpr niche_status_type() noexcept
+        : _stored(_niche::make_niche())
+    {
+    }
+    template <class... Args>
+    constexpr explicit niche_status_type(in_place_type_t<void_type> /*unused*/, Args &&... /*unused*/) noexcept
+        : _stored(_niche::make_niche())
+    {
+    }
+    template <class... Args>
+    constexpr explicit niche_status_type(in_place_type_t<_stored_type> /*unused*/,
+                                         Args &&...args) noexcept(detail::is_nothrow_constructible<_stored_type, Args...>)
+        : _stored(static_cast<Args &&>(args)...)
+    {
+    }
+
+    constexpr _stored_type &_ref(in_place_type_t<_stored_type> /*unused*/) noexcept { return _stored; }
+    constexpr const _stored_type &_ref(in_place_type_t<_stored_type> /*unused*/) const noexcept { return _stored; }
+    constexpr void_type &_ref(in_place_type_t<void_type> /*unused*/) noexcept { return *this; }
+    constexpr const void_type &_ref(in_place_type_t<void_type> /*unused*/) const noexcept { return *this; }
+
+    constexpr spare_storage_type spare_storage() const noexcept { return 0; }
+    constexpr niche_status_type &set_spare_storage(spare_storage_type /*unused*/) noexcept { return *this; }
+
+    constexpr bool have_value() const noexcept { return _niche::is_niche(_stored) == _niche_is_value; }
+    constexpr bool have_error() const noexcept { return _niche::is_niche(_stored) != _niche_is_value; }
+    constexpr bool have_exception() const noexcept { return false; }
+    constexpr bool have_lost_consistency() const noexcept { return false; }
+    constexpr bool have_error_is_errno() const noexcept { return false; }
+    constexpr bool have_moved_from() const noexcept { return false; }
+
+    // Gaining the void side, or losing the stored side, can only mean the niche
+    constexpr niche_status_type &set_have_value(bool v) noexcept
+    {
+      if(v == _niche_is_value)
+      {
+        _stored = _niche::make_niche();
+      }
+      return *this;
+    }
+    constexpr niche_status_type &set_have_error(bool v) noexcept
+    {
+      if(v != _niche_is_value)
+      {
+        _stored = _niche::make_niche();
+      }
+      return *this;
+    }
+    constexpr niche_status_type &set_have_exception(bool /*unused*/) noexcept { return *this; }
+    constexpr niche_status_type &set_have_error_is_errno(bool /*unused*/) noexcept { return *this; }
+    constexpr niche_status_type &set_have_lost_consistency(bool /*unused*/) noexcept { return *this; }
+    constexpr niche_status_type &set_have_moved_from(bool /*unused*/) noexcept { return *this; }
+  };
+
+  /* Used if one of T and E is void, and the other is trivial and has opted into trait::has_niche.
+  The status lives in the niche, so the storage is exactly the size of the non-void type, and for
+  example a result of a never null pointer and void fits in a single register. A default constructed
+  storage is in its niche, so holds the void side rather than nothing.
+  */
+  template <class T, class E> struct BOOST_OUTCOME_TRIVIAL_ABI value_storage_niche
+  {
+    using value_type = T;
+    using error_type = E;
+
+    // Exactly one of T and E is void, so they can never be the same type
+    using _value_type = value_type;
+    using _error_type = error_type;
+    using _value_type_ = devoid<value_type>;
+    using _error_type_ = devoid<error_type>;
+
+    niche_status_type<value_type, error_type> _status;
+
+    constexpr _value_type_ &_value_ref() noexcept { return _status._ref(in_place_type<_value_type_>); }
+    constexpr const _value_type_ &_value_ref() const noexcept { return _status._ref(in_place_type<_value_type_>); }
+    constexpr _error_type_ &_error_ref() noexcept { return _status._ref(in_place_type<_error_type_>); }
+    constexpr const _error_type_ &_error_ref() const noexcept { return _status._ref(in_place_type<_error_type_>); }
+
+    // The niche is all the storage there is, so nothing else can ever live there
+    template <class X> static constexpr bool _can_share_value_storage = false;
+
+    constexpr value_storage_niche() noexcept = default;
+    value_storage_niche(const value_storage_niche &) = default;             // NOLINT
+    value_storage_niche(value_storage_niche &&) = default;                  // NOLINT
+    value_storage_niche &operator=(const value_storage_niche &) = default;  // NOLINT
+    value_storage_niche &operator=(value_storage_niche &&) = default;       // NOLINT
+    ~value_storage_niche() = default;
+    template <class... Args>
+    constexpr explicit value_storage_niche(in_place_type_t<_value_type> /*unused*/,
+                                           Args &&...args) noexcept(detail::is_nothrow_constructible<_value_type_, Args...>)
+        : _status(in_place_type<_value_type_>, static_cast<Args &&>(args)...)
+    {
+    }
+    template <class U, class... Args>
+    constexpr value_storage_niche(in_place_type_t<_value_type> /*unused*/, std::initializer_list<U> il,
+                                  Args &&...args) noexcept(detail::is_nothrow_constructible<_value_type_, std::initializer_list<U>, Args...>)
+        : _status(in_place_type<_value_type_>, il, static_cast<Args &&>(args)...)
+    {
+    }
+    template <class... Args>
+    constexpr explicit value_storage_niche(in_place_type_t<_error_type> /*unused*/,
+                                           Args &&...args) noexcept(detail::is_nothrow_constructible<_error_type_, Args...>)
+        : _status(in_place_type<_error_type_>, static_cast<Args &&>(args)...)
+    {
+    }
+    template <class U, class... Args>
+    constexpr value_storage_niche(in_place_type_t<_error_type> /*unused*/, std::initializer_list<U> il,
+                                  Args &&...args) noexcept(detail::is_nothrow_constructible<_error_type_, std::initializer_list<U>, Args...>)
+        : _status(in_place_type<_error_type_>, il, static_cast<Args &&>(args)...)
+    {
+    }
+    template <class F, class... Args>
+    constexpr value_storage_niche(in_place_invoke_type_t<_value_type> /*unused*/, F &&f, Args &&...args) noexcept(
+    noexcept(_value_type_(static_cast<F &&>(f)(static_cast<Args &&>(args)...))))
+        : _status(in_place_type<_value_type_>, static_cast<F &&>(f)(static_cast<Args &&>(args)...))
+    {
+    }
+    template <class F, class... Args>
+    constexpr value_storage_niche(in_place_invoke_type_t<_error_type> /*unused*/, F &&f, Args &&...args) noexcept(
+    noexcept(_error_type_(static_cast<F &&>(f)(static_cast<Args &&>(args)...))))
+        : _status(in_place_type<_error_type_>, static_cast<F &&>(f)(static_cast<Args &&>(args)...))
+    {
+    }
+
+    struct converting_constructor_tag
+    {
+    };
+    // The void side must stay void, as only it can be encoded in the niche
+    template <class U, class V>
+    static constexpr bool enable_converting_constructor =
+    !(std::is_same<U, value_type>::value && std::is_same<V, error_type>::value)  //
+    && std::is_void<U>::value == std::is_void<value_type>::value && std::is_void<V>::value == std::is_void<error_type>::value  //
+    && (std::is_void<U>::value || detail::is_constructible<value_type, U>) && (std::is_void<V>::value || detail::is_constructible<error_type, V>);
+    BOOST_OUTCOME_TEMPLATE(class U, class V)
+    BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(enable_converting_constructor<U, V>))
+    constexpr explicit value_storage_niche(const value_storage_trivial<U, V> &o, converting_constructor_tag /*unused*/ = {}) noexcept(
+    detail::is_nothrow_constructible<_value_type_, devoid<U>> &&detail::is_nothrow_constructible<_error_type_, devoid<V>>)
+        : value_storage_niche(o._status.have_value() ? value_storage_niche(in_place_type<value_type>, o._value_ref()) :
+                                                       value_storage_niche(in_place_type<error_type>, o._error_ref()))
+    {
+    }
+    BOOST_OUTCOME_TEMPLATE(class U, class V)
+    BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(enable_converting_constructor<U, V>))
+    constexpr explicit value_storage_niche(const value_storage_nontrivial<U, V> &o, converting_constructor_tag /*unused*/ = {}) noexcept(
+    detail::is_nothrow_constructible<_value_type_, devoid<U>> &&detail::is_nothrow_constructible<_error_type_, devoid<V>>)
+        : value_storage_niche(o._status.have_value() ? value_storage_niche(in_place_type<value_type>, o._value_ref()) :
+                                                       value_storage_niche(in_place_type<error_type>, o._error_ref()))
+    {
+    }
+    BOOST_OUTCOME_TEMPLATE(class U, class V)
+    BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(enable_converting_constructor<U, V>))
+    constexpr explicit value_storage_niche(value_storage_nontrivial<U, V> &&o, converting_constructor_tag /*unused*/ = {}) noexcept(
+    detail::is_nothrow_constructible<_value_type_, devoid<U>> &&detail::is_nothrow_constructible<_error_type_, devoid<V>>)
+        : value_storage_niche(o._status.have_value() ?
+                              value_storage_niche(in_place_type<value_type>, static_cast<devoid<U> &&>(o._value_ref())) :
+                              value_storage_niche(in_place_type<error_type>, static_cast<devoid<V> &&>(o._error_ref())))
+    {
+    }
+    BOOST_OUTCOME_TEMPLATE(class U, class V)
+    BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(enable_converting_constructor<U, V>))
+    constexpr explicit value_storage_niche(const value_storage_niche<U, V> &o, converting_constructor_tag /*unused*/ = {}) noexcept(
+    detail::is_nothrow_constructible<_value_type_, devoid<U>> &&detail::is_nothrow_constructible<_error_type_, devoid<V>>)
+        : value_storage_niche(o._status.have_value() ? value_storage_niche(in_place_type<value_type>, o._value_ref()) :
+                                                       value_storage_niche(in_place_type<error_type>, o._error_ref()))
+    {
+    }
+    constexpr void swap(value_storage_niche &o) noexcept
+    {
+      // storage is trivial, so just use assignment
+      auto temp = static_cast<value_storage_niche &&>(*this);
+      *this = static_cast<value_storage_niche &&>(o);
+      o = static_cast<value_storage_niche &&>(temp);
+    }
+  };
+
+  struct nontrivial_union_value_tag
+  {
+  };
+  struct nontrivial_union_error_tag
+  {
+  };
+  struct nontrivial_union_value_invoke_tag
+  {
+  };
+  struct nontrivial_union_error_invoke_tag
+  {
+  };
+  /* clang ignores [[clang::trivial_abi]] on a class with an anonymous union member of non-trivial type,
+  as such a union has deleted copy and move constructors. value_storage_nontrivial therefore keeps its
+  value and error in this named union, whose copy and move constructors and destructor do nothing, as
+  the enclosing storage constructs and destroys whichever member is live. Whether it can be passed in
+  registers then depends only on T and E.
+  */
+  template <class T, class E> union BOOST_OUTCOME_TRIVIAL_ABI nontrivial_union
+  {
+    empty_type _empty;
+    T _value;
+    E _error;
+
+    constexpr nontrivial_union() noexcept
+        : _empty{}
+    {
+    }
+    template <class... Args>
+    constexpr explicit nontrivial_union(nontrivial_union_value_tag /*unused*/, Args &&...args) noexcept(detail::is_nothrow_constructible<T, Args...>)
+        : _value(static_cast<Args &&>(args)...)  // NOLINT
+    {
+    }
+    template <class... Args>
+    constexpr explicit nontrivial_union(nontrivial_union_error_tag /*unused*/, Args &&...args) noexcept(detail::is_nothrow_constructible<E, Args...>)
+        : _error(static_cast<Args &&>(args)...)  // NOLINT
+    {
+    }
+    template <class F, class... Args>
+    constexpr nontrivial_union(nontrivial_union_value_invoke_tag /*unused*/, F &&f,
+                               Args &&...args) noexcept(noexcept(T(static_cast<F &&>(f)(static_cast<Args &&>(args)...))))
+        : _value(static_cast<F &&>(f)(static_cast<Args &&>(args)...))  // NOLINT
+    {
+    }
+    template <class F, class... Args>
+    constexpr nontrivial_union(nontrivial_union_error_invoke_tag /*unused*/, F &&f,
+                               Args &&...args) noexcept(noexcept(E(static_cast<F &&>(f)(static_cast<Args &&>(args)...))))
+        : _error(static_cast<F &&>(f)(static_cast<Args &&>(args)...))  // NOLINT
+    {
+    }
+    constexpr nontrivial_union(const nontrivial_union & /*unused*/) noexcept
+        : _empty{}
+    {
+    }
+    constexpr nontrivial_union(nontrivial_union && /*unused*/) noexcept  // NOLINT
+        : _empty{}
+    {
+    }
+    nontrivial_union &operator=(const nontrivial_union &) = default;
+    nontrivial_union &operator=(nontrivial_union &&) = default;  // NOLINT
+#if __cplusplus >= 202000L || _HAS_CXX20
+    constexpr
+#endif
+    ~nontrivial_union()
+    {
+    }
+  };
+
   /* Used if T or E is non-trivial. The additional constexpr is injected in C++ 20 to enable Outcome to
   work in constexpr evaluation contexts in C++ 20 where non-trivial constexpr destructors are now allowed.
+
+  By default value and error live in separate unions, which is the layout locked by the v2.2 ABI. If
+  BOOST_OUTCOME_OVERLAP_NONTRIVIAL_STORAGE is true, they share a single union as per value_storage_trivial,
+  as only one of them can ever be live.
   */
-  template <class T, class E> struct value_storage_nontrivial
+  template <class T, class E> struct BOOST_OUTCOME_TRIVIAL_ABI value_storage_nontrivial
   {
     using value_type = T;
     using error_type = E;
@@ -1032,23 +1014,37 @@ namespace detail
     using _value_type_ = devoid<value_type>;
     using _error_type_ = devoid<error_type>;
 
-    union
-    {
-      empty_type _empty1;
-      _value_type_ _value;
-    };
+#if BOOST_OUTCOME_OVERLAP_NONTRIVIAL_STORAGE
+    nontrivial_union<_value_type_, _error_type_> _value_union;
     status_bitfield_type _status;
-    union
-    {
-      empty_type _empty2;
-      _error_type_ _error;
-    };
+#else
+    nontrivial_union<_value_type_, empty_type> _value_union;
+    status_bitfield_type _status;
+    nontrivial_union<empty_type, _error_type_> _error_union;
+#endif
+
+    constexpr _value_type_ &_value_ref() noexcept { return _value_union._value; }
+    constexpr const _value_type_ &_value_ref() const noexcept { return _value_union._value; }
+#if BOOST_OUTCOME_OVERLAP_NONTRIVIAL_STORAGE
+    constexpr _error_type_ &_error_ref() noexcept { return _value_union._error; }
+    constexpr const _error_type_ &_error_ref() const noexcept { return _value_union._error; }
+#else
+    constexpr _error_type_ &_error_ref() noexcept { return _error_union._error; }
+    constexpr const _error_type_ &_error_ref() const noexcept { return _error_union._error; }
+#endif
+
+    /* Whether an X can be placed into the value's storage whilst no value is present. This is only
+    possible if the error has storage of its own, as it may be present at the same time as the X.
+    */
+    template <class X>
+    static constexpr bool _can_share_value_storage =
+    !BOOST_OUTCOME_OVERLAP_NONTRIVIAL_STORAGE && sizeof(X) <= sizeof(_value_type_) && alignof(X) <= alignof(_value_type_);
+    template <class X> X *_value_storage_as() noexcept { return reinterpret_cast<X *>(&_value_ref()); }              // NOLINT
+    template <class X> const X *_value_storage_as() const noexcept { return reinterpret_cast<const X *>(&_value_ref()); }  // NOLINT
 #if __cplusplus >= 202000L || _HAS_CXX20
     constexpr
 #endif
     value_storage_nontrivial() noexcept
-        : _empty1{}
-        , _empty2{}
     {
     }
     value_storage_nontrivial &operator=(const value_storage_nontrivial &) = default;  // if reaches here, copy assignment is trivial
@@ -1061,11 +1057,11 @@ namespace detail
     {
       if(o._status.have_value())
       {
-        new(&_value) _value_type_(static_cast<_value_type_ &&>(o._value));  // NOLINT
+        new(&_value_ref()) _value_type_(static_cast<_value_type_ &&>(o._value_ref()));  // NOLINT
       }
       else if(o._status.have_error())
       {
-        new(&_error) _error_type_(static_cast<_error_type_ &&>(o._error));  // NOLINT
+        new(&_error_ref()) _error_type_(static_cast<_error_type_ &&>(o._error_ref()));  // NOLINT
       }
       _status = o._status;
       o._status.set_have_moved_from(true);
@@ -1078,11 +1074,11 @@ namespace detail
     {
       if(o._status.have_value())
       {
-        new(&_value) _value_type_(o._value);  // NOLINT
+        new(&_value_ref()) _value_type_(o._value_ref());  // NOLINT
       }
       else if(o._status.have_error())
       {
-        new(&_error) _error_type_(o._error);  // NOLINT
+        new(&_error_ref()) _error_type_(o._error_ref());  // NOLINT
       }
       _status = o._status;
     }
@@ -1090,38 +1086,66 @@ namespace detail
     constexpr
 #endif
     explicit value_storage_nontrivial(status_bitfield_type status)
-        : _empty1()
-        , _status(status)
-        , _empty2()
+        : _status(status)
     {
     }
     template <class... Args>
     constexpr explicit value_storage_nontrivial(in_place_type_t<_value_type> /*unused*/,
                                                 Args &&...args) noexcept(detail::is_nothrow_constructible<_value_type_, Args...>)
-        : _value(static_cast<Args &&>(args)...)  // NOLINT
+        : _value_union(nontrivial_union_value_tag{}, static_cast<Args &&>(args)...)
         , _status(status::have_value)
     {
     }
     template <class U, class... Args>
     constexpr value_storage_nontrivial(in_place_type_t<_value_type> /*unused*/, std::initializer_list<U> il,
                                        Args &&...args) noexcept(detail::is_nothrow_constructible<_value_type_, std::initializer_list<U>, Args...>)
-        : _value(il, static_cast<Args &&>(args)...)
+        : _value_union(nontrivial_union_value_tag{}, il, static_cast<Args &&>(args)...)
         , _status(status::have_value)
     {
     }
     template <class... Args>
     constexpr explicit value_storage_nontrivial(in_place_type_t<_error_type> /*unused*/,
                                                 Args &&...args) noexcept(detail::is_nothrow_constructible<_error_type_, Args...>)
+#if BOOST_OUTCOME_OVERLAP_NONTRIVIAL_STORAGE
+        : _value_union(nontrivial_union_error_tag{}, static_cast<Args &&>(args)...)
+        , _status(status::have_error)
+#else
         : _status(status::have_error)
-        , _error(static_cast<Args &&>(args)...)  // NOLINT
+        , _error_union(nontrivial_union_error_tag{}, static_cast<Args &&>(args)...)
+#endif
     {
       _set_error_is_errno(*this);
     }
     template <class U, class... Args>
     constexpr value_storage_nontrivial(in_place_type_t<_error_type> /*unused*/, std::initializer_list<U> il,
                                        Args &&...args) noexcept(detail::is_nothrow_constructible<_error_type_, std::initializer_list<U>, Args...>)
+#if BOOST_OUTCOME_OVERLAP_NONTRIVIAL_STORAGE
+        : _value_union(nontrivial_union_error_tag{}, il, static_cast<Args &&>(args)...)
+        , _status(status::have_error)
+#else
         : _status(status::have_error)
-        , _error(il, static_cast<Args &&>(args)...)
+        , _error_union(nontrivial_union_error_tag{}, il, static_cast<Args &&>(args)...)
+#endif
+    {
+      _set_error_is_errno(*this);
+    }
+    template <class F, class... Args>
+    constexpr value_storage_nontrivial(in_place_invoke_type_t<_value_type> /*unused*/, F &&f, Args &&...args) noexcept(
+    noexcept(_value_type_(static_cast<F &&>(f)(static_cast<Args &&>(args)...))))
+        : _value_union(nontrivial_union_value_invoke_tag{}, static_cast<F &&>(f), static_cast<Args &&>(args)...)
+        , _status(status::have_value)
+    {
+    }
+    template <class F, class... Args>
+    constexpr value_storage_nontrivial(in_place_invoke_type_t<_error_type> /*unused*/, F &&f, Args &&...args) noexcept(
+    noexcept(_error_type_(static_cast<F &&>(f)(static_cast<Args &&>(args)...))))
+#if BOOST_OUTCOME_OVERLAP_NONTRIVIAL_STORAGE
+        : _value_union(nontrivial_union_error_invoke_tag{}, static_cast<F &&>(f), static_cast<Args &&>(args)...)
+        , _status(status::have_error)
+#else
+        : _status(status::have_error)
+        , _error_union(nontrivial_union_error_invoke_tag{}, static_cast<F &&>(f), static_cast<Args &&>(args)...)
+#endif
     {
       _set_error_is_errno(*this);
     }
@@ -1138,8 +1162,8 @@ namespace detail
     constexpr explicit value_storage_nontrivial(const value_storage_trivial<U, V> &o, nonvoid_converting_constructor_tag /*unused*/ = {}) noexcept(
     detail::is_nothrow_constructible<_value_type_, U> &&detail::is_nothrow_constructible<_error_type_, V>)
         : value_storage_nontrivial(o._status.have_value() ?
-                                   value_storage_nontrivial(in_place_type<value_type>, o._value) :
-                                   (o._status.have_error() ? value_storage_nontrivial(in_place_type<error_type>, o._error) : value_storage_nontrivial()))
+                                   value_storage_nontrivial(in_place_type<value_type>, o._value_ref()) :
+                                   (o._status.have_error() ? value_storage_nontrivial(in_place_type<error_type>, o._error_ref()) : value_storage_nontrivial()))
     {
       _status = o._status;
     }
@@ -1149,8 +1173,8 @@ namespace detail
     detail::is_nothrow_constructible<_value_type_, U> &&detail::is_nothrow_constructible<_error_type_, V>)
         : value_storage_nontrivial(
           o._status.have_value() ?
-          value_storage_nontrivial(in_place_type<value_type>, static_cast<U &&>(o._value)) :
-          (o._status.have_error() ? value_storage_nontrivial(in_place_type<error_type>, static_cast<V &&>(o._error)) : value_storage_nontrivial()))
+          value_storage_nontrivial(in_place_type<value_type>, static_cast<U &&>(o._value_ref())) :
+          (o._status.have_error() ? value_storage_nontrivial(in_place_type<error_type>, static_cast<V &&>(o._error_ref())) : value_storage_nontrivial()))
     {
       _status = o._status;
     }
@@ -1159,8 +1183,8 @@ namespace detail
     constexpr explicit value_storage_nontrivial(const value_storage_nontrivial<U, V> &o, nonvoid_converting_constructor_tag /*unused*/ = {}) noexcept(
     detail::is_nothrow_constructible<_value_type_, U> &&detail::is_nothrow_constructible<_error_type_, V>)
         : value_storage_nontrivial(o._status.have_value() ?
-                                   value_storage_nontrivial(in_place_type<value_type>, o._value) :
-                                   (o._status.have_error() ? value_storage_nontrivial(in_place_type<error_type>, o._error) : value_storage_nontrivial()))
+                                   value_storage_nontrivial(in_place_type<value_type>, o._value_ref()) :
+                                   (o._status.have_error() ? value_storage_nontrivial(in_place_type<error_type>, o._error_ref()) : value_storage_nontrivial()))
     {
       _status = o._status;
     }
@@ -1170,8 +1194,8 @@ namespace detail
     detail::is_nothrow_constructible<_value_type_, U> &&detail::is_nothrow_constructible<_error_type_, V>)
         : value_storage_nontrivial(
           o._status.have_value() ?
-          value_storage_nontrivial(in_place_type<value_type>, static_cast<U &&>(o._value)) :
-          (o._status.have_error() ? value_storage_nontrivial(in_place_type<error_type>, static_cast<V &&>(o._error)) : value_storage_nontrivial()))
+          value_storage_nontrivial(in_place_type<value_type>, static_cast<U &&>(o._value_ref())) :
+          (o._status.have_error() ? value_storage_nontrivial(in_place_type<error_type>, static_cast<V &&>(o._error_ref())) : value_storage_nontrivial()))
     {
       _status = o._status;
     }
@@ -1188,11 +1212,11 @@ namespace detail
     {
       if(o._status.have_value())
       {
-        new(&_value) _value_type_();  // NOLINT
+        new(&_value_ref()) _value_type_();  // NOLINT
       }
       else if(o._status.have_error())
       {
-        new(&_error) _error_type_(o._error);  // NOLINT
+        new(&_error_ref()) _error_type_(o._error_ref());  // NOLINT
       }
       _status = o._status;
     }
@@ -1203,11 +1227,11 @@ namespace detail
     {
       if(o._status.have_value())
       {
-        new(&_value) _value_type_();  // NOLINT
+        new(&_value_ref()) _value_type_();  // NOLINT
       }
       else if(o._status.have_error())
       {
-        new(&_error) _error_type_(static_cast<_error_type_ &&>(o._error));  // NOLINT
+        new(&_error_ref()) _error_type_(static_cast<_error_type_ &&>(o._error_ref()));  // NOLINT
       }
       _status = o._status;
       o._status.set_have_moved_from(true);
@@ -1225,11 +1249,11 @@ namespace detail
     {
       if(o._status.have_value())
       {
-        new(&_value) _value_type_(o._value);  // NOLINT
+        new(&_value_ref()) _value_type_(o._value_ref());  // NOLINT
       }
       else if(o._status.have_error())
       {
-        new(&_error) _error_type_();  // NOLINT
+        new(&_error_ref()) _error_type_();  // NOLINT
       }
       _status = o._status;
     }
@@ -1240,16 +1264,32 @@ namespace detail
     {
       if(o._status.have_value())
       {
-        new(&_value) _value_type_(static_cast<_value_type_ &&>(o._value));  // NOLINT
+        new(&_value_ref()) _value_type_(static_cast<_value_type_ &&>(o._value_ref()));  // NOLINT
       }
       else if(o._status.have_error())
       {
-        new(&_error) _error_type_();  // NOLINT
+        new(&_error_ref()) _error_type_();  // NOLINT
       }
       _status = o._status;
       o._status.set_have_moved_from(true);
     }
 
+    struct niche_converting_constructor_tag
+    {
+    };
+    template <class U, class V>
+    static constexpr bool enable_niche_converting_constructor =
+    std::is_void<U>::value == std::is_void<value_type>::value && std::is_void<V>::value == std::is_void<error_type>::value  //
+    && (std::is_void<U>::value || detail::is_constructible<value_type, U>) && (std::is_void<V>::value || detail::is_constructible<error_type, V>);
+    BOOST_OUTCOME_TEMPLATE(class U, class V)
+    BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(enable_niche_converting_constructor<U, V>))
+    constexpr explicit value_storage_nontrivial(const value_storage_niche<U, V> &o, niche_converting_constructor_tag /*unused*/ = {}) noexcept(
+    detail::is_nothrow_constructible<_value_type_, devoid<U>> &&detail::is_nothrow_constructible<_error_type_, devoid<V>>)
+        : value_storage_nontrivial(o._status.have_value() ? value_storage_nontrivial(in_place_type<value_type>, o._value_ref()) :
+                                                            value_storage_nontrivial(in_place_type<error_type>, o._error_ref()))
+    {
+    }
+
 #if __cplusplus >= 202000L || _HAS_CXX20
     constexpr
 #endif
@@ -1259,7 +1299,7 @@ namespace detail
       {
         if(!trait::is_move_bitcopying<value_type>::value || !this->_status.have_moved_from())
         {
-          this->_value.~_value_type_();  // NOLINT
+          this->_value_ref().~_value_type_();  // NOLINT
         }
         this->_status.set_have_value(false);
       }
@@ -1267,18 +1307,114 @@ namespace detail
       {
         if(!trait::is_move_bitcopying<error_type>::value || !this->_status.have_moved_from())
         {
-          this->_error.~_error_type_();  // NOLINT
+          this->_error_ref().~_error_type_();  // NOLINT
         }
         this->_status.set_have_error(false);
       }
     }
+#if BOOST_OUTCOME_OVERLAP_NONTRIVIAL_STORAGE
+    /* Value and error share storage, so the value of `v` is parked in a temporary whilst the error of `e`
+    moves across. Should a move throw, whatever was moved is put back, destroying whatever occupies its
+    storage first. `all_good` becomes false only if putting back also throws.
+    */
+#if __cplusplus >= 202000L || _HAS_CXX20
+    constexpr
+#endif
+    static void _swap_value_with_error(bool &all_good, value_storage_nontrivial &v, value_storage_nontrivial &e)
+    {
+      struct _temp_
+      {
+        union
+        {
+          empty_type _empty;
+          _value_type_ _value;
+        };
+        constexpr _temp_() noexcept
+            : _empty{}
+        {
+        }
+#if __cplusplus >= 202000L || _HAS_CXX20
+        constexpr
+#endif
+        ~_temp_()
+        {
+        }
+      } temp;
+      new(&temp._value) _value_type_(static_cast<_value_type_ &&>(v._value_ref()));  // NOLINT
+      v._value_ref().~_value_type_();
+#ifndef BOOST_NO_EXCEPTIONS
+      try
+#endif
+      {
+        new(&v._error_ref()) _error_type_(static_cast<_error_type_ &&>(e._error_ref()));  // NOLINT
+      }
+#ifndef BOOST_NO_EXCEPTIONS
+      catch(...)
+      {
+        try
+        {
+          new(&v._value_ref()) _value_type_(static_cast<_value_type_ &&>(temp._value));  // NOLINT
+        }
+        catch(...)
+        {
+          all_good = false;
+        }
+        temp._value.~_value_type_();
+        throw;
+      }
+#endif
+      e._error_ref().~_error_type_();
+#ifndef BOOST_NO_EXCEPTIONS
+      try
+#endif
+      {
+        new(&e._value_ref()) _value_type_(static_cast<_value_type_ &&>(temp._value));  // NOLINT
+      }
+#ifndef BOOST_NO_EXCEPTIONS
+      catch(...)
+      {
+        try
+        {
+          new(&e._error_ref()) _error_type_(static_cast<_error_type_ &&>(v._error_ref()));  // NOLINT
+          v._error_ref().~_error_type_();
+          new(&v._value_ref()) _value_type_(static_cast<_value_type_ &&>(temp._value));  // NOLINT
+        }
+        catch(...)
+        {
+          all_good = false;
+        }
+        temp._value.~_value_type_();
+        throw;
+      }
+#endif
+      temp._value.~_value_type_();
+    }
+#endif
 #if __cplusplus >= 202000L || _HAS_CXX20
     constexpr
 #endif
     void
-    swap(value_storage_nontrivial &o) noexcept(detail::is_nothrow_swappable<_value_type_>::value &&detail::is_nothrow_swappable<_error_type_>::value)
+    swap(value_storage_nontrivial &o) noexcept(is_bitwise_swappable<value_type, error_type>::value ||
+                                               (detail::is_nothrow_swappable<_value_type_>::value && detail::is_nothrow_swappable<_error_type_>::value))
     {
       using std::swap;
+      // Relocating trivially relocatable payloads cannot fail, so just exchange the bytes of both unions
+      if(is_bitwise_swappable<value_type, error_type>::value
+#if __cpp_lib_is_constant_evaluated >= 201811L
+         && !std::is_constant_evaluated()
+#endif
+      )
+      {
+#if BOOST_OUTCOME_OVERLAP_NONTRIVIAL_STORAGE
+        swap_bytes(&_value_union, _status.have_value() ? sizeof(_value_type_) : (_status.have_error() ? sizeof(_error_type_) : 0),  //
+                   &o._value_union, o._status.have_value() ? sizeof(_value_type_) : (o._status.have_error() ? sizeof(_error_type_) : 0));
+#else
+        swap_bytes(&_value_ref(), _status.have_value() ? sizeof(_value_type_) : 0, &o._value_ref(), o._status.have_value() ? sizeof(_value_type_) : 0);
+        swap_bytes(&_error_ref(), _status.have_error() ? sizeof(_error_type_) : 0, &o._error_ref(), o._status.have_error() ? sizeof(_error_type_) : 0);
+#endif
+        swap(_status, o._status);
+        return;
+      }
       // empty/empty
       if(!_status.have_value() && !o._status.have_value() && !_status.have_error() && !o._status.have_error())
       {
@@ -1302,7 +1438,7 @@ namespace detail
             }
           }
         } _{_status, o._status};
-        strong_swap(_.all_good, _value, o._value);
+        strong_swap(_.all_good, _value_ref(), o._value_ref());
         swap(_status, o._status);
         return;
       }
@@ -1323,7 +1459,7 @@ namespace detail
             }
           }
         } _{_status, o._status};
-        strong_swap(_.all_good, _error, o._error);
+        strong_swap(_.all_good, _error_ref(), o._error_ref());
         swap(_status, o._status);
         return;
       }
@@ -1331,10 +1467,10 @@ namespace detail
       if(_status.have_value() && !o._status.have_error())
       {
         // Move construct me into other
-        new(&o._value) _value_type_(static_cast<_value_type_ &&>(_value));  // NOLINT
+        new(&o._value_ref()) _value_type_(static_cast<_value_type_ &&>(_value_ref()));  // NOLINT
         if(!trait::is_move_bitcopying<value_type>::value)
         {
-          this->_value.~value_type();  // NOLINT
+          this->_value_ref().~value_type();  // NOLINT
         }
         swap(_status, o._status);
         return;
@@ -1342,10 +1478,10 @@ namespace detail
       if(o._status.have_value() && !_status.have_error())
       {
         // Move construct other into me
-        new(&_value) _value_type_(static_cast<_value_type_ &&>(o._value));  // NOLINT
+        new(&_value_ref()) _value_type_(static_cast<_value_type_ &&>(o._value_ref()));  // NOLINT
         if(!trait::is_move_bitcopying<value_type>::value)
         {
-          o._value.~value_type();  // NOLINT
+          o._value_ref().~value_type();  // NOLINT
         }
         swap(_status, o._status);
         return;
@@ -1353,10 +1489,10 @@ namespace detail
       if(_status.have_error() && !o._status.have_value())
       {
         // Move construct me into other
-        new(&o._error) _error_type_(static_cast<_error_type_ &&>(_error));  // NOLINT
+        new(&o._error_ref()) _error_type_(static_cast<_error_type_ &&>(_error_ref()));  // NOLINT
         if(!trait::is_move_bitcopying<error_type>::value)
         {
-          this->_error.~error_type();  // NOLINT
+          this->_error_ref().~error_type();  // NOLINT
         }
         swap(_status, o._status);
         return;
@@ -1364,10 +1500,10 @@ namespace detail
       if(o._status.have_error() && !_status.have_value())
       {
         // Move construct other into me
-        new(&_error) _error_type_(static_cast<_error_type_ &&>(o._error));  // NOLINT
+        new(&_error_ref()) _error_type_(static_cast<_error_type_ &&>(o._error_ref()));  // NOLINT
         if(!trait::is_move_bitcopying<error_type>::value)
         {
-          o._error.~error_type();  // NOLINT
+          o._error_ref().~error_type();  // NOLINT
         }
         swap(_status, o._status);
         return;
@@ -1388,7 +1524,21 @@ namespace detail
             b.set_have_lost_consistency(true);
           }
         }
-      } _{_status, o._status, &_value, &o._value, &_error, &o._error};
+      } _{_status, o._status, &_value_ref(), &o._value_ref(), &_error_ref(), &o._error_ref()};
+#if BOOST_OUTCOME_OVERLAP_NONTRIVIAL_STORAGE
+      if(_status.have_value() && o._status.have_error())
+      {
+        _swap_value_with_error(_.all_good, *this, o);
+        swap(_status, o._status);
+        return;
+      }
+      if(_status.have_error() && o._status.have_value())
+      {
+        _swap_value_with_error(_.all_good, o, *this);
+        swap(_status, o._status);
+        return;
+      }
+#else
       if(_status.have_value() && o._status.have_error())
       {
         strong_placement(_.all_good, _.o_value, _.value, [&_] {    //
@@ -1407,11 +1557,12 @@ namespace detail
         });
         return;
       }
+#endif
       // Should never reach here
-      make_ub(_value);
+      make_ub(_value_ref());
     }
   };
-  template <class Base> struct value_storage_delete_copy_constructor : Base  // NOLINT
+  template <class Base> struct BOOST_OUTCOME_TRIVIAL_ABI value_storage_delete_copy_constructor : Base  // NOLINT
   {
     using Base::Base;
     using value_type = typename Base::value_type;
@@ -1423,7 +1574,7 @@ namespace detail
     value_storage_delete_copy_constructor &operator=(value_storage_delete_copy_constructor &&o) = default;  // NOLINT
     ~value_storage_delete_copy_constructor() = default;
   };
-  template <class Base> struct value_storage_delete_copy_assignment : Base  // NOLINT
+  template <class Base> struct BOOST_OUTCOME_TRIVIAL_ABI value_storage_delete_copy_assignment : Base  // NOLINT
   {
     using Base::Base;
     using value_type = typename Base::value_type;
@@ -1435,7 +1586,7 @@ namespace detail
     value_storage_delete_copy_assignment &operator=(value_storage_delete_copy_assignment &&o) = default;  // NOLINT
     ~value_storage_delete_copy_assignment() = default;
   };
-  template <class Base> struct value_storage_delete_move_assignment : Base  // NOLINT
+  template <class Base> struct BOOST_OUTCOME_TRIVIAL_ABI value_storage_delete_move_assignment : Base  // NOLINT
   {
     using Base::Base;
     using value_type = typename Base::value_type;
@@ -1447,7 +1598,7 @@ namespace detail
     value_storage_delete_move_assignment &operator=(value_storage_delete_move_assignment &&o) = delete;
     ~value_storage_delete_move_assignment() = default;
   };
-  template <class Base> struct value_storage_delete_move_constructor : Base  // NOLINT
+  template <class Base> struct BOOST_OUTCOME_TRIVIAL_ABI value_storage_delete_move_constructor : Base  // NOLINT
   {
     using Base::Base;
     using value_type = typename Base::value_type;
@@ -1459,7 +1610,7 @@ namespace detail
     value_storage_delete_move_constructor &operator=(value_storage_delete_move_constructor &&o) = default;
     ~value_storage_delete_move_constructor() = default;
   };
-  template <class Base> struct value_storage_nontrivial_move_assignment : Base  // NOLINT
+  template <class Base> struct BOOST_OUTCOME_TRIVIAL_ABI value_storage_nontrivial_move_assignment : Base  // NOLINT
   {
     using Base::Base;
     using value_type = typename Base::value_type;
@@ -1489,14 +1640,14 @@ namespace detail
       }
       if(this->_status.have_value() && o._status.have_value())
       {
-        this->_value = static_cast<_value_type_ &&>(o._value);  // NOLINT
+        this->_value_ref() = static_cast<_value_type_ &&>(o._value_ref());  // NOLINT
         this->_status = o._status;
         o._status.set_have_moved_from(true);
         return *this;
       }
       if(this->_status.have_error() && o._status.have_error())
       {
-        this->_error = static_cast<_error_type_ &&>(o._error);  // NOLINT
+        this->_error_ref() = static_cast<_error_type_ &&>(o._error_ref());  // NOLINT
         this->_status = o._status;
         o._status.set_have_moved_from(true);
         return *this;
@@ -1505,7 +1656,7 @@ namespace detail
       {
         if(!trait::is_move_bitcopying<value_type>::value || this->_status.have_moved_from())
         {
-          this->_value.~_value_type_();  // NOLINT
+          this->_value_ref().~_value_type_();  // NOLINT
         }
         this->_status = o._status;
         o._status.set_have_moved_from(true);
@@ -1513,7 +1664,7 @@ namespace detail
       }
       if(!this->_status.have_value() && !this->_status.have_error() && o._status.have_value())
       {
-        move_assign_to_empty<_value_type_>(&this->_value, &o._value);
+        move_assign_to_empty<_value_type_>(&this->_value_ref(), &o._value_ref());
         this->_status = o._status;
         o._status.set_have_moved_from(true);
         return *this;
@@ -1522,7 +1673,7 @@ namespace detail
       {
         if(!trait::is_move_bitcopying<error_type>::value || this->_status.have_moved_from())
         {
-          this->_error.~_error_type_();  // NOLINT
+          this->_error_ref().~_error_type_();  // NOLINT
         }
         this->_status = o._status;
         o._status.set_have_moved_from(true);
@@ -1530,7 +1681,7 @@ namespace detail
       }
       if(!this->_status.have_value() && !this->_status.have_error() && o._status.have_error())
       {
-        move_assign_to_empty<_error_type_>(&this->_error, &o._error);
+        move_assign_to_empty<_error_type_>(&this->_error_ref(), &o._error_ref());
         this->_status = o._status;
         o._status.set_have_moved_from(true);
         return *this;
@@ -1539,9 +1690,9 @@ namespace detail
       {
         if(!trait::is_move_bitcopying<value_type>::value || this->_status.have_moved_from())
         {
-          this->_value.~_value_type_();  // NOLINT
+          this->_value_ref().~_value_type_();  // NOLINT
         }
-        move_assign_to_empty<_error_type_>(&this->_error, &o._error);
+        move_assign_to_empty<_error_type_>(&this->_error_ref(), &o._error_ref());
         this->_status = o._status;
         o._status.set_have_moved_from(true);
         return *this;
@@ -1550,18 +1701,18 @@ namespace detail
       {
         if(!trait::is_move_bitcopying<error_type>::value || this->_status.have_moved_from())
         {
-          this->_error.~_error_type_();  // NOLINT
+          this->_error_ref().~_error_type_();  // NOLINT
         }
-        move_assign_to_empty<_value_type_>(&this->_value, &o._value);
+        move_assign_to_empty<_value_type_>(&this->_value_ref(), &o._value_ref());
         this->_status = o._status;
         o._status.set_have_moved_from(true);
         return *this;
       }
       // Should never reach here
-      make_ub(this->_value);
+      make_ub(this->_value_ref());
     }
   };
-  template <class Base> struct value_storage_nontrivial_copy_assignment : Base  // NOLINT
+  template <class Base> struct BOOST_OUTCOME_TRIVIAL_ABI value_storage_nontrivial_copy_assignment : Base  // NOLINT
   {
     using Base::Base;
     using value_type = typename Base::value_type;
@@ -1589,13 +1740,13 @@ namespace detail
       }
       if(this->_status.have_value() && o._status.have_value())
       {
-        this->_value = o._value;  // NOLINT
+        this->_value_ref() = o._value_ref();  // NOLINT
         this->_status = o._status;
         return *this;
       }
       if(this->_status.have_error() && o._status.have_error())
       {
-        this->_error = o._error;  // NOLINT
+        this->_error_ref() = o._error_ref();  // NOLINT
         this->_status = o._status;
         return *this;
       }
@@ -1603,14 +1754,14 @@ namespace detail
       {
         if(!trait::is_move_bitcopying<value_type>::value || this->_status.have_moved_from())
         {
-          this->_value.~_value_type_();  // NOLINT
+          this->_value_ref().~_value_type_();  // NOLINT
         }
         this->_status = o._status;
         return *this;
       }
       if(!this->_status.have_value() && !this->_status.have_error() && o._status.have_value())
       {
-        copy_assign_to_empty<_value_type_>(&this->_value, &o._value);
+        copy_assign_to_empty<_value_type_>(&this->_value_ref(), &o._value_ref());
         this->_status = o._status;
         return *this;
       }
@@ -1618,14 +1769,14 @@ namespace detail
       {
         if(!trait::is_move_bitcopying<error_type>::value || this->_status.have_moved_from())
         {
-          this->_error.~_error_type_();  // NOLINT
+          this->_error_ref().~_error_type_();  // NOLINT
         }
         this->_status = o._status;
         return *this;
       }
       if(!this->_status.have_value() && !this->_status.have_error() && o._status.have_error())
       {
-        copy_assign_to_empty<_error_type_>(&this->_error, &o._error);
+        copy_assign_to_empty<_error_type_>(&this->_error_ref(), &o._error_ref());
         this->_status = o._status;
         return *this;
       }
@@ -1633,9 +1784,9 @@ namespace detail
       {
         if(!trait::is_move_bitcopying<value_type>::value || this->_status.have_moved_from())
         {
-          this->_value.~_value_type_();  // NOLINT
+          this->_value_ref().~_value_type_();  // NOLINT
         }
-        copy_assign_to_empty<_error_type_>(&this->_error, &o._error);
+        copy_assign_to_empty<_error_type_>(&this->_error_ref(), &o._error_ref());
         this->_status = o._status;
         return *this;
       }
@@ -1643,14 +1794,14 @@ namespace detail
       {
         if(!trait::is_move_bitcopying<error_type>::value || this->_status.have_moved_from())
         {
-          this->_error.~_error_type_();  // NOLINT
+          this->_error_ref().~_error_type_();  // NOLINT
         }
-        copy_assign_to_empty<_value_type_>(&this->_value, &o._value);
+        copy_assign_to_empty<_value_type_>(&this->_value_ref(), &o._value_ref());
         this->_status = o._status;
         return *this;
       }
       // Should never reach here
-      make_ub(this->_value);
+      make_ub(this->_value_ref());
     }
   };
 #ifdef _MSC_VER
@@ -1682,9 +1833,18 @@ namespace detail
     static constexpr bool value = std::is_move_assignable<T>::value && (std::is_move_constructible<T>::value || std::is_default_constructible<T>::value);
   };
 
+  // Whether exactly one of T and E is void, and the other is trivial with a niche to encode the status in
+  template <class T, class E, class X = std::conditional_t<std::is_void<T>::value, E, T>>
+  struct is_niche_storable
+      : std::integral_constant<bool, std::is_void<T>::value != std::is_void<E>::value && trait::has_niche<X>::value && is_storage_trivial<X>::value>
+  {
+  };
+
   template <class T, class E>
   using value_storage_select_trivality =
-  std::conditional_t<is_storage_trivial<T>::value && is_storage_trivial<E>::value, value_storage_trivial<T, E>, value_storage_nontrivial<T, E>>;
+  std::conditional_t<is_niche_storable<T, E>::value, value_storage_niche<T, E>,
+                     std::conditional_t<is_storage_trivial<T>::value && is_storage_trivial<E>::value, value_storage_trivial<T, E>,
+                                        value_storage_nontrivial<T, E>>>;
   template <class T, class E>
   using value_storage_select_move_constructor =
   std::conditional_t<std::is_move_constructible<devoid<T>>::value && std::is_move_constructible<devoid<E>>::value, value_storage_select_trivality<T, E>,
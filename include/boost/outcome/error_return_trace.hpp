@@ -0,0 +1,182 @@
+/* Recording the path taken by failures through BOOST_OUTCOME_TRY
+(C) 2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2024
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef BOOST_OUTCOME_ERROR_RETURN_TRACE_HPP
+#define BOOST_OUTCOME_ERROR_RETURN_TRACE_HPP
+
+#include "detail/basic_result_storage.hpp"
+
+#include <atomic>
+
+#if BOOST_OUTCOME_SPARE_STORAGE_BITS == 0
+#error Error return tracing keeps the trace of each failure in its spare storage, so BOOST_OUTCOME_SPARE_STORAGE_BITS cannot be 0
+#endif
+
+#ifndef BOOST_OUTCOME_ERROR_RETURN_TRACE_DEPTH
+#define BOOST_OUTCOME_ERROR_RETURN_TRACE_DEPTH 32
+#endif
+
+BOOST_OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+type definition error_return_trace_site. Potential doc page: `error_return_trace`
+*/
+struct error_return_trace_site
+{
+  //! The `__FILE__` of the `BOOST_OUTCOME_TRY` which returned the failure
+  const char *file;
+  //! The `__LINE__` of the `BOOST_OUTCOME_TRY` which returned the failure
+  unsigned line;
+};
+
+namespace detail
+{
+  static_assert(BOOST_OUTCOME_ERROR_RETURN_TRACE_DEPTH > 0 && BOOST_OUTCOME_ERROR_RETURN_TRACE_DEPTH < 65536,
+                "BOOST_OUTCOME_ERROR_RETURN_TRACE_DEPTH must be between 1 and 65535");
+
+  /* Each thread records the sites which returned failures into a ring buffer. Each record
+  has a sixteen bit id, never zero, which is placed into the spare storage of the failure
+  returned so the next site up can link to it. Threads take their ids in blocks from a shared
+  counter, so an id looked up upon another thread is never found there until all 65535 have
+  been handed out. Ids are reused after that, and the slots after
+  BOOST_OUTCOME_ERROR_RETURN_TRACE_DEPTH records, so links are followed only whilst the slot
+  still holds the id linked to.
+  */
+  struct error_return_trace_record
+  {
+    error_return_trace_site site{nullptr, 0};
+    uint16_t id{0}, prev{0};
+  };
+  struct error_return_trace_ring
+  {
+    error_return_trace_record records[BOOST_OUTCOME_ERROR_RETURN_TRACE_DEPTH];
+    uint16_t last_id{0}, block_end{0};
+  };
+  static constexpr uint16_t error_return_trace_id_block = 256;
+  inline std::atomic<uint16_t> &error_return_trace_next_block() noexcept
+  {
+    static std::atomic<uint16_t> next{0};
+    return next;
+  }
+  inline error_return_trace_ring &error_return_trace_ring_instance() noexcept
+  {
+    static thread_local error_return_trace_ring ring;
+    return ring;
+  }
+  inline uint16_t record_error_return_site(spare_storage_type prev, const char *file, unsigned line) noexcept
+  {
+    auto &ring = error_return_trace_ring_instance();
+    uint16_t id = static_cast<uint16_t>(ring.last_id + 1);
+    if(ring.last_id == ring.block_end)
+    {
+      id = error_return_trace_next_block().fetch_add(error_return_trace_id_block, std::memory_order_relaxed);
+      ring.block_end = static_cast<uint16_t>(id + error_return_trace_id_block - 1);
+      if(id == 0)
+      {
+        id = 1;
+      }
+    }
+    ring.last_id = id;
+    auto &record = ring.records[id % BOOST_OUTCOME_ERROR_RETURN_TRACE_DEPTH];
+    record.site = {file, line};
+    record.id = id;
+    record.prev = static_cast<uint16_t>(prev);
+    return id;
+  }
+
+  // Failures which can carry spare storage are linked to the trace they came with
+  template <class T>
+  inline auto _record_error_return(T &f, const char *file, unsigned line, int /*unused*/) noexcept -> decltype(f.set_spare_storage(f.spare_storage()), void())
+  {
+    f.set_spare_storage(record_error_return_site(f.spare_storage(), file, line));
+  }
+  template <class T> inline void _record_error_return(T & /*unused*/, const char *file, unsigned line, ...) noexcept { record_error_return_site(0, file, line); }
+  template <class T> inline void record_error_return(T &f, const char *file, unsigned line) noexcept { _record_error_return(f, file, line, 5); }
+
+  template <class T> constexpr inline auto error_return_trace_id(const T &v, int /*unused*/) noexcept -> decltype(v.spare_storage()) { return v.spare_storage(); }
+  template <class T> constexpr inline auto error_return_trace_id(const T &v, ...) noexcept -> decltype(hooks::spare_storage(&v)) { return hooks::spare_storage(&v); }
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+type definition error_return_trace. Potential doc page: `error_return_trace`
+*/
+class error_return_trace
+{
+  error_return_trace_site _sites[BOOST_OUTCOME_ERROR_RETURN_TRACE_DEPTH];
+  size_t _size{0};
+
+public:
+  using value_type = error_return_trace_site;
+  using size_type = size_t;
+  using const_reference = const error_return_trace_site &;
+  using const_iterator = const error_return_trace_site *;
+
+  //! Constructs an empty trace.
+  error_return_trace() noexcept = default;
+  //! Constructs the trace ending with the record `id` made by this thread, innermost site first.
+  explicit error_return_trace(spare_storage_type id) noexcept
+  {
+    const auto &ring = detail::error_return_trace_ring_instance();
+    while(id != 0 && _size < BOOST_OUTCOME_ERROR_RETURN_TRACE_DEPTH)
+    {
+      const auto &record = ring.records[id % BOOST_OUTCOME_ERROR_RETURN_TRACE_DEPTH];
+      if(record.id != id)
+      {
+        break;  // overwritten since, or recorded by another thread
+      }
+      _sites[_size++] = record.site;
+      id = record.prev;
+    }
+    for(size_t n = 0; n < _size / 2; n++)
+    {
+      const auto site = _sites[n];
+      _sites[n] = _sites[_size - 1 - n];
+      _sites[_size - 1 - n] = site;
+    }
+  }
+
+  bool empty() const noexcept { return _size == 0; }
+  size_type size() const noexcept { return _size; }
+  const_iterator begin() const noexcept { return _sites; }
+  const_iterator end() const noexcept { return _sites + _size; }
+  const_reference operator[](size_type idx) const noexcept { return _sites[idx]; }
+};
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T> inline error_return_trace error_return_trace_of(const T &v) noexcept
+{
+  return error_return_trace(detail::error_return_trace_id(v, 5));
+}
+
+BOOST_OUTCOME_V2_NAMESPACE_END
+
+#endif
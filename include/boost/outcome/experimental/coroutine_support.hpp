@@ -50,6 +50,21 @@ DEALINGS IN THE SOFTWARE.
   }                                                                                                                                                                                                                                                                                                                            \
   BOOST_OUTCOME_V2_NAMESPACE_END
 
+#include "status-code/generic_code.hpp"
+BOOST_OUTCOME_V2_NAMESPACE_BEGIN
+namespace awaitables
+{
+  namespace detail
+  {
+    template <class E, std::enable_if_t<std::is_constructible<E, BOOST_OUTCOME_SYSTEM_ERROR2_NAMESPACE::generic_code>::value, bool> = true>
+    inline BOOST_OUTCOME_SYSTEM_ERROR2_NAMESPACE::generic_code operation_canceled_error(const E * /*unused*/, int /*unused*/) noexcept
+    {
+      return BOOST_OUTCOME_SYSTEM_ERROR2_NAMESPACE::errc::operation_canceled;
+    }
+  }  // namespace detail
+}  // namespace awaitables
+BOOST_OUTCOME_V2_NAMESPACE_END
+
 #ifndef BOOST_NO_EXCEPTIONS
 #include "status-code/system_code_from_exception.hpp"
 BOOST_OUTCOME_V2_NAMESPACE_BEGIN
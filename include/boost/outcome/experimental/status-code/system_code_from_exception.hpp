@@ -35,120 +35,429 @@ DEALINGS IN THE SOFTWARE.
 
 #include "status_error.hpp"
 
+#include "../../detail/per_thread_cache.hpp"
+
+#include <atomic>
 #include <exception>     // for exception_ptr
+#include <mutex>
 #include <stdexcept>     // for the exception types
 #include <system_error>  // for std::system_error
+#include <typeinfo>
+
+#ifndef BOOST_OUTCOME_SYSTEM_ERROR2_SYSTEM_CODE_FROM_EXCEPTION_USE_TYPE_DISPATCH
+#if defined(__GLIBCXX__) && (defined(__GXX_RTTI) || defined(__cpp_rtti))
+#define BOOST_OUTCOME_SYSTEM_ERROR2_SYSTEM_CODE_FROM_EXCEPTION_USE_TYPE_DISPATCH 1
+#else
+#define BOOST_OUTCOME_SYSTEM_ERROR2_SYSTEM_CODE_FROM_EXCEPTION_USE_TYPE_DISPATCH 0
+#endif
+#endif
 
 BOOST_OUTCOME_SYSTEM_ERROR2_NAMESPACE_BEGIN
 
-/*! A utility function which returns the closest matching system_code to a supplied
-exception ptr.
-*/
-inline system_code system_code_from_exception(std::exception_ptr &&ep = std::current_exception(), system_code not_matched = generic_code(errc::resource_unavailable_try_again)) noexcept
+namespace detail
 {
-  if(!ep)
+  enum class system_code_from_exception_status
   {
-    return generic_code(errc::success);
-  }
-  try
+    not_handled,  // try the next mapper
+    handled,      // the exception was converted
+    consumed      // the exception was consumed, but has no equivalent code
+  };
+
+  inline system_code_from_exception_status system_code_from_status_error(const status_error<void> &e, system_code &out) noexcept
   {
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
     try
     {
-      std::rethrow_exception(ep);
+      out = system_code(e.code());
+    }
+    catch(...)
+    {
+      // Source status code's do_erased_copy() routine refused to copy the original
+      // Process instead as if the source were not a status_error
+      return system_code_from_exception_status::not_handled;
     }
-    catch(const status_error<void> &e)
+#else
+    out = system_code(e.code());
+#endif
+    return out.empty() ? system_code_from_exception_status::not_handled : system_code_from_exception_status::handled;
+  }
+  inline system_code_from_exception_status system_code_from_std_system_error(const std::system_error &e, system_code &out) noexcept
+  {
+    if(e.code().category() == std::generic_category())
     {
+      out = generic_code(static_cast<errc>(static_cast<int>(e.code().value())));
+      return system_code_from_exception_status::handled;
+    }
+    if(e.code().category() == std::system_category())
+    {
+#ifdef _WIN32
+      out = win32_code(e.code().value());
+#else
+#ifndef BOOST_OUTCOME_SYSTEM_ERROR2_NOT_POSIX
+      out = posix_code(e.code().value());
+#else
+      out = generic_code(static_cast<errc>(e.code().value()));
+#endif
+#endif
+      return system_code_from_exception_status::handled;
+    }
+    // Don't know this error code category, can't wrap it into std_error_code
+    // as its payload won't fit into system_code, so give up.
+    return system_code_from_exception_status::consumed;
+  }
+  template <class T, errc code> inline system_code_from_exception_status system_code_from_std_exception(const T & /*unused*/, system_code &out) noexcept
+  {
+    out = generic_code(code);
+    return system_code_from_exception_status::handled;
+  }
+
+  using system_code_from_exception_erased_fn = void (*)();
+  // A type erased mapper of exceptions of some type into system_code
+  struct system_code_from_exception_mapper
+  {
+#if BOOST_OUTCOME_SYSTEM_ERROR2_SYSTEM_CODE_FROM_EXCEPTION_USE_TYPE_DISPATCH
+    const std::type_info *type;
+    // obj must point at the exception object adjusted to the registered type
+    system_code_from_exception_status (*from_object)(system_code_from_exception_erased_fn fn, const void *obj, system_code &out);
+#endif
+    system_code_from_exception_status (*from_rethrow)(system_code_from_exception_erased_fn fn, const std::exception_ptr &ep, system_code &out);
+    system_code_from_exception_erased_fn fn;
+  };
+  template <class T, class Fn> struct system_code_from_exception_mapper_for
+  {
+    // User supplied mappers return an empty code if they cannot convert the exception
+    static system_code_from_exception_status _invoke(system_code (*fn)(const T &), const T &e, system_code &out)
+    {
+      out = fn(e);
+      return out.empty() ? system_code_from_exception_status::not_handled : system_code_from_exception_status::handled;
+    }
+    static system_code_from_exception_status _invoke(system_code_from_exception_status (*fn)(const T &, system_code &), const T &e, system_code &out)
+    {
+      return fn(e, out);
+    }
+    static system_code_from_exception_status _map(system_code_from_exception_erased_fn fn, const T &e, system_code &out) noexcept
+    {
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
       try
       {
-        system_code erased(e.code());
-        if(!erased.empty())
-        {
-          return erased;
-        }
+        return _invoke(reinterpret_cast<Fn>(fn), e, out);
       }
       catch(...)
       {
-        // Source status code's do_erased_copy() routine refused to copy the original
-        // Process instead as if the source were not a status_error
+        return system_code_from_exception_status::not_handled;
       }
-      throw;
+#else
+      return _invoke(reinterpret_cast<Fn>(fn), e, out);
+#endif
     }
-    catch(...)
+#if BOOST_OUTCOME_SYSTEM_ERROR2_SYSTEM_CODE_FROM_EXCEPTION_USE_TYPE_DISPATCH
+    static system_code_from_exception_status from_object(system_code_from_exception_erased_fn fn, const void *obj, system_code &out)
     {
-      throw;
+      return _map(fn, *static_cast<const T *>(obj), out);
     }
-  }
-  catch(const std::invalid_argument & /*unused*/)
+#endif
+    static system_code_from_exception_status from_rethrow(system_code_from_exception_erased_fn fn, const std::exception_ptr &ep, system_code &out)
+    {
+      try
+      {
+        std::rethrow_exception(ep);
+      }
+      catch(const T &e)
+      {
+        return _map(fn, e, out);
+      }
+      catch(...)
+      {
+      }
+      return system_code_from_exception_status::not_handled;
+    }
+    static system_code_from_exception_mapper make(Fn fn) noexcept
+    {
+      return {
+#if BOOST_OUTCOME_SYSTEM_ERROR2_SYSTEM_CODE_FROM_EXCEPTION_USE_TYPE_DISPATCH
+      &typeid(T), &from_object,
+#endif
+      &from_rethrow, reinterpret_cast<system_code_from_exception_erased_fn>(fn)};
+    }
+  };
+  template <class T> inline system_code_from_exception_mapper make_builtin_system_code_from_exception_mapper(system_code_from_exception_status (*fn)(const T &, system_code &)) noexcept
   {
-    ep = std::exception_ptr();
-    return generic_code(errc::invalid_argument);
+    return system_code_from_exception_mapper_for<T, system_code_from_exception_status (*)(const T &, system_code &)>::make(fn);
   }
-  catch(const std::domain_error & /*unused*/)
+
+  // Mappers registered at runtime, which are published by incrementing count
+  struct system_code_from_exception_registry
   {
-    ep = std::exception_ptr();
-    return generic_code(errc::argument_out_of_domain);
+    static constexpr size_t capacity = 64;
+    std::mutex lock;
+    std::atomic<size_t> count{0};
+    system_code_from_exception_mapper items[capacity];
+  };
+  inline system_code_from_exception_registry &system_code_from_exception_registry_instance() noexcept
+  {
+    static system_code_from_exception_registry registry;
+    return registry;
   }
-  catch(const std::length_error & /*unused*/)
+  // The last registered mapper is tried first
+  inline const system_code_from_exception_mapper &system_code_from_exception_registered(const system_code_from_exception_registry &registry, size_t count,
+                                                                                        size_t idx) noexcept
   {
-    ep = std::exception_ptr();
-    return generic_code(errc::argument_list_too_long);
+    return registry.items[count - 1 - idx];
   }
-  catch(const std::out_of_range & /*unused*/)
+
+#if BOOST_OUTCOME_SYSTEM_ERROR2_SYSTEM_CODE_FROM_EXCEPTION_USE_TYPE_DISPATCH
+  /* Built in mappers, tried after the registered ones. The order of this table must match the
+  catch clauses of system_code_from_exception_rethrow().
+  */
+  inline const system_code_from_exception_mapper *system_code_from_exception_builtins() noexcept
   {
-    ep = std::exception_ptr();
-    return generic_code(errc::result_out_of_range);
+    static const system_code_from_exception_mapper builtins[] = {
+    make_builtin_system_code_from_exception_mapper<status_error<void>>(system_code_from_status_error),
+    make_builtin_system_code_from_exception_mapper<std::invalid_argument>(system_code_from_std_exception<std::invalid_argument, errc::invalid_argument>),
+    make_builtin_system_code_from_exception_mapper<std::domain_error>(system_code_from_std_exception<std::domain_error, errc::argument_out_of_domain>),
+    make_builtin_system_code_from_exception_mapper<std::length_error>(system_code_from_std_exception<std::length_error, errc::argument_list_too_long>),
+    make_builtin_system_code_from_exception_mapper<std::out_of_range>(system_code_from_std_exception<std::out_of_range, errc::result_out_of_range>),
+    make_builtin_system_code_from_exception_mapper<std::logic_error>(system_code_from_std_exception<std::logic_error, errc::invalid_argument>),
+    make_builtin_system_code_from_exception_mapper<std::system_error>(system_code_from_std_system_error),
+    make_builtin_system_code_from_exception_mapper<std::overflow_error>(system_code_from_std_exception<std::overflow_error, errc::value_too_large>),
+    make_builtin_system_code_from_exception_mapper<std::range_error>(system_code_from_std_exception<std::range_error, errc::result_out_of_range>),
+    make_builtin_system_code_from_exception_mapper<std::runtime_error>(
+    system_code_from_std_exception<std::runtime_error, errc::resource_unavailable_try_again>),
+    make_builtin_system_code_from_exception_mapper<std::bad_alloc>(system_code_from_std_exception<std::bad_alloc, errc::not_enough_memory>),
+    };
+    return builtins;
   }
-  catch(const std::logic_error & /*unused*/) /* base class for this group */
+  static constexpr size_t system_code_from_exception_builtins_count = 11;
+
+  // Returns the first mapper from idx onwards which would catch the thrown type
+  inline size_t system_code_from_exception_find(const std::type_info *type, size_t idx, const system_code_from_exception_registry &registry, size_t count) noexcept
   {
-    ep = std::exception_ptr();
-    return generic_code(errc::invalid_argument);
+    for(; idx < count + system_code_from_exception_builtins_count; idx++)
+    {
+      const auto &mapper =
+      (idx < count) ? system_code_from_exception_registered(registry, count, idx) : system_code_from_exception_builtins()[idx - count];
+      void *obj = nullptr;
+      if(mapper.type->__do_catch(type, &obj, 1))
+      {
+        break;
+      }
+    }
+    return idx;
   }
-  catch(const std::system_error &e) /* also catches ios::failure */
+
+  /* Rather than rethrowing, which takes the unwinder's locks, ask the Itanium ABI which mappers
+  would catch the thrown type, and remember the first per type. Returns false if the thrown type
+  could not be determined.
+  */
+  inline bool system_code_from_exception_dispatch(const std::exception_ptr &ep, system_code &out, system_code_from_exception_status &status) noexcept
   {
-    ep = std::exception_ptr();
-    if(e.code().category() == std::generic_category())
+    const std::type_info *type = ep.__cxa_exception_type();
+    if(type == nullptr)
     {
-      return generic_code(static_cast<errc>(static_cast<int>(e.code().value())));
+      return false;
     }
-    if(e.code().category() == std::system_category())
+    const auto &registry = system_code_from_exception_registry_instance();
+    const size_t count = registry.count.load(std::memory_order_acquire);
+    struct cache_entry
     {
-#ifdef _WIN32
-      return win32_code(e.code().value());
-#else
-#ifndef BOOST_OUTCOME_SYSTEM_ERROR2_NOT_POSIX
-      return posix_code(e.code().value());
-#else
-      return generic_code(static_cast<errc>(e.code().value()));
-#endif
-#endif
+      const std::type_info *type;
+      size_t count, idx;
+    };
+    static thread_local boost::outcome_detail::per_thread_cache<cache_entry> cache;
+    auto &entry = cache.lookup(type);
+    if(entry.type != type || entry.count != count)
+    {
+      entry.type = type;
+      entry.count = count;
+      entry.idx = system_code_from_exception_find(type, 0, registry, count);
     }
-    // Don't know this error code category, can't wrap it into std_error_code
-    // as its payload won't fit into system_code, so fall through.
-  }
-  catch(const std::overflow_error & /*unused*/)
-  {
-    ep = std::exception_ptr();
-    return generic_code(errc::value_too_large);
+    status = system_code_from_exception_status::not_handled;
+    for(size_t idx = entry.idx; idx < count + system_code_from_exception_builtins_count;
+        idx = system_code_from_exception_find(type, idx + 1, registry, count))
+    {
+      const auto &mapper =
+      (idx < count) ? system_code_from_exception_registered(registry, count, idx) : system_code_from_exception_builtins()[idx - count];
+      void *obj = boost::outcome_detail::exception_ptr_object(ep);
+      if(!mapper.type->__do_catch(type, &obj, 1))
+      {
+        return false;
+      }
+      status = mapper.from_object(mapper.fn, obj, out);
+      if(status != system_code_from_exception_status::not_handled)
+      {
+        break;
+      }
+    }
+    return true;
   }
-  catch(const std::range_error & /*unused*/)
+#endif
+
+  inline system_code system_code_from_exception_rethrow(std::exception_ptr &ep, system_code not_matched) noexcept
   {
-    ep = std::exception_ptr();
-    return generic_code(errc::result_out_of_range);
+    // Registered mappers take precedence over the built in ones
+    {
+      const auto &registry = system_code_from_exception_registry_instance();
+      const size_t count = registry.count.load(std::memory_order_acquire);
+      for(size_t idx = 0; idx < count; idx++)
+      {
+        const auto &mapper = system_code_from_exception_registered(registry, count, idx);
+        system_code ret;
+        const auto status = mapper.from_rethrow(mapper.fn, ep, ret);
+        if(status == system_code_from_exception_status::handled)
+        {
+          ep = std::exception_ptr();
+          return ret;
+        }
+        if(status == system_code_from_exception_status::consumed)
+        {
+          ep = std::exception_ptr();
+          return not_matched;
+        }
+      }
+    }
+    try
+    {
+      try
+      {
+        std::rethrow_exception(ep);
+      }
+      catch(const status_error<void> &e)
+      {
+        system_code erased;
+        if(system_code_from_status_error(e, erased) == system_code_from_exception_status::handled)
+        {
+          ep = std::exception_ptr();
+          return erased;
+        }
+        throw;
+      }
+      catch(...)
+      {
+        throw;
+      }
+    }
+    catch(const std::invalid_argument & /*unused*/)
+    {
+      ep = std::exception_ptr();
+      return generic_code(errc::invalid_argument);
+    }
+    catch(const std::domain_error & /*unused*/)
+    {
+      ep = std::exception_ptr();
+      return generic_code(errc::argument_out_of_domain);
+    }
+    catch(const std::length_error & /*unused*/)
+    {
+      ep = std::exception_ptr();
+      return generic_code(errc::argument_list_too_long);
+    }
+    catch(const std::out_of_range & /*unused*/)
+    {
+      ep = std::exception_ptr();
+      return generic_code(errc::result_out_of_range);
+    }
+    catch(const std::logic_error & /*unused*/) /* base class for this group */
+    {
+      ep = std::exception_ptr();
+      return generic_code(errc::invalid_argument);
+    }
+    catch(const std::system_error &e) /* also catches ios::failure */
+    {
+      ep = std::exception_ptr();
+      system_code ret;
+      if(system_code_from_std_system_error(e, ret) == system_code_from_exception_status::handled)
+      {
+        return ret;
+      }
+    }
+    catch(const std::overflow_error & /*unused*/)
+    {
+      ep = std::exception_ptr();
+      return generic_code(errc::value_too_large);
+    }
+    catch(const std::range_error & /*unused*/)
+    {
+      ep = std::exception_ptr();
+      return generic_code(errc::result_out_of_range);
+    }
+    catch(const std::runtime_error & /*unused*/) /* base class for this group */
+    {
+      ep = std::exception_ptr();
+      return generic_code(errc::resource_unavailable_try_again);
+    }
+    catch(const std::bad_alloc & /*unused*/)
+    {
+      ep = std::exception_ptr();
+      return generic_code(errc::not_enough_memory);
+    }
+    catch(...)
+    {
+    }
+    return not_matched;
   }
-  catch(const std::runtime_error & /*unused*/) /* base class for this group */
+}  // namespace detail
+
+/*! Registers a function converting thrown exceptions of type `T`, or of types derived
+from `T`, into the closest matching `system_code`, for use by `system_code_from_exception()`.
+The function may return an empty `system_code` if it cannot convert a particular exception,
+in which case the next matching function is tried. The most recently registered function
+matching a thrown type is tried first, and all registered functions are tried before the
+built in conversions of `status_error<void>` and the standard exception types. Registering
+a function for `status_error<Domain>` thus overrides how those particular exceptions are
+converted.
+
+Returns false if no more functions can be registered. Registration is threadsafe, but
+functions cannot be unregistered.
+*/
+template <class T> inline bool register_system_code_from_exception(system_code (*mapper)(const T &))
+{
+  auto &registry = detail::system_code_from_exception_registry_instance();
+  std::lock_guard<std::mutex> g(registry.lock);
+  const size_t count = registry.count.load(std::memory_order_relaxed);
+  if(count == registry.capacity)
   {
-    ep = std::exception_ptr();
-    return generic_code(errc::resource_unavailable_try_again);
+    return false;
   }
-  catch(const std::bad_alloc & /*unused*/)
+  registry.items[count] = detail::system_code_from_exception_mapper_for<T, system_code (*)(const T &)>::make(mapper);
+  registry.count.store(count + 1, std::memory_order_release);
+  return true;
+}
+
+/*! A utility function which returns the closest matching system_code to a supplied
+exception ptr.
+
+On libstdc++ with RTTI, the thrown type is read from the exception ptr using the Itanium
+C++ ABI, and matched against each conversion without rethrowing, with the matching
+conversion cached per thread per type. `status_error<Domain>` has its code copied out
+directly. Elsewhere, the exception is rethrown for each registered conversion, then once
+more for the built in conversions.
+*/
+inline system_code system_code_from_exception(std::exception_ptr &&ep = std::current_exception(), system_code not_matched = generic_code(errc::resource_unavailable_try_again)) noexcept
+{
+  if(!ep)
   {
-    ep = std::exception_ptr();
-    return generic_code(errc::not_enough_memory);
+    return generic_code(errc::success);
   }
-  catch(...)
+#if BOOST_OUTCOME_SYSTEM_ERROR2_SYSTEM_CODE_FROM_EXCEPTION_USE_TYPE_DISPATCH
   {
+    system_code ret;
+    auto status = detail::system_code_from_exception_status::not_handled;
+    if(detail::system_code_from_exception_dispatch(ep, ret, status))
+    {
+      if(status == detail::system_code_from_exception_status::not_handled)
+      {
+        return not_matched;
+      }
+      ep = std::exception_ptr();
+      if(status == detail::system_code_from_exception_status::consumed)
+      {
+        return not_matched;
+      }
+      return ret;
+    }
   }
-  return not_matched;
+#endif
+  return detail::system_code_from_exception_rethrow(ep, static_cast<system_code &&>(not_matched));
 }
 
 BOOST_OUTCOME_SYSTEM_ERROR2_NAMESPACE_END
@@ -44,32 +44,32 @@ namespace detail
 
   template <template <class, class> class ValueStorage, class T, class E> inline std::ostream &value_storage_out(std::ostream &s, const ValueStorage<T, E> &v)
   {
-    s << static_cast<uint16_t>(v._status.status_value) << " " << v._status.spare_storage_value << " ";
+    s << static_cast<uint16_t>(v._status.status_value) << " " << v._status.spare_storage() << " ";
     if(v._status.have_value())
     {
-      s << v._value;  // NOLINT
+      s << v._value_ref();  // NOLINT
     }
     if(v._status.have_error())
     {
-      s << v._error;  // NOLINT
+      s << v._error_ref();  // NOLINT
     }
     return s;
   }
   template <template <class, class> class ValueStorage, class E> inline std::ostream &value_storage_out(std::ostream &s, const ValueStorage<void, E> &v)
   {
-    s << static_cast<uint16_t>(v._status.status_value) << " " << v._status.spare_storage_value << " ";
+    s << static_cast<uint16_t>(v._status.status_value) << " " << v._status.spare_storage() << " ";
     if(v._status.have_error())
     {
-      s << v._error;  // NOLINT
+      s << v._error_ref();  // NOLINT
     }
     return s;
   }
   template <template <class, class> class ValueStorage, class T> inline std::ostream &value_storage_out(std::ostream &s, const ValueStorage<T, void> &v)
   {
-    s << static_cast<uint16_t>(v._status.status_value) << " " << v._status.spare_storage_value << " ";
+    s << static_cast<uint16_t>(v._status.status_value) << " " << v._status.spare_storage() << " ";
     if(v._status.have_value())
     {
-      s << v._value;  // NOLINT
+      s << v._value_ref();  // NOLINT
     }
     return s;
   }
@@ -82,19 +82,20 @@ namespace detail
     using type = ValueStorage<T, E>;
     v.~type();
     new(&v) type;
-    uint16_t x, y;
+    uint16_t x;
+    spare_storage_type y;
     s >> x >> y;
     v._status.status_value = static_cast<detail::status>(x);
-    v._status.spare_storage_value = y;
+    v._status.set_spare_storage(y);
     if(v._status.have_value())
     {
-      new(&v._value) decltype(v._value)();  // NOLINT
-      s >> v._value;                        // NOLINT
+      new(&v._value_ref()) typename type::_value_type_();  // NOLINT
+      s >> v._value_ref();                                  // NOLINT
     }
     if(v._status.have_error())
     {
-      new(&v._error) decltype(v._error)();  // NOLINT
-      s >> v._error;                        // NOLINT
+      new(&v._error_ref()) typename type::_error_type_();  // NOLINT
+      s >> v._error_ref();                                  // NOLINT
     }
     return s;
   }
@@ -103,14 +104,15 @@ namespace detail
     using type = ValueStorage<void, E>;
     v.~type();
     new(&v) type;
-    uint16_t x, y;
+    uint16_t x;
+    spare_storage_type y;
     s >> x >> y;
     v._status.status_value = static_cast<detail::status>(x);
-    v._status.spare_storage_value = y;
+    v._status.set_spare_storage(y);
     if(v._status.have_error())
     {
-      new(&v._error) decltype(v._error)();  // NOLINT
-      s >> v._error;                        // NOLINT
+      new(&v._error_ref()) typename type::_error_type_();  // NOLINT
+      s >> v._error_ref();                                  // NOLINT
     }
     return s;
   }
@@ -119,14 +121,15 @@ namespace detail
     using type = ValueStorage<T, void>;
     v.~type();
     new(&v) type;
-    uint16_t x, y;
+    uint16_t x;
+    spare_storage_type y;
     s >> x >> y;
     v._status.status_value = static_cast<detail::status>(x);
-    v._status.spare_storage_value = y;
+    v._status.set_spare_storage(y);
     if(v._status.have_value())
     {
-      new(&v._value) decltype(v._value)();  // NOLINT
-      s >> v._value;                        // NOLINT
+      new(&v._value_ref()) typename type::_value_type_();  // NOLINT
+      s >> v._value_ref();                                  // NOLINT
     }
     return s;
   }
@@ -0,0 +1,195 @@
+/* An exception pointer which is synthesised only when needed
+(C) 2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2024
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef BOOST_OUTCOME_LAZY_EXCEPTION_PTR_HPP
+#define BOOST_OUTCOME_LAZY_EXCEPTION_PTR_HPP
+
+#include "boost_outcome.hpp"
+
+#include <cstring>  // for strcmp
+
+#ifndef STD_BASIC_OUTCOME_LAZY_EXCEPTION_FROM_ERROR
+#define STD_BASIC_OUTCOME_LAZY_EXCEPTION_FROM_ERROR
+namespace std  // NOLINT
+{
+  inline exception_ptr basic_outcome_failure_exception_from_error(const error_code &ec, const char *message)
+  {
+    return make_exception_ptr(system_error(ec, message));
+  }
+}  // namespace std
+#endif
+
+#ifndef BOOST_SYSTEM_BASIC_OUTCOME_LAZY_EXCEPTION_FROM_ERROR
+#define BOOST_SYSTEM_BASIC_OUTCOME_LAZY_EXCEPTION_FROM_ERROR
+namespace boost
+{
+  namespace system
+  {
+    inline boost::exception_ptr basic_outcome_failure_exception_from_error(const boost::system::error_code &ec, const char *message)
+    {
+      return boost::copy_exception(boost::system::system_error(ec, message));
+    }
+  }  // namespace system
+}  // namespace boost
+#endif
+
+BOOST_OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  namespace adl
+  {
+    // Do NOT use template requirements here!
+    template <class S, typename = decltype(basic_outcome_failure_exception_from_error(std::declval<S>(), std::declval<const char *>()))>
+    inline auto _delayed_lookup_basic_outcome_failure_exception_from_error(const S &ec, const char *message, search_detail_adl /*unused*/)
+    {
+      // ADL discovered
+      return basic_outcome_failure_exception_from_error(ec, message);
+    }
+  }  // namespace adl
+
+  // The default factory, which synthesises the same exception as .failure() would
+  template <class P, class S> inline P lazy_exception_from_error(const S &ec, const char *message)
+  {
+    if(message == nullptr)
+    {
+      return _delayed_lookup_basic_outcome_failure_exception_from_error(ec, adl::search_detail_adl());
+    }
+    return _delayed_lookup_basic_outcome_failure_exception_from_error(ec, message, adl::search_detail_adl());
+  }
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+type definition template <class EC, class EP> basic_lazy_exception_ptr. Potential doc page: `basic_lazy_exception_ptr<EC, EP>`
+*/
+template <class EC, class EP> class basic_lazy_exception_ptr
+{
+public:
+  //! The error code from which the exception is synthesised
+  using error_type = EC;
+  //! The exception pointer synthesised
+  using exception_ptr_type = EP;
+  //! The type of function which synthesises the exception pointer
+  using factory_type = EP (*)(const EC &code, const char *message);
+
+private:
+  EP _ptr{};
+  EC _code{};
+  const char *_message{nullptr};
+  factory_type _factory{nullptr};
+
+public:
+  //! Default constructs to no exception.
+  basic_lazy_exception_ptr() = default;
+  //! Implicitly constructs from an exception pointer, which is not deferred.
+  basic_lazy_exception_ptr(exception_ptr_type ptr) noexcept(std::is_nothrow_move_constructible<exception_ptr_type>::value)  // NOLINT
+      : _ptr(static_cast<exception_ptr_type &&>(ptr))
+  {
+  }
+  /*! Explicitly constructs an exception deferred until needed, which `factory` shall synthesise from
+  `code` and `message`. `message` must outlive all copies of this, and may be null. `factory` must not be null.
+  */
+  explicit basic_lazy_exception_ptr(error_type code, const char *message = nullptr,
+                                    factory_type factory = &detail::lazy_exception_from_error<exception_ptr_type, error_type>) noexcept(std::is_nothrow_move_constructible<error_type>::value)
+      : _code(static_cast<error_type &&>(code))
+      , _message(message)
+      , _factory(factory)
+  {
+  }
+
+  //! True if the exception has not yet been synthesised.
+  bool is_deferred() const noexcept { return _factory != nullptr; }
+  //! True if there is an exception, synthesised or not.
+  explicit operator bool() const noexcept { return _factory != nullptr || static_cast<bool>(_ptr); }
+  //! The error code from which the exception would be synthesised, if deferred.
+  const error_type &code() const noexcept { return _code; }
+  //! The message with which the exception would be synthesised, if deferred.
+  const char *message() const noexcept { return _message; }
+
+  //! Returns the exception pointer, synthesising a new exception each time if deferred.
+  exception_ptr_type get() const { return (_factory != nullptr) ? _factory(_code, _message) : _ptr; }
+  //! Synthesises the exception if deferred, and returns it. Later calls return the same exception.
+  const exception_ptr_type &materialise()
+  {
+    if(_factory != nullptr)
+    {
+      _ptr = _factory(_code, _message);
+      _factory = nullptr;
+    }
+    return _ptr;
+  }
+  //! Explicitly converts into the exception pointer, as if by `get()`.
+  explicit operator exception_ptr_type() const { return get(); }
+
+  //! Found by ADL by `trait::is_exception_ptr_available<>` and by the no-value policies which rethrow.
+  friend exception_ptr_type make_exception_ptr(const basic_lazy_exception_ptr &v) { return v.get(); }
+
+  //! Deferred exceptions are equal if their code, message and factory are. Synthesised exceptions are equal if their pointers are.
+  friend bool operator==(const basic_lazy_exception_ptr &a, const basic_lazy_exception_ptr &b) noexcept
+  {
+    if(a._factory != b._factory)
+    {
+      return false;
+    }
+    if(a._factory == nullptr)
+    {
+      return a._ptr == b._ptr;
+    }
+    return a._code == b._code && (a._message == b._message || (a._message != nullptr && b._message != nullptr && 0 == std::strcmp(a._message, b._message)));
+  }
+  friend bool operator!=(const basic_lazy_exception_ptr &a, const basic_lazy_exception_ptr &b) noexcept { return !(a == b); }
+};
+
+namespace trait
+{
+  // A lazy exception pointer is an error type, same as the exception pointer it synthesises
+  template <class EC, class EP> struct is_error_type<basic_lazy_exception_ptr<EC, EP>>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace trait
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+type alias std_lazy_exception_ptr. Potential doc page: `basic_lazy_exception_ptr<EC, EP>`
+*/
+using std_lazy_exception_ptr = basic_lazy_exception_ptr<std::error_code, std::exception_ptr>;
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+type alias boost_lazy_exception_ptr. Potential doc page: `basic_lazy_exception_ptr<EC, EP>`
+*/
+using boost_lazy_exception_ptr = basic_lazy_exception_ptr<boost::system::error_code, boost::exception_ptr>;
+
+/*! In standalone Outcome, this aliases `std_lazy_exception_ptr`. In Boost.Outcome, this aliases `boost_lazy_exception_ptr`.
+*/
+using lazy_exception_ptr = boost_lazy_exception_ptr;
+
+BOOST_OUTCOME_V2_NAMESPACE_END
+
+#endif
@@ -6,18 +6,60 @@ class OutcomeBasicOutcomePrinter(object):
     def __init__(self, val):
         self.val = val
 
+    def spare_storage(self):
+        # BOOST_OUTCOME_SPARE_STORAGE_BITS may be 0, 16 or 48
+        status = self.val['_state']['_status']
+        fields = [f.name for f in status.type.fields()]
+        if 'spare_storage_value' not in fields:
+            return None
+        ret = int(status['spare_storage_value'])
+        if 'spare_storage_value_high' in fields:
+            ret |= int(status['spare_storage_value_high']) << 16
+        return ret
+
+    def member(self, name):
+        # Non-trivial storage keeps its value and error in named unions
+        state = self.val['_state']
+        for union in (['_error_union', '_value_union'] if name == '_error' else ['_value_union']):
+            try:
+                return state[union][name]
+            except gdb.error:
+                pass
+        return state[name]
+
+    def exception(self):
+        # BOOST_OUTCOME_COMPACT_OUTCOME_STORAGE may place the exception into the storage of the value
+        try:
+            return self.val['_ptr']
+        except gdb.error:
+            exception_type = self.val.type.strip_typedefs().template_argument(2)
+            return self.member('_value').address.cast(exception_type.pointer()).dereference()
+
+    def niche_encoded(self):
+        # Niche storage has no status bits, only whichever of value and error is not void
+        status = self.val['_state']['_status']
+        return '_stored' in [f.name for f in status.type.fields()]
+
     def children(self):
+        if self.niche_encoded():
+            yield ('stored', self.val['_state']['_status']['_stored'])
+            return
         if self.val['_state']['_status']['status_value'] & 1 == 1:
-            yield ('value', self.val['_state']['_value'])
+            yield ('value', self.member('_value'))
         if self.val['_state']['_status']['status_value'] & 2 == 2:
-            yield ('error', self.val['_state']['_error'])
+            yield ('error', self.member('_error'))
         if self.val['_state']['_status']['status_value'] & 4 == 4:
-            yield ('exception', self.val['_ptr'])
+            yield ('exception', self.exception())
+        spare_storage = self.spare_storage()
+        if spare_storage:
+            yield ('spare_storage', hex(spare_storage))
 
     def display_hint(self):
         return None
 
     def to_string(self):
+        if self.niche_encoded():
+            return 'niche encoded'
         if self.val['_state']['_status']['status_value'] & 54 == 54:
             return 'errored (errno, moved from) + exceptioned'
         if self.val['_state']['_status']['status_value'] & 50 == 50:
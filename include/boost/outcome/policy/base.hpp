@@ -106,8 +106,16 @@ SIGNATURE NOT RECOGNISED
     template <class Impl> static constexpr void _set_has_exception(Impl &&self, bool v) noexcept { self._state._status.set_have_exception(v); }
     template <class Impl> static constexpr void _set_has_error_is_errno(Impl &&self, bool v) noexcept { self._state._status.set_have_error_is_errno(v); }
 
-    template <class Impl> static constexpr auto &&_value(Impl &&self) noexcept { return static_cast<Impl &&>(self)._state._value; }
-    template <class Impl> static constexpr auto &&_error(Impl &&self) noexcept { return static_cast<Impl &&>(self)._state._error; }
+    // The storage accessors always return lvalues, so restore the value category of self
+    template <class Impl, class T> using _like = std::conditional_t<std::is_lvalue_reference<Impl>::value, T &, T &&>;
+    template <class Impl> static constexpr auto &&_value(Impl &&self) noexcept
+    {
+      return static_cast<_like<Impl, std::remove_reference_t<decltype(self._state._value_ref())>>>(self._state._value_ref());
+    }
+    template <class Impl> static constexpr auto &&_error(Impl &&self) noexcept
+    {
+      return static_cast<_like<Impl, std::remove_reference_t<decltype(self._state._error_ref())>>>(self._state._error_ref());
+    }
 
   public:
     template <class R, class S, class P, class NoValuePolicy, class Impl> static inline constexpr auto &&_exception(Impl &&self) noexcept;
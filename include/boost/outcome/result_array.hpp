@@ -0,0 +1,612 @@
+/* Structure-of-arrays container for bulk results
+(C) 2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2024
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef BOOST_OUTCOME_RESULT_ARRAY_HPP
+#define BOOST_OUTCOME_RESULT_ARRAY_HPP
+
+#include "result.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+BOOST_OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+
+namespace detail
+{
+  // Each word holds the failure bits of 64 consecutive results
+  static constexpr size_t result_array_word_bits = 64;
+
+  inline size_t result_array_popcount(uint64_t v) noexcept
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_popcountll(v));
+#else
+    v = v - ((v >> 1) & 0x5555555555555555ULL);
+    v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+    v = (v + (v >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return static_cast<size_t>((v * 0x0101010101010101ULL) >> 56);
+#endif
+  }
+  // v must not be zero
+  inline size_t result_array_ctz(uint64_t v) noexcept
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_ctzll(v));
+#else
+    size_t ret = 0;
+    while(!(v & 1))
+    {
+      v >>= 1;
+      ++ret;
+    }
+    return ret;
+#endif
+  }
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+type definition template <class T, class E, class NoValuePolicy> result_array. Potential doc page: `result_array<T, E, NoValuePolicy>`
+*/
+template <class T, class E = boost::system::error_code, class NoValuePolicy = policy::default_policy<T, E, void>>  //
+class result_array
+{
+  static_assert(!std::is_void<T>::value && !std::is_void<E>::value, "result_array cannot store void");
+
+public:
+  using value_type = T;
+  using error_type = E;
+  using no_value_policy_type = NoValuePolicy;
+  using result_type = basic_result<T, E, NoValuePolicy>;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+
+  //! A contiguous view of one of the underlying arrays.
+  template <class U> class span
+  {
+    U *_data{nullptr};
+    size_t _size{0};
+
+  public:
+    span() = default;
+    constexpr span(U *data, size_t size) noexcept
+        : _data(data)
+        , _size(size)
+    {
+    }
+    constexpr U *data() const noexcept { return _data; }
+    constexpr size_t size() const noexcept { return _size; }
+    constexpr bool empty() const noexcept { return _size == 0; }
+    constexpr U *begin() const noexcept { return _data; }
+    constexpr U *end() const noexcept { return _data + _size; }
+    constexpr U &operator[](size_t idx) const noexcept { return _data[idx]; }
+  };
+
+  template <bool IsConst> class basic_reference;
+  template <bool IsConst> class basic_iterator;
+  using reference = basic_reference<false>;
+  using const_reference = basic_reference<true>;
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  //! A proxy for the result stored at an index, with the observers of `basic_result`.
+  template <bool IsConst> class basic_reference
+  {
+    friend class result_array;
+    using _array_type = std::conditional_t<IsConst, const result_array, result_array>;
+    using _value_reference = std::conditional_t<IsConst, const T &, T &>;
+    using _error_reference = std::conditional_t<IsConst, const E &, E &>;
+
+    _array_type *_array;
+    size_t _idx;
+
+    constexpr basic_reference(_array_type *array, size_t idx) noexcept
+        : _array(array)
+        , _idx(idx)
+    {
+    }
+
+  public:
+    basic_reference(const basic_reference &) = default;
+    //! Converting a mutable reference to a const one.
+    template <bool C = IsConst, std::enable_if_t<C, bool> = true>
+    constexpr basic_reference(const basic_reference<false> &o) noexcept  // NOLINT
+        : _array(o._array)
+        , _idx(o._idx)
+    {
+    }
+    //! Assigns the contents of the referenced result, not the reference itself.
+    basic_reference &operator=(const basic_reference &o)
+    {
+      _array->_assign(_idx, static_cast<result_type>(o));
+      return *this;
+    }
+    basic_reference &operator=(const result_type &o)
+    {
+      _array->_assign(_idx, o);
+      return *this;
+    }
+
+    bool has_value() const noexcept { return !_array->_is_failure(_idx); }
+    bool has_error() const noexcept { return _array->_is_failure(_idx); }
+    bool has_failure() const noexcept { return _array->_is_failure(_idx); }
+    explicit operator bool() const noexcept { return has_value(); }
+
+    _value_reference assume_value() const noexcept { return _array->_values[_idx]; }
+    _error_reference assume_error() const noexcept { return _array->_errors[_idx]; }
+    //! Applies the no-value policy of `result_type` exactly as `basic_result::value()` would.
+    _value_reference value() const
+    {
+      if(has_error())
+      {
+        (void) result_type(in_place_type<E>, _array->_errors[_idx]).value();
+      }
+      return _array->_values[_idx];
+    }
+    //! Applies the no-value policy of `result_type` exactly as `basic_result::error()` would.
+    _error_reference error() const
+    {
+      if(has_value())
+      {
+        (void) result_type(in_place_type<T>, _array->_values[_idx]).error();
+      }
+      return _array->_errors[_idx];
+    }
+
+    //! Materialises a copy of the referenced result.
+    operator result_type() const  // NOLINT
+    {
+      if(has_error())
+      {
+        return result_type(in_place_type<E>, _array->_errors[_idx]);
+      }
+      return result_type(in_place_type<T>, _array->_values[_idx]);
+    }
+  };
+
+  /*! An iterator yielding `basic_reference` proxies. It supports the random access operations,
+  but dereferencing yields a proxy rather than a real reference, so it is categorised as an input iterator.
+  */
+  template <bool IsConst> class basic_iterator
+  {
+    friend class result_array;
+    using _array_type = std::conditional_t<IsConst, const result_array, result_array>;
+
+    _array_type *_array{nullptr};
+    size_t _idx{0};
+
+    constexpr basic_iterator(_array_type *array, size_t idx) noexcept
+        : _array(array)
+        , _idx(idx)
+    {
+    }
+
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = result_type;
+    using difference_type = ptrdiff_t;
+    using reference = basic_reference<IsConst>;
+    using pointer = void;
+
+    basic_iterator() = default;
+    template <bool C = IsConst, std::enable_if_t<C, bool> = true>
+    constexpr basic_iterator(const basic_iterator<false> &o) noexcept  // NOLINT
+        : _array(o._array)
+        , _idx(o._idx)
+    {
+    }
+
+    //! The index of the referenced result within its array.
+    constexpr size_t index() const noexcept { return _idx; }
+
+    constexpr reference operator*() const noexcept { return {_array, _idx}; }
+    constexpr reference operator[](difference_type n) const noexcept { return {_array, _idx + n}; }
+
+    constexpr basic_iterator &operator++() noexcept
+    {
+      ++_idx;
+      return *this;
+    }
+    constexpr basic_iterator operator++(int) noexcept
+    {
+      basic_iterator ret(*this);
+      ++_idx;
+      return ret;
+    }
+    constexpr basic_iterator &operator--() noexcept
+    {
+      --_idx;
+      return *this;
+    }
+    constexpr basic_iterator operator--(int) noexcept
+    {
+      basic_iterator ret(*this);
+      --_idx;
+      return ret;
+    }
+    constexpr basic_iterator &operator+=(difference_type n) noexcept
+    {
+      _idx += n;
+      return *this;
+    }
+    constexpr basic_iterator &operator-=(difference_type n) noexcept
+    {
+      _idx -= n;
+      return *this;
+    }
+    constexpr friend basic_iterator operator+(basic_iterator a, difference_type n) noexcept { return a += n; }
+    constexpr friend basic_iterator operator+(difference_type n, basic_iterator a) noexcept { return a += n; }
+    constexpr friend basic_iterator operator-(basic_iterator a, difference_type n) noexcept { return a -= n; }
+    constexpr friend difference_type operator-(const basic_iterator &a, const basic_iterator &b) noexcept
+    {
+      return static_cast<difference_type>(a._idx) - static_cast<difference_type>(b._idx);
+    }
+    constexpr friend bool operator==(const basic_iterator &a, const basic_iterator &b) noexcept { return a._idx == b._idx; }
+    constexpr friend bool operator!=(const basic_iterator &a, const basic_iterator &b) noexcept { return a._idx != b._idx; }
+    constexpr friend bool operator<(const basic_iterator &a, const basic_iterator &b) noexcept { return a._idx < b._idx; }
+    constexpr friend bool operator>(const basic_iterator &a, const basic_iterator &b) noexcept { return a._idx > b._idx; }
+    constexpr friend bool operator<=(const basic_iterator &a, const basic_iterator &b) noexcept { return a._idx <= b._idx; }
+    constexpr friend bool operator>=(const basic_iterator &a, const basic_iterator &b) noexcept { return a._idx >= b._idx; }
+  };
+
+private:
+  // Only one of _values[n] and _errors[n] is ever constructed, according to bit n of _failures
+  T *_values{nullptr};
+  E *_errors{nullptr};
+  size_t _size{0}, _capacity{0};
+  std::vector<uint64_t> _failures;  // one bit per result up to capacity, bits beyond size() are always zero
+
+  static constexpr size_t _words(size_t n) noexcept { return (n + detail::result_array_word_bits - 1) / detail::result_array_word_bits; }
+  bool _is_failure(size_t idx) const noexcept
+  {
+    return (_failures[idx / detail::result_array_word_bits] >> (idx % detail::result_array_word_bits)) & 1;
+  }
+  void _set_failure(size_t idx, bool v) noexcept
+  {
+    const uint64_t mask = uint64_t(1) << (idx % detail::result_array_word_bits);
+    auto &word = _failures[idx / detail::result_array_word_bits];
+    word = v ? (word | mask) : (word & ~mask);
+  }
+  template <class... Args> static void _construct_slot(std::false_type /*failed*/, T *values, E * /*unused*/, size_t idx, Args &&...args)
+  {
+    new(values + idx) T(static_cast<Args &&>(args)...);
+  }
+  template <class... Args> static void _construct_slot(std::true_type /*failed*/, T * /*unused*/, E *errors, size_t idx, Args &&...args)
+  {
+    new(errors + idx) E(static_cast<Args &&>(args)...);
+  }
+  static void _destroy_slot(T *values, E *errors, size_t idx, bool failed) noexcept
+  {
+    if(failed)
+    {
+      errors[idx].~E();
+    }
+    else
+    {
+      values[idx].~T();
+    }
+  }
+  // Owns a pair of arrays, destroying their first `live` results and any appended result, and freeing them unless adopted
+  struct _storage_guard
+  {
+    const result_array *self;
+    size_t capacity;
+    T *values{nullptr};
+    E *errors{nullptr};
+    size_t live{0};
+    int appended{0};  // 1 if a value, 2 if an error, has been constructed at index self->_size
+    ~_storage_guard()
+    {
+      for(size_t idx = 0; idx < live; idx++)
+      {
+        _destroy_slot(values, errors, idx, self->_is_failure(idx));
+      }
+      if(appended != 0)
+      {
+        _destroy_slot(values, errors, self->_size, appended == 2);
+      }
+      if(values != nullptr)
+      {
+        std::allocator<T>().deallocate(values, capacity);
+      }
+      if(errors != nullptr)
+      {
+        std::allocator<E>().deallocate(errors, capacity);
+      }
+    }
+  };
+  void _allocate(_storage_guard &g)
+  {
+    _failures.resize(_words(g.capacity));
+    g.values = std::allocator<T>().allocate(g.capacity);
+    g.errors = std::allocator<E>().allocate(g.capacity);
+  }
+  // Moves the results into the guard's arrays, then swaps them in so the guard frees the old ones
+  void _relocate_and_adopt(_storage_guard &g)
+  {
+    for(; g.live < _size; ++g.live)
+    {
+      const size_t idx = g.live;
+      if(_is_failure(idx))
+      {
+        new(g.errors + idx) E(std::move_if_noexcept(_errors[idx]));
+      }
+      else
+      {
+        new(g.values + idx) T(std::move_if_noexcept(_values[idx]));
+      }
+    }
+    std::swap(_values, g.values);
+    std::swap(_errors, g.errors);
+    std::swap(_capacity, g.capacity);
+    g.appended = 0;
+  }
+  void _assign(size_t idx, const result_type &o)
+  {
+    const bool failed = _is_failure(idx);
+    if(o.has_value() && !failed)
+    {
+      _values[idx] = o.assume_value();
+    }
+    else if(!o.has_value() && failed)
+    {
+      _errors[idx] = o.assume_error();
+    }
+    else if(o.has_value())
+    {
+      new(_values + idx) T(o.assume_value());
+      _errors[idx].~E();
+      _set_failure(idx, false);
+    }
+    else
+    {
+      new(_errors + idx) E(o.assume_error());
+      _values[idx].~T();
+      _set_failure(idx, true);
+    }
+  }
+  // If the arrays are full, the new result is constructed before the others are moved, as args may refer to them
+  template <bool Failed, class... Args> void _append(Args &&...args)
+  {
+    if(_size < _capacity)
+    {
+      _construct_slot(std::integral_constant<bool, Failed>(), _values, _errors, _size, static_cast<Args &&>(args)...);
+    }
+    else
+    {
+      _storage_guard g{this, (_capacity == 0) ? 8 : _capacity * 2};
+      _allocate(g);
+      _construct_slot(std::integral_constant<bool, Failed>(), g.values, g.errors, _size, static_cast<Args &&>(args)...);
+      g.appended = Failed ? 2 : 1;
+      _relocate_and_adopt(g);
+    }
+    if(Failed)
+    {
+      _set_failure(_size, true);
+    }
+    ++_size;
+  }
+  template <class... Args> void _append_value(Args &&...args) { _append<false>(static_cast<Args &&>(args)...); }
+  template <class... Args> void _append_error(Args &&...args) { _append<true>(static_cast<Args &&>(args)...); }
+
+public:
+  //! Default constructor, constructs an empty array.
+  result_array() = default;
+  //! Constructs from a sequence of results.
+  template <class It, class = typename std::iterator_traits<It>::iterator_category> result_array(It first, It last)
+  {
+    for(; first != last; ++first)
+    {
+      push_back(*first);
+    }
+  }
+  //! Constructs from a list of results.
+  result_array(std::initializer_list<result_type> il)
+      : result_array(il.begin(), il.end())
+  {
+  }
+  //! Copy constructor.
+  result_array(const result_array &o)
+      : result_array()
+  {
+    reserve(o._size);
+    for(size_t idx = 0; idx < o._size; idx++)
+    {
+      if(o._is_failure(idx))
+      {
+        _append_error(o._errors[idx]);
+      }
+      else
+      {
+        _append_value(o._values[idx]);
+      }
+    }
+  }
+  //! Move constructor, leaves the source empty.
+  result_array(result_array &&o) noexcept
+      : _values(o._values)
+      , _errors(o._errors)
+      , _size(o._size)
+      , _capacity(o._capacity)
+      , _failures(static_cast<std::vector<uint64_t> &&>(o._failures))
+  {
+    o._values = nullptr;
+    o._errors = nullptr;
+    o._size = o._capacity = 0;
+    o._failures.clear();
+  }
+  //! Copy assignment.
+  result_array &operator=(const result_array &o)
+  {
+    if(this != &o)
+    {
+      result_array temp(o);
+      swap(temp);
+    }
+    return *this;
+  }
+  //! Move assignment, leaves the source empty.
+  result_array &operator=(result_array &&o) noexcept
+  {
+    if(this != &o)
+    {
+      result_array temp(static_cast<result_array &&>(o));
+      swap(temp);
+    }
+    return *this;
+  }
+  ~result_array()
+  {
+    clear();
+    _storage_guard g{this, _capacity, _values, _errors};
+  }
+  //! Swaps the contents with another array.
+  void swap(result_array &o) noexcept
+  {
+    std::swap(_values, o._values);
+    std::swap(_errors, o._errors);
+    std::swap(_size, o._size);
+    std::swap(_capacity, o._capacity);
+    _failures.swap(o._failures);
+  }
+
+  //! The number of results stored.
+  size_type size() const noexcept { return _size; }
+  //! True if no results are stored.
+  bool empty() const noexcept { return _size == 0; }
+  //! Reserves storage for at least `n` results.
+  void reserve(size_type n)
+  {
+    if(n > _capacity)
+    {
+      _storage_guard g{this, n};
+      _allocate(g);
+      _relocate_and_adopt(g);
+    }
+  }
+  //! Removes all results.
+  void clear() noexcept
+  {
+    for(size_t idx = 0; idx < _size; idx++)
+    {
+      _destroy_slot(_values, _errors, idx, _is_failure(idx));
+    }
+    std::fill(_failures.begin(), _failures.begin() + _words(_size), 0);
+    _size = 0;
+  }
+
+  //! Appends a copy of a result.
+  void push_back(const result_type &o)
+  {
+    if(o.has_value())
+    {
+      _append_value(o.assume_value());
+    }
+    else
+    {
+      _append_error(o.assume_error());
+    }
+  }
+  //! Appends a result by move.
+  void push_back(result_type &&o)
+  {
+    if(o.has_value())
+    {
+      _append_value(static_cast<result_type &&>(o).assume_value());
+    }
+    else
+    {
+      _append_error(static_cast<result_type &&>(o).assume_error());
+    }
+  }
+  //! Appends a successful result with a value constructed in place from `args`.
+  template <class... Args> void emplace_value(Args &&...args) { _append_value(static_cast<Args &&>(args)...); }
+  //! Appends a failed result with an error constructed in place from `args`.
+  template <class... Args> void emplace_error(Args &&...args) { _append_error(static_cast<Args &&>(args)...); }
+  //! Removes the last result.
+  void pop_back() noexcept
+  {
+    const size_t idx = _size - 1;
+    _destroy_slot(_values, _errors, idx, _is_failure(idx));
+    _set_failure(idx, false);
+    --_size;
+  }
+
+  reference operator[](size_type idx) noexcept { return {this, idx}; }
+  const_reference operator[](size_type idx) const noexcept { return {this, idx}; }
+
+  iterator begin() noexcept { return {this, 0}; }
+  const_iterator begin() const noexcept { return {this, 0}; }
+  const_iterator cbegin() const noexcept { return {this, 0}; }
+  iterator end() noexcept { return {this, size()}; }
+  const_iterator end() const noexcept { return {this, size()}; }
+  const_iterator cend() const noexcept { return {this, size()}; }
+
+  //! The number of failed results, computed 64 results at a time from the status bitmap.
+  size_type count_failures() const noexcept
+  {
+    size_type ret = 0;
+    for(size_t n = 0; n < _words(_size); n++)
+    {
+      ret += detail::result_array_popcount(_failures[n]);
+    }
+    return ret;
+  }
+  //! The index of the first failed result, or `size()` if there is none.
+  size_type first_failure() const noexcept
+  {
+    for(size_t n = 0; n < _words(_size); n++)
+    {
+      if(_failures[n] != 0)
+      {
+        return n * detail::result_array_word_bits + detail::result_array_ctz(_failures[n]);
+      }
+    }
+    return size();
+  }
+
+  //! The contiguous array of values. Entries at failed indices are not constructed and must not be accessed.
+  span<T> values_span() noexcept { return {_values, _size}; }
+  span<const T> values_span() const noexcept { return {_values, _size}; }
+  //! The contiguous array of errors. Entries at successful indices are not constructed and must not be accessed.
+  span<E> errors_span() noexcept { return {_errors, _size}; }
+  span<const E> errors_span() const noexcept { return {_errors, _size}; }
+  //! The status bitmap, where bit `n % 64` of word `n / 64` is set if result `n` failed.
+  span<const uint64_t> failure_bitmap() const noexcept { return {_failures.data(), _words(_size)}; }
+};
+
+BOOST_OUTCOME_V2_NAMESPACE_END
+
+#endif
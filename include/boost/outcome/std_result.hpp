@@ -62,6 +62,27 @@ SIGNATURE NOT RECOGNISED
   >>>;
 }  // namespace policy
 
+namespace detail
+{
+  // Policies chosen by default_policy are rebound by choosing again for the new types
+  template <class T0, class EC, class E, class T> struct rebind_policy_value<policy::error_code_throw_as_system_error<T0, EC, E>, T>
+  {
+    using type = policy::default_policy<T, EC, E>;
+  };
+  template <class T0, class EC, class E, class T> struct rebind_policy_value<policy::exception_ptr_rethrow<T0, EC, E>, T>
+  {
+    using type = policy::default_policy<T, EC, E>;
+  };
+  template <class T, class EC0, class E, class EC> struct rebind_policy_error<policy::error_code_throw_as_system_error<T, EC0, E>, EC>
+  {
+    using type = policy::default_policy<T, EC, E>;
+  };
+  template <class T, class EC0, class E, class EC> struct rebind_policy_error<policy::exception_ptr_rethrow<T, EC0, E>, EC>
+  {
+    using type = policy::default_policy<T, EC, E>;
+  };
+}  // namespace detail
+
 /*! AWAITING HUGO JSON CONVERSION TOOL 
 SIGNATURE NOT RECOGNISED
 */
@@ -44,7 +44,7 @@ template <class T> struct BOOST_OUTCOME_NODISCARD success_type
 
 private:
   value_type _value;
-  uint16_t _spare_storage{0};
+  spare_storage_type _spare_storage{0};
 
 public:
   success_type() = default;
@@ -55,7 +55,7 @@ public:
   ~success_type() = default;
   BOOST_OUTCOME_TEMPLATE(class U)
   BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(!std::is_same<success_type, std::decay_t<U>>::value))
-  constexpr explicit success_type(U &&v, uint16_t spare_storage = 0)
+  constexpr explicit success_type(U &&v, spare_storage_type spare_storage = 0)
       : _value(static_cast<U &&>(v))  // NOLINT
       , _spare_storage(spare_storage)
   {
@@ -66,13 +66,13 @@ public:
   constexpr value_type &&value() && { return static_cast<value_type &&>(_value); }
   constexpr const value_type &&value() const && { return static_cast<value_type &&>(_value); }
 
-  constexpr uint16_t spare_storage() const { return _spare_storage; }
+  constexpr spare_storage_type spare_storage() const { return _spare_storage; }
 };
 template <> struct BOOST_OUTCOME_NODISCARD success_type<void>
 {
   using value_type = void;
 
-  constexpr uint16_t spare_storage() const { return 0; }
+  constexpr spare_storage_type spare_storage() const { return 0; }
 };
 /*! Returns type sugar for implicitly constructing a `basic_result<T>` with a successful state,
 default constructing `T` if necessary.
@@ -86,7 +86,7 @@ inline constexpr success_type<void> success() noexcept
 */
 BOOST_OUTCOME_TEMPLATE(class T)
 BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(std::is_copy_constructible<T>::value))
-inline constexpr success_type<std::decay_t<T>> success(const T &v, uint16_t spare_storage = 0)
+inline constexpr success_type<std::decay_t<T>> success(const T &v, spare_storage_type spare_storage = 0)
 {
   return success_type<std::decay_t<T>>{v, spare_storage};
 }
@@ -95,7 +95,7 @@ inline constexpr success_type<std::decay_t<T>> success(const T &v, uint16_t spar
 */
 BOOST_OUTCOME_TEMPLATE(class T)
 BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(std::is_move_constructible<T>::value))
-inline constexpr success_type<std::decay_t<T>> success(T &&v, uint16_t spare_storage = 0)
+inline constexpr success_type<std::decay_t<T>> success(T &&v, spare_storage_type spare_storage = 0)
 {
   return success_type<std::decay_t<T>>{static_cast<T &&>(v), spare_storage};
 }
@@ -112,7 +112,7 @@ private:
   error_type _error;
   exception_type _exception;
   bool _have_error{false}, _have_exception{false};
-  uint16_t _spare_storage{0};
+  spare_storage_type _spare_storage{0};
 
   struct error_init_tag
   {
@@ -129,7 +129,7 @@ public:
   failure_type &operator=(failure_type &&) = default;  // NOLINT
   ~failure_type() = default;
   template <class U, class V>
-  constexpr explicit failure_type(U &&u, V &&v, uint16_t spare_storage = 0)
+  constexpr explicit failure_type(U &&u, V &&v, spare_storage_type spare_storage = 0)
       : _error(static_cast<U &&>(u))
       , _exception(static_cast<V &&>(v))
       , _have_error(true)
@@ -138,7 +138,7 @@ public:
   {
   }
   template <class U>
-  constexpr explicit failure_type(in_place_type_t<error_type> /*unused*/, U &&u, uint16_t spare_storage = 0, error_init_tag /*unused*/ = error_init_tag())
+  constexpr explicit failure_type(in_place_type_t<error_type> /*unused*/, U &&u, spare_storage_type spare_storage = 0, error_init_tag /*unused*/ = error_init_tag())
       : _error(static_cast<U &&>(u))
       , _exception()
       , _have_error(true)
@@ -146,7 +146,7 @@ public:
   {
   }
   template <class U>
-  constexpr explicit failure_type(in_place_type_t<exception_type> /*unused*/, U &&u, uint16_t spare_storage = 0,
+  constexpr explicit failure_type(in_place_type_t<exception_type> /*unused*/, U &&u, spare_storage_type spare_storage = 0,
                                   exception_init_tag /*unused*/ = exception_init_tag())
       : _error()
       , _exception(static_cast<U &&>(u))
@@ -168,7 +168,8 @@ public:
   constexpr exception_type &&exception() && { return static_cast<exception_type &&>(_exception); }
   constexpr const exception_type &&exception() const && { return static_cast<exception_type &&>(_exception); }
 
-  constexpr uint16_t spare_storage() const { return _spare_storage; }
+  constexpr spare_storage_type spare_storage() const { return _spare_storage; }
+  constexpr void set_spare_storage(spare_storage_type v) noexcept { _spare_storage = v; }
 };
 template <class EC> struct BOOST_OUTCOME_NODISCARD failure_type<EC, void>
 {
@@ -177,7 +178,7 @@ template <class EC> struct BOOST_OUTCOME_NODISCARD failure_type<EC, void>
 
 private:
   error_type _error;
-  uint16_t _spare_storage{0};
+  spare_storage_type _spare_storage{0};
 
 public:
   failure_type() = default;
@@ -188,7 +189,7 @@ public:
   ~failure_type() = default;
   BOOST_OUTCOME_TEMPLATE(class U)
   BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(!std::is_same<failure_type, std::decay_t<U>>::value))
-  constexpr explicit failure_type(U &&u, uint16_t spare_storage = 0)
+  constexpr explicit failure_type(U &&u, spare_storage_type spare_storage = 0)
       : _error(static_cast<U &&>(u))  // NOLINT
       , _spare_storage(spare_storage)
   {
@@ -199,7 +200,8 @@ public:
   constexpr error_type &&error() && { return static_cast<error_type &&>(_error); }
   constexpr const error_type &&error() const && { return static_cast<error_type &&>(_error); }
 
-  constexpr uint16_t spare_storage() const { return _spare_storage; }
+  constexpr spare_storage_type spare_storage() const { return _spare_storage; }
+  constexpr void set_spare_storage(spare_storage_type v) noexcept { _spare_storage = v; }
 };
 template <class E> struct BOOST_OUTCOME_NODISCARD failure_type<void, E>
 {
@@ -208,7 +210,7 @@ template <class E> struct BOOST_OUTCOME_NODISCARD failure_type<void, E>
 
 private:
   exception_type _exception;
-  uint16_t _spare_storage{0};
+  spare_storage_type _spare_storage{0};
 
 public:
   failure_type() = default;
@@ -219,7 +221,7 @@ public:
   ~failure_type() = default;
   BOOST_OUTCOME_TEMPLATE(class V)
   BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(!std::is_same<failure_type, std::decay_t<V>>::value))
-  constexpr explicit failure_type(V &&v, uint16_t spare_storage = 0)
+  constexpr explicit failure_type(V &&v, spare_storage_type spare_storage = 0)
       : _exception(static_cast<V &&>(v))  // NOLINT
       , _spare_storage(spare_storage)
   {
@@ -230,14 +232,15 @@ public:
   constexpr exception_type &&exception() && { return static_cast<exception_type &&>(_exception); }
   constexpr const exception_type &&exception() const && { return static_cast<exception_type &&>(_exception); }
 
-  constexpr uint16_t spare_storage() const { return _spare_storage; }
+  constexpr spare_storage_type spare_storage() const { return _spare_storage; }
+  constexpr void set_spare_storage(spare_storage_type v) noexcept { _spare_storage = v; }
 };
 /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
 */
 BOOST_OUTCOME_TEMPLATE(class EC)
 BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(std::is_copy_constructible<EC>::value))
-inline constexpr failure_type<std::decay_t<EC>> failure(const EC &v, uint16_t spare_storage = 0)
+inline constexpr failure_type<std::decay_t<EC>> failure(const EC &v, spare_storage_type spare_storage = 0)
 {
   return failure_type<std::decay_t<EC>>{v, spare_storage};
 }
@@ -246,7 +249,7 @@ SIGNATURE NOT RECOGNISED
 */
 BOOST_OUTCOME_TEMPLATE(class EC)
 BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(std::is_move_constructible<EC>::value))
-inline constexpr failure_type<std::decay_t<EC>> failure(EC &&v, uint16_t spare_storage = 0)
+inline constexpr failure_type<std::decay_t<EC>> failure(EC &&v, spare_storage_type spare_storage = 0)
 {
   return failure_type<std::decay_t<EC>>{static_cast<EC &&>(v), spare_storage};
 }
@@ -255,7 +258,7 @@ SIGNATURE NOT RECOGNISED
 */
 BOOST_OUTCOME_TEMPLATE(class EC, class E)
 BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(std::is_copy_constructible<EC>::value &&std::is_copy_constructible<E>::value))
-inline constexpr failure_type<std::decay_t<EC>, std::decay_t<E>> failure(const EC &v, const E &w, uint16_t spare_storage = 0)
+inline constexpr failure_type<std::decay_t<EC>, std::decay_t<E>> failure(const EC &v, const E &w, spare_storage_type spare_storage = 0)
 {
   return failure_type<std::decay_t<EC>, std::decay_t<E>>{v, w, spare_storage};
 }
@@ -264,7 +267,7 @@ SIGNATURE NOT RECOGNISED
 */
 BOOST_OUTCOME_TEMPLATE(class EC, class E)
 BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(std::is_copy_constructible<EC>::value &&std::is_move_constructible<E>::value))
-inline constexpr failure_type<std::decay_t<EC>, std::decay_t<E>> failure(const EC &v, E &&w, uint16_t spare_storage = 0)
+inline constexpr failure_type<std::decay_t<EC>, std::decay_t<E>> failure(const EC &v, E &&w, spare_storage_type spare_storage = 0)
 {
   return failure_type<std::decay_t<EC>, std::decay_t<E>>{v, static_cast<E &&>(w), spare_storage};
 }
@@ -273,7 +276,7 @@ SIGNATURE NOT RECOGNISED
 */
 BOOST_OUTCOME_TEMPLATE(class EC, class E)
 BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(std::is_move_constructible<EC>::value &&std::is_copy_constructible<E>::value))
-inline constexpr failure_type<std::decay_t<EC>, std::decay_t<E>> failure(EC &&v, const E &w, uint16_t spare_storage = 0)
+inline constexpr failure_type<std::decay_t<EC>, std::decay_t<E>> failure(EC &&v, const E &w, spare_storage_type spare_storage = 0)
 {
   return failure_type<std::decay_t<EC>, std::decay_t<E>>{static_cast<EC &&>(v), w, spare_storage};
 }
@@ -282,7 +285,7 @@ SIGNATURE NOT RECOGNISED
 */
 BOOST_OUTCOME_TEMPLATE(class EC, class E)
 BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(std::is_move_constructible<EC>::value &&std::is_move_constructible<E>::value))
-inline constexpr failure_type<std::decay_t<EC>, std::decay_t<E>> failure(EC &&v, E &&w, uint16_t spare_storage = 0)
+inline constexpr failure_type<std::decay_t<EC>, std::decay_t<E>> failure(EC &&v, E &&w, spare_storage_type spare_storage = 0)
 {
   return failure_type<std::decay_t<EC>, std::decay_t<E>>{static_cast<EC &&>(v), static_cast<E &&>(w), spare_storage};
 }
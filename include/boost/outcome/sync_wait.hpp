@@ -0,0 +1,164 @@
+/* Beginning Outcome's awaitables upon an executor, and blocking until they complete
+(C) 2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2024
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef BOOST_OUTCOME_SYNC_WAIT_HPP
+#define BOOST_OUTCOME_SYNC_WAIT_HPP
+
+#include "coroutine_support.hpp"
+
+#ifdef BOOST_OUTCOME_FOUND_COROUTINE_HEADER
+
+#include <condition_variable>
+#include <exception>  // for std::exception_ptr
+#include <mutex>
+
+BOOST_OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+namespace awaitables
+{
+  namespace detail
+  {
+    class sync_wait_state
+    {
+      std::mutex _lock;
+      std::condition_variable _changed;
+      bool _done{false};
+
+    public:
+      void set()
+      {
+        std::lock_guard<std::mutex> g(_lock);
+        _done = true;
+        _changed.notify_one();
+      }
+      void wait()
+      {
+        std::unique_lock<std::mutex> g(_lock);
+        while(!_done)
+        {
+          _changed.wait(g);
+        }
+      }
+    };
+
+    // Awaits an awaitable, leaving its result within it for the blocked thread to take
+    template <class Awaitable> struct sync_wait_awaiter
+    {
+      Awaitable &awaitable;
+
+      bool await_ready() { return awaitable.await_ready(); }
+      template <class P> decltype(auto) await_suspend(coroutine_handle<P> h) { return awaitable.await_suspend(h); }
+      void await_resume() noexcept {}
+    };
+
+    // A coroutine which tells the blocked thread once what it awaits has completed
+    struct sync_waiter
+    {
+      class promise_type : public promise_frame_allocation
+      {
+        friend struct sync_waiter;
+        sync_wait_state *_state{nullptr};
+#ifndef BOOST_NO_EXCEPTIONS
+        std::exception_ptr _exception;
+#endif
+
+      public:
+        sync_waiter get_return_object() noexcept { return sync_waiter{coroutine_handle<promise_type>::from_promise(*this)}; }
+        suspend_always initial_suspend() noexcept { return {}; }
+        auto final_suspend() noexcept
+        {
+          struct awaiter
+          {
+            bool await_ready() noexcept { return false; }
+            void await_resume() noexcept {}
+            // The blocked thread destroys this coroutine as soon as it is told
+            void await_suspend(coroutine_handle<promise_type> h) noexcept { h.promise()._state->set(); }
+          };
+          return awaiter{};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept
+        {
+#ifndef BOOST_NO_EXCEPTIONS
+          _exception = std::current_exception();
+#else
+          std::terminate();
+#endif
+        }
+      };
+      coroutine_handle<promise_type> _h;
+
+      explicit sync_waiter(coroutine_handle<promise_type> h) noexcept
+          : _h(h)
+      {
+      }
+      sync_waiter(const sync_waiter &) = delete;
+      sync_waiter &operator=(const sync_waiter &) = delete;
+      ~sync_waiter() { _h.destroy(); }
+
+      void run(sync_wait_state &state)
+      {
+        _h.promise()._state = &state;
+        _h.resume();
+        state.wait();
+#ifndef BOOST_NO_EXCEPTIONS
+        if(_h.promise()._exception)
+        {
+          std::rethrow_exception(_h.promise()._exception);
+        }
+#endif
+      }
+    };
+    template <class Awaitable> inline sync_waiter sync_wait_for(Awaitable &a) { co_await sync_wait_awaiter<Awaitable>{a}; }
+  }  // namespace detail
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class Awaitable> inline auto sync_wait(Awaitable &&a)
+  {
+    detail::sync_wait_state state;
+    detail::sync_wait_for(a).run(state);
+    return a.await_resume();
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class Executor, class T, class E, bool use_atomic>
+  inline detail::awaitable<T, Executor, false, true> spawn(Executor ex, detail::awaitable<T, E, true, use_atomic> task)
+  {
+    (void) ex;  // captured by the promise, which begins this upon it
+    co_return co_await task;
+  }
+}  // namespace awaitables
+BOOST_OUTCOME_V2_NAMESPACE_END
+
+#endif
+#endif
@@ -0,0 +1,160 @@
+/* A simple thread pool executor for Outcome's awaitables
+(C) 2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2024
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef BOOST_OUTCOME_THREAD_POOL_HPP
+#define BOOST_OUTCOME_THREAD_POOL_HPP
+
+#include "coroutine_support.hpp"
+
+#ifdef BOOST_OUTCOME_FOUND_COROUTINE_HEADER
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+BOOST_OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+namespace awaitables
+{
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+type definition thread_pool. Potential doc page: `thread_pool`
+*/
+  class thread_pool
+  {
+    std::mutex _lock;
+    std::condition_variable _changed;
+    std::deque<coroutine_handle<>> _queue;
+    std::vector<std::thread> _threads;
+    bool _stopping{false};
+
+    static thread_pool *&_current() noexcept
+    {
+      static BOOST_OUTCOME_THREAD_LOCAL thread_pool *v;
+      return v;
+    }
+    void _run()
+    {
+      _current() = this;
+      std::unique_lock<std::mutex> g(_lock);
+      for(;;)
+      {
+        while(_queue.empty() && !_stopping)
+        {
+          _changed.wait(g);
+        }
+        // Work queued before stopping is still done
+        if(_queue.empty())
+        {
+          break;
+        }
+        auto h = _queue.front();
+        _queue.pop_front();
+        g.unlock();
+        h.resume();
+        g.lock();
+      }
+      _current() = nullptr;
+    }
+
+  public:
+    //! The executor to give to awaitables, which resumes them upon this pool.
+    class executor_type
+    {
+      friend class thread_pool;
+      thread_pool *_pool{nullptr};
+
+      explicit executor_type(thread_pool *pool) noexcept
+          : _pool(pool)
+      {
+      }
+
+    public:
+      //! Queues `h` for resumption by a thread of the pool.
+      void post(coroutine_handle<> h) const { _pool->post(h); }
+      //! True if the calling thread is one of the pool's.
+      bool running_in_this_thread() const noexcept { return _current() == _pool; }
+      //! The pool.
+      thread_pool &context() const noexcept { return *_pool; }
+
+      friend bool operator==(const executor_type &a, const executor_type &b) noexcept { return a._pool == b._pool; }
+      friend bool operator!=(const executor_type &a, const executor_type &b) noexcept { return a._pool != b._pool; }
+    };
+
+    //! Starts `threads` threads, by default one per hardware thread.
+    explicit thread_pool(size_t threads = std::thread::hardware_concurrency())
+    {
+      if(threads == 0)
+      {
+        threads = 1;
+      }
+      _threads.reserve(threads);
+      for(size_t n = 0; n < threads; n++)
+      {
+        _threads.emplace_back([this] { _run(); });
+      }
+    }
+    thread_pool(const thread_pool &) = delete;
+    thread_pool(thread_pool &&) = delete;
+    thread_pool &operator=(const thread_pool &) = delete;
+    thread_pool &operator=(thread_pool &&) = delete;
+    //! Resumes everything already queued, then joins the threads.
+    ~thread_pool()
+    {
+      {
+        std::lock_guard<std::mutex> g(_lock);
+        _stopping = true;
+      }
+      _changed.notify_all();
+      for(auto &t : _threads)
+      {
+        t.join();
+      }
+    }
+
+    //! The executor of this pool.
+    executor_type get_executor() noexcept { return executor_type(this); }
+    //! The number of threads in this pool.
+    size_t size() const noexcept { return _threads.size(); }
+    //! Queues `h` for resumption by a thread of the pool.
+    void post(coroutine_handle<> h)
+    {
+      {
+        std::lock_guard<std::mutex> g(_lock);
+        _queue.push_back(h);
+      }
+      _changed.notify_one();
+    }
+  };
+}  // namespace awaitables
+BOOST_OUTCOME_V2_NAMESPACE_END
+
+#endif
+#endif
@@ -59,6 +59,38 @@ type definition  is_error_type. Potential doc page: NOT FOUND
     static constexpr bool value = false;
   };
 
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+type definition  has_niche. Potential doc page: `has_niche<T>`
+*/
+  template <class T> struct has_niche
+  {
+    static constexpr bool value = false;
+  };
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+type definition  is_trivially_relocatable. Potential doc page: `is_trivially_relocatable<T>`
+*/
+  template <class T> struct is_trivially_relocatable
+  {
+    static constexpr bool value = std::is_trivially_copyable<T>::value || is_move_bitcopying<T>::value
+#ifdef __has_builtin
+#if __has_builtin(__builtin_is_cpp_trivially_relocatable)
+                                  || __builtin_is_cpp_trivially_relocatable(T)
+#elif __has_builtin(__is_trivially_relocatable)
+                                  || __is_trivially_relocatable(T)
+#endif
+#endif
+    ;
+  };
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+type definition  is_failure_exception_cached. Potential doc page: `is_failure_exception_cached<E>`
+*/
+  template <class E> struct is_failure_exception_cached
+  {
+    static constexpr bool value = false;
+  };
+
   /*! AWAITING HUGO JSON CONVERSION TOOL
 type definition  is_error_type. Potential doc page: NOT FOUND
 */
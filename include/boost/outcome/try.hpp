@@ -33,6 +33,13 @@ DEALINGS IN THE SOFTWARE.
 
 #include "success_failure.hpp"
 
+#ifndef BOOST_OUTCOME_ENABLE_ERROR_RETURN_TRACE
+#define BOOST_OUTCOME_ENABLE_ERROR_RETURN_TRACE 0
+#endif
+#if BOOST_OUTCOME_ENABLE_ERROR_RETURN_TRACE
+#include "error_return_trace.hpp"
+#endif
+
 BOOST_OUTCOME_V2_NAMESPACE_BEGIN
 
 namespace detail
@@ -138,6 +145,43 @@ constexpr inline decltype(auto) try_operation_extract_value(T &&v, detail::value
   return static_cast<T &&>(v).value();
 }
 
+#ifndef BOOST_OUTCOME_TRY_COLD
+#if defined(__GNUC__) || defined(__clang__)
+#define BOOST_OUTCOME_TRY_COLD __attribute__((cold, noinline))
+#elif defined(_MSC_VER)
+#define BOOST_OUTCOME_TRY_COLD __declspec(noinline)
+#else
+#define BOOST_OUTCOME_TRY_COLD
+#endif
+#endif
+
+namespace detail
+{
+  // Marks the input to a TRY whose failure is to be returned out of line
+  template <class T> struct try_operation_outlined
+  {
+    T &&v;
+  };
+  BOOST_OUTCOME_TEMPLATE(class T)
+  BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(has_as_failure<T>(5)))
+  constexpr inline try_operation_outlined<T> try_operation_outline(T &&v) noexcept { return {static_cast<T &&>(v)}; }
+  // Inputs using other customisation points are left as they are, so overloads are still found where the TRY is
+  BOOST_OUTCOME_TEMPLATE(class T)
+  BOOST_OUTCOME_TREQUIRES(BOOST_OUTCOME_TPRED(!has_as_failure<T>(5)))
+  constexpr inline T &&try_operation_outline(T &&v) noexcept { return static_cast<T &&>(v); }
+
+  // One of these per input type, kept away from the hot code of its callers
+  template <class T> BOOST_OUTCOME_TRY_COLD auto try_operation_return_as_cold(T &&v) { return static_cast<T &&>(v).as_failure(); }
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+template <class T> inline auto try_operation_return_as(detail::try_operation_outlined<T> &&v)
+{
+  return detail::try_operation_return_as_cold(static_cast<T &&>(v.v));
+}
+
 BOOST_OUTCOME_V2_NAMESPACE_END
 
 #if !defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 8
@@ -180,6 +224,23 @@ BOOST_OUTCOME_V2_NAMESPACE_END
 #endif
 #endif
 
+#ifndef BOOST_OUTCOME_TRY_RECORD_ERROR_RETURN
+#if BOOST_OUTCOME_ENABLE_ERROR_RETURN_TRACE
+#define BOOST_OUTCOME_TRY_RECORD_ERROR_RETURN(f) ::BOOST_OUTCOME_V2_NAMESPACE::detail::record_error_return(f, __FILE__, __LINE__)
+#else
+#define BOOST_OUTCOME_TRY_RECORD_ERROR_RETURN(f)
+#endif
+#endif
+
+#ifndef BOOST_OUTCOME_TRY_OUTLINE_FAILURE
+#define BOOST_OUTCOME_TRY_OUTLINE_FAILURE 0
+#endif
+#if BOOST_OUTCOME_TRY_OUTLINE_FAILURE
+#define BOOST_OUTCOME_TRY_FAILURE_OPERAND(...) ::BOOST_OUTCOME_V2_NAMESPACE::detail::try_operation_outline(__VA_ARGS__)
+#else
+#define BOOST_OUTCOME_TRY_FAILURE_OPERAND(...) __VA_ARGS__
+#endif
+
 #define BOOST_OUTCOME_TRYV2_UNIQUE_STORAGE_UNPACK(...) __VA_ARGS__
 #define BOOST_OUTCOME_TRYV2_UNIQUE_STORAGE_DEDUCE3(unique, ...) auto unique = (__VA_ARGS__)
 #define BOOST_OUTCOME_TRYV2_UNIQUE_STORAGE_DEDUCE2(x) x
@@ -200,14 +261,16 @@ BOOST_OUTCOME_V2_NAMESPACE_END
   BOOST_OUTCOME_TRY_LIKELY_IF(::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(unique));                                                                              \
   else                                                                                                                                                         \
   { /* works around ICE in GCC's coroutines implementation */                                                                                                  \
-    auto unique##_f(::BOOST_OUTCOME_V2_NAMESPACE::try_operation_return_as(static_cast<decltype(unique) &&>(unique)));                                                \
+    auto unique##_f(::BOOST_OUTCOME_V2_NAMESPACE::try_operation_return_as(BOOST_OUTCOME_TRY_FAILURE_OPERAND(static_cast<decltype(unique) &&>(unique))));                \
+    BOOST_OUTCOME_TRY_RECORD_ERROR_RETURN(unique##_f);                                                                                                               \
     retstmt unique##_f;                                                                                                                                        \
   }
 #define BOOST_OUTCOME_TRYV3_FAILURE_LIKELY(unique, retstmt, spec, ...)                                                                                               \
   BOOST_OUTCOME_TRYV2_UNIQUE_STORAGE(unique, spec, __VA_ARGS__);                                                                                                     \
   BOOST_OUTCOME_TRY_LIKELY_IF(!BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(unique))                                                                                \
   { /* works around ICE in GCC's coroutines implementation */                                                                                                  \
-    auto unique##_f(::BOOST_OUTCOME_V2_NAMESPACE::try_operation_return_as(static_cast<decltype(unique) &&>(unique)));                                                \
+    auto unique##_f(::BOOST_OUTCOME_V2_NAMESPACE::try_operation_return_as(BOOST_OUTCOME_TRY_FAILURE_OPERAND(static_cast<decltype(unique) &&>(unique))));                \
+    BOOST_OUTCOME_TRY_RECORD_ERROR_RETURN(unique##_f);                                                                                                               \
     retstmt unique##_f;                                                                                                                                        \
   }
 
@@ -354,6 +417,76 @@ SIGNATURE NOT RECOGNISED
 */
 #define BOOST_OUTCOME_CO_TRY_FAILURE_LIKELY(...) BOOST_OUTCOME_TRY_CALL_OVERLOAD(BOOST_OUTCOME_CO_TRY_FAILURE_LIKELY_INVOKE_TRY, __VA_ARGS__)
 
+#define BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(x, retstmt)                                                                                                        \
+  if(!::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(x))                                                                                                 \
+  {                                                                                                                                                             \
+    auto x##_f(::BOOST_OUTCOME_V2_NAMESPACE::try_operation_return_as(BOOST_OUTCOME_TRY_FAILURE_OPERAND(static_cast<decltype(x) &&>(x))));                       \
+    BOOST_OUTCOME_TRY_RECORD_ERROR_RETURN(x##_f);                                                                                                               \
+    retstmt x##_f;                                                                                                                                              \
+  }
+#define BOOST_OUTCOME_TRY_ALL_EVAL1(u, a0) auto u##_0 = (a0)
+#define BOOST_OUTCOME_TRY_ALL_EVAL2(u, a0, a1) auto u##_0 = (a0); auto u##_1 = (a1)
+#define BOOST_OUTCOME_TRY_ALL_EVAL3(u, a0, a1, a2) auto u##_0 = (a0); auto u##_1 = (a1); auto u##_2 = (a2)
+#define BOOST_OUTCOME_TRY_ALL_EVAL4(u, a0, a1, a2, a3) auto u##_0 = (a0); auto u##_1 = (a1); auto u##_2 = (a2); auto u##_3 = (a3)
+#define BOOST_OUTCOME_TRY_ALL_EVAL5(u, a0, a1, a2, a3, a4) auto u##_0 = (a0); auto u##_1 = (a1); auto u##_2 = (a2); auto u##_3 = (a3); auto u##_4 = (a4)
+#define BOOST_OUTCOME_TRY_ALL_EVAL6(u, a0, a1, a2, a3, a4, a5) auto u##_0 = (a0); auto u##_1 = (a1); auto u##_2 = (a2); auto u##_3 = (a3); auto u##_4 = (a4); auto u##_5 = (a5)
+#define BOOST_OUTCOME_TRY_ALL_EVAL7(u, a0, a1, a2, a3, a4, a5, a6) auto u##_0 = (a0); auto u##_1 = (a1); auto u##_2 = (a2); auto u##_3 = (a3); auto u##_4 = (a4); auto u##_5 = (a5); auto u##_6 = (a6)
+#define BOOST_OUTCOME_TRY_ALL_EVAL8(u, a0, a1, a2, a3, a4, a5, a6, a7) auto u##_0 = (a0); auto u##_1 = (a1); auto u##_2 = (a2); auto u##_3 = (a3); auto u##_4 = (a4); auto u##_5 = (a5); auto u##_6 = (a6); auto u##_7 = (a7)
+// Every awaitable is joined by a single co_await, so all run at once, and each result is then tested as BOOST_OUTCOME_TRY_ALL does
+#define BOOST_OUTCOME_CO_TRY_ALL_EVAL1(u, a0) auto u = co_await ::BOOST_OUTCOME_V2_NAMESPACE::awaitables::detail::when_all_results((a0)); auto &&u##_0 = ::std::get<0>(static_cast<decltype(u) &&>(u))
+#define BOOST_OUTCOME_CO_TRY_ALL_EVAL2(u, a0, a1) auto u = co_await ::BOOST_OUTCOME_V2_NAMESPACE::awaitables::detail::when_all_results((a0), (a1)); auto &&u##_0 = ::std::get<0>(static_cast<decltype(u) &&>(u)); auto &&u##_1 = ::std::get<1>(static_cast<decltype(u) &&>(u))
+#define BOOST_OUTCOME_CO_TRY_ALL_EVAL3(u, a0, a1, a2) auto u = co_await ::BOOST_OUTCOME_V2_NAMESPACE::awaitables::detail::when_all_results((a0), (a1), (a2)); auto &&u##_0 = ::std::get<0>(static_cast<decltype(u) &&>(u)); auto &&u##_1 = ::std::get<1>(static_cast<decltype(u) &&>(u)); auto &&u##_2 = ::std::get<2>(static_cast<decltype(u) &&>(u))
+#define BOOST_OUTCOME_CO_TRY_ALL_EVAL4(u, a0, a1, a2, a3) auto u = co_await ::BOOST_OUTCOME_V2_NAMESPACE::awaitables::detail::when_all_results((a0), (a1), (a2), (a3)); auto &&u##_0 = ::std::get<0>(static_cast<decltype(u) &&>(u)); auto &&u##_1 = ::std::get<1>(static_cast<decltype(u) &&>(u)); auto &&u##_2 = ::std::get<2>(static_cast<decltype(u) &&>(u)); auto &&u##_3 = ::std::get<3>(static_cast<decltype(u) &&>(u))
+#define BOOST_OUTCOME_CO_TRY_ALL_EVAL5(u, a0, a1, a2, a3, a4) auto u = co_await ::BOOST_OUTCOME_V2_NAMESPACE::awaitables::detail::when_all_results((a0), (a1), (a2), (a3), (a4)); auto &&u##_0 = ::std::get<0>(static_cast<decltype(u) &&>(u)); auto &&u##_1 = ::std::get<1>(static_cast<decltype(u) &&>(u)); auto &&u##_2 = ::std::get<2>(static_cast<decltype(u) &&>(u)); auto &&u##_3 = ::std::get<3>(static_cast<decltype(u) &&>(u)); auto &&u##_4 = ::std::get<4>(static_cast<decltype(u) &&>(u))
+#define BOOST_OUTCOME_CO_TRY_ALL_EVAL6(u, a0, a1, a2, a3, a4, a5) auto u = co_await ::BOOST_OUTCOME_V2_NAMESPACE::awaitables::detail::when_all_results((a0), (a1), (a2), (a3), (a4), (a5)); auto &&u##_0 = ::std::get<0>(static_cast<decltype(u) &&>(u)); auto &&u##_1 = ::std::get<1>(static_cast<decltype(u) &&>(u)); auto &&u##_2 = ::std::get<2>(static_cast<decltype(u) &&>(u)); auto &&u##_3 = ::std::get<3>(static_cast<decltype(u) &&>(u)); auto &&u##_4 = ::std::get<4>(static_cast<decltype(u) &&>(u)); auto &&u##_5 = ::std::get<5>(static_cast<decltype(u) &&>(u))
+#define BOOST_OUTCOME_CO_TRY_ALL_EVAL7(u, a0, a1, a2, a3, a4, a5, a6) auto u = co_await ::BOOST_OUTCOME_V2_NAMESPACE::awaitables::detail::when_all_results((a0), (a1), (a2), (a3), (a4), (a5), (a6)); auto &&u##_0 = ::std::get<0>(static_cast<decltype(u) &&>(u)); auto &&u##_1 = ::std::get<1>(static_cast<decltype(u) &&>(u)); auto &&u##_2 = ::std::get<2>(static_cast<decltype(u) &&>(u)); auto &&u##_3 = ::std::get<3>(static_cast<decltype(u) &&>(u)); auto &&u##_4 = ::std::get<4>(static_cast<decltype(u) &&>(u)); auto &&u##_5 = ::std::get<5>(static_cast<decltype(u) &&>(u)); auto &&u##_6 = ::std::get<6>(static_cast<decltype(u) &&>(u))
+#define BOOST_OUTCOME_CO_TRY_ALL_EVAL8(u, a0, a1, a2, a3, a4, a5, a6, a7) auto u = co_await ::BOOST_OUTCOME_V2_NAMESPACE::awaitables::detail::when_all_results((a0), (a1), (a2), (a3), (a4), (a5), (a6), (a7)); auto &&u##_0 = ::std::get<0>(static_cast<decltype(u) &&>(u)); auto &&u##_1 = ::std::get<1>(static_cast<decltype(u) &&>(u)); auto &&u##_2 = ::std::get<2>(static_cast<decltype(u) &&>(u)); auto &&u##_3 = ::std::get<3>(static_cast<decltype(u) &&>(u)); auto &&u##_4 = ::std::get<4>(static_cast<decltype(u) &&>(u)); auto &&u##_5 = ::std::get<5>(static_cast<decltype(u) &&>(u)); auto &&u##_6 = ::std::get<6>(static_cast<decltype(u) &&>(u)); auto &&u##_7 = ::std::get<7>(static_cast<decltype(u) &&>(u))
+#define BOOST_OUTCOME_TRY_ALL_HAS_VALUE1(u) ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_0)
+#define BOOST_OUTCOME_TRY_ALL_HAS_VALUE2(u) ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_0) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_1)
+#define BOOST_OUTCOME_TRY_ALL_HAS_VALUE3(u) ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_0) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_1) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_2)
+#define BOOST_OUTCOME_TRY_ALL_HAS_VALUE4(u) ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_0) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_1) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_2) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_3)
+#define BOOST_OUTCOME_TRY_ALL_HAS_VALUE5(u) ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_0) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_1) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_2) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_3) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_4)
+#define BOOST_OUTCOME_TRY_ALL_HAS_VALUE6(u) ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_0) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_1) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_2) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_3) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_4) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_5)
+#define BOOST_OUTCOME_TRY_ALL_HAS_VALUE7(u) ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_0) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_1) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_2) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_3) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_4) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_5) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_6)
+#define BOOST_OUTCOME_TRY_ALL_HAS_VALUE8(u) ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_0) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_1) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_2) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_3) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_4) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_5) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_6) && ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_has_value(u##_7)
+#define BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE1(u, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_0, retstmt)
+#define BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE2(u, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_0, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_1, retstmt)
+#define BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE3(u, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_0, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_1, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_2, retstmt)
+#define BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE4(u, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_0, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_1, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_2, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_3, retstmt)
+#define BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE5(u, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_0, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_1, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_2, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_3, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_4, retstmt)
+#define BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE6(u, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_0, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_1, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_2, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_3, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_4, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_5, retstmt)
+#define BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE7(u, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_0, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_1, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_2, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_3, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_4, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_5, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_6, retstmt)
+#define BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE8(u, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_0, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_1, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_2, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_3, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_4, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_5, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_6, retstmt) BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE(u##_7, retstmt)
+#define BOOST_OUTCOME_TRY_ALL_BIND1(u, v0) v0 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_0) &&>(u##_0))
+#define BOOST_OUTCOME_TRY_ALL_BIND2(u, v0, v1) v0 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_0) &&>(u##_0)); v1 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_1) &&>(u##_1))
+#define BOOST_OUTCOME_TRY_ALL_BIND3(u, v0, v1, v2) v0 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_0) &&>(u##_0)); v1 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_1) &&>(u##_1)); v2 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_2) &&>(u##_2))
+#define BOOST_OUTCOME_TRY_ALL_BIND4(u, v0, v1, v2, v3) v0 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_0) &&>(u##_0)); v1 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_1) &&>(u##_1)); v2 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_2) &&>(u##_2)); v3 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_3) &&>(u##_3))
+#define BOOST_OUTCOME_TRY_ALL_BIND5(u, v0, v1, v2, v3, v4) v0 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_0) &&>(u##_0)); v1 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_1) &&>(u##_1)); v2 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_2) &&>(u##_2)); v3 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_3) &&>(u##_3)); v4 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_4) &&>(u##_4))
+#define BOOST_OUTCOME_TRY_ALL_BIND6(u, v0, v1, v2, v3, v4, v5) v0 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_0) &&>(u##_0)); v1 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_1) &&>(u##_1)); v2 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_2) &&>(u##_2)); v3 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_3) &&>(u##_3)); v4 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_4) &&>(u##_4)); v5 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_5) &&>(u##_5))
+#define BOOST_OUTCOME_TRY_ALL_BIND7(u, v0, v1, v2, v3, v4, v5, v6) v0 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_0) &&>(u##_0)); v1 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_1) &&>(u##_1)); v2 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_2) &&>(u##_2)); v3 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_3) &&>(u##_3)); v4 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_4) &&>(u##_4)); v5 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_5) &&>(u##_5)); v6 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_6) &&>(u##_6))
+#define BOOST_OUTCOME_TRY_ALL_BIND8(u, v0, v1, v2, v3, v4, v5, v6, v7) v0 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_0) &&>(u##_0)); v1 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_1) &&>(u##_1)); v2 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_2) &&>(u##_2)); v3 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_3) &&>(u##_3)); v4 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_4) &&>(u##_4)); v5 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_5) &&>(u##_5)); v6 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_6) &&>(u##_6)); v7 = ::BOOST_OUTCOME_V2_NAMESPACE::try_operation_extract_value(static_cast<decltype(u##_7) &&>(u##_7))
+#define BOOST_OUTCOME_TRY_ALL_CALL(name, count, ...) BOOST_OUTCOME_TRY_OVERLOAD_GLUE(BOOST_OUTCOME_TRY_OVERLOAD_MACRO(name, count), (__VA_ARGS__))
+// All operands are evaluated, then a single branch tests for all having succeeded, else the first failure in order is returned
+#define BOOST_OUTCOME_TRY_ALL2(unique, retstmt, eval, count, vars, ...)                                                                                         \
+  BOOST_OUTCOME_TRY_ALL_CALL(eval, count, unique, __VA_ARGS__);                                                                                                 \
+  BOOST_OUTCOME_TRY_LIKELY_IF(BOOST_OUTCOME_TRY_ALL_CALL(BOOST_OUTCOME_TRY_ALL_HAS_VALUE, count, unique));                                                      \
+  else                                                                                                                                                          \
+  {                                                                                                                                                             \
+    BOOST_OUTCOME_TRY_ALL_CALL(BOOST_OUTCOME_TRY_ALL_RETURN_FAILURE, count, unique, retstmt)                                                                    \
+  }                                                                                                                                                             \
+  BOOST_OUTCOME_TRY_ALL_CALL(BOOST_OUTCOME_TRY_ALL_BIND, count, unique, BOOST_OUTCOME_TRYV2_UNIQUE_STORAGE_UNPACK vars)
+
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+#define BOOST_OUTCOME_TRY_ALL(vars, ...)                                                                                                                        \
+  BOOST_OUTCOME_TRY_ALL2(BOOST_OUTCOME_TRY_UNIQUE_NAME, return, BOOST_OUTCOME_TRY_ALL_EVAL, BOOST_OUTCOME_TRY_COUNT_ARGS_MAX8(__VA_ARGS__), vars, __VA_ARGS__)
+/*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+#define BOOST_OUTCOME_CO_TRY_ALL(vars, ...)                                                                                                                     \
+  BOOST_OUTCOME_TRY_ALL2(BOOST_OUTCOME_TRY_UNIQUE_NAME, co_return, BOOST_OUTCOME_CO_TRY_ALL_EVAL, BOOST_OUTCOME_TRY_COUNT_ARGS_MAX8(__VA_ARGS__), vars, __VA_ARGS__)
+
 
 /*! AWAITING HUGO JSON CONVERSION TOOL
 SIGNATURE NOT RECOGNISED
@@ -33,80 +33,196 @@ DEALINGS IN THE SOFTWARE.
 
 #include "config.hpp"
 
+#include "detail/per_thread_cache.hpp"
+
 #include <exception>
+#include <stdexcept>
 #include <string>
 #include <system_error>
+#include <typeinfo>
 
 BOOST_OUTCOME_V2_NAMESPACE_BEGIN
 
 #ifndef BOOST_NO_EXCEPTIONS
-/*! AWAITING HUGO JSON CONVERSION TOOL 
-SIGNATURE NOT RECOGNISED
-*/
-inline std::error_code error_from_exception(std::exception_ptr &&ep = std::current_exception(), std::error_code not_matched = std::make_error_code(std::errc::resource_unavailable_try_again)) noexcept
+#ifndef BOOST_OUTCOME_ERROR_FROM_EXCEPTION_USE_TYPE_DISPATCH
+#if defined(__GLIBCXX__) && (defined(__GXX_RTTI) || defined(__cpp_rtti))
+#define BOOST_OUTCOME_ERROR_FROM_EXCEPTION_USE_TYPE_DISPATCH 1
+#else
+#define BOOST_OUTCOME_ERROR_FROM_EXCEPTION_USE_TYPE_DISPATCH 0
+#endif
+#endif
+
+namespace detail
 {
-  if(!ep)
-  {
-    return {};
-  }
-  try
+  inline std::error_code error_from_exception_rethrow(std::exception_ptr &ep, std::error_code not_matched) noexcept
   {
-    std::rethrow_exception(ep);
+    try
+    {
+      std::rethrow_exception(ep);
+    }
+    catch(const std::invalid_argument & /*unused*/)
+    {
+      ep = std::exception_ptr();
+      return std::make_error_code(std::errc::invalid_argument);
+    }
+    catch(const std::domain_error & /*unused*/)
+    {
+      ep = std::exception_ptr();
+      return std::make_error_code(std::errc::argument_out_of_domain);
+    }
+    catch(const std::length_error & /*unused*/)
+    {
+      ep = std::exception_ptr();
+      return std::make_error_code(std::errc::argument_list_too_long);
+    }
+    catch(const std::out_of_range & /*unused*/)
+    {
+      ep = std::exception_ptr();
+      return std::make_error_code(std::errc::result_out_of_range);
+    }
+    catch(const std::logic_error & /*unused*/) /* base class for this group */
+    {
+      ep = std::exception_ptr();
+      return std::make_error_code(std::errc::invalid_argument);
+    }
+    catch(const std::system_error &e) /* also catches ios::failure */
+    {
+      ep = std::exception_ptr();
+      return e.code();
+    }
+    catch(const std::overflow_error & /*unused*/)
+    {
+      ep = std::exception_ptr();
+      return std::make_error_code(std::errc::value_too_large);
+    }
+    catch(const std::range_error & /*unused*/)
+    {
+      ep = std::exception_ptr();
+      return std::make_error_code(std::errc::result_out_of_range);
+    }
+    catch(const std::runtime_error & /*unused*/) /* base class for this group */
+    {
+      ep = std::exception_ptr();
+      return std::make_error_code(std::errc::resource_unavailable_try_again);
+    }
+    catch(const std::bad_alloc & /*unused*/)
+    {
+      ep = std::exception_ptr();
+      return std::make_error_code(std::errc::not_enough_memory);
+    }
+    catch(...)
+    {
+    }
+    return not_matched;
   }
-  catch(const std::invalid_argument & /*unused*/)
-  {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::invalid_argument);
-  }
-  catch(const std::domain_error & /*unused*/)
-  {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::argument_out_of_domain);
-  }
-  catch(const std::length_error & /*unused*/)
-  {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::argument_list_too_long);
-  }
-  catch(const std::out_of_range & /*unused*/)
-  {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::result_out_of_range);
-  }
-  catch(const std::logic_error & /*unused*/) /* base class for this group */
+
+#if BOOST_OUTCOME_ERROR_FROM_EXCEPTION_USE_TYPE_DISPATCH
+  /* Rather than rethrowing, which takes the unwinder's locks, ask the Itanium ABI which of the
+  catch clauses of error_from_exception_rethrow() would catch the thrown type, and remember the
+  answer per type. The order of this table must match those catch clauses.
+  */
+  struct error_from_exception_handler
   {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::invalid_argument);
-  }
-  catch(const std::system_error &e) /* also catches ios::failure */
+    const std::type_info *type;
+    std::errc code;
+  };
+  inline const error_from_exception_handler *error_from_exception_handlers() noexcept
   {
-    ep = std::exception_ptr();
-    return e.code();
+    static const error_from_exception_handler handlers[] = {
+    {&typeid(std::invalid_argument), std::errc::invalid_argument},                //
+    {&typeid(std::domain_error), std::errc::argument_out_of_domain},              //
+    {&typeid(std::length_error), std::errc::argument_list_too_long},              //
+    {&typeid(std::out_of_range), std::errc::result_out_of_range},                 //
+    {&typeid(std::logic_error), std::errc::invalid_argument},                     //
+    {&typeid(std::system_error), std::errc()},                                    // uses its code() instead
+    {&typeid(std::overflow_error), std::errc::value_too_large},                   //
+    {&typeid(std::range_error), std::errc::result_out_of_range},                  //
+    {&typeid(std::runtime_error), std::errc::resource_unavailable_try_again},     //
+    {&typeid(std::bad_alloc), std::errc::not_enough_memory},                      //
+    {nullptr, std::errc()}                                                        //
+    };
+    return handlers;
   }
-  catch(const std::overflow_error & /*unused*/)
-  {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::value_too_large);
-  }
-  catch(const std::range_error & /*unused*/)
+  static constexpr unsigned char error_from_exception_system_error_handler = 5;
+  static constexpr unsigned char error_from_exception_no_handler = 10;
+
+  inline unsigned char error_from_exception_classify(const std::type_info *type) noexcept
   {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::result_out_of_range);
+    struct cache_entry
+    {
+      const std::type_info *type;
+      unsigned char handler;
+    };
+    static thread_local boost::outcome_detail::per_thread_cache<cache_entry> cache;
+    auto &entry = cache.lookup(type);
+    if(entry.type != type)
+    {
+      auto *handlers = error_from_exception_handlers();
+      unsigned char n = 0;
+      for(; handlers[n].type != nullptr; n++)
+      {
+        void *obj = nullptr;
+        if(handlers[n].type->__do_catch(type, &obj, 1))
+        {
+          break;
+        }
+      }
+      entry.type = type;
+      entry.handler = n;
+    }
+    return entry.handler;
   }
-  catch(const std::runtime_error & /*unused*/) /* base class for this group */
+
+  // Returns false if the thrown type could not be determined
+  inline bool error_from_exception_dispatch(std::exception_ptr &ep, std::error_code not_matched, std::error_code &ret) noexcept
   {
+    const std::type_info *type = ep.__cxa_exception_type();
+    if(type == nullptr)
+    {
+      return false;
+    }
+    const unsigned char handler = error_from_exception_classify(type);
+    if(handler == error_from_exception_no_handler)
+    {
+      ret = not_matched;
+      return true;
+    }
+    if(handler == error_from_exception_system_error_handler)
+    {
+      void *obj = boost::outcome_detail::exception_ptr_object(ep);
+      if(!typeid(std::system_error).__do_catch(type, &obj, 1))
+      {
+        return false;
+      }
+      ret = static_cast<const std::system_error *>(obj)->code();
+    }
+    else
+    {
+      ret = std::make_error_code(error_from_exception_handlers()[handler].code);
+    }
     ep = std::exception_ptr();
-    return std::make_error_code(std::errc::resource_unavailable_try_again);
+    return true;
   }
-  catch(const std::bad_alloc & /*unused*/)
+#endif
+}  // namespace detail
+
+/*! AWAITING HUGO JSON CONVERSION TOOL 
+SIGNATURE NOT RECOGNISED
+*/
+inline std::error_code error_from_exception(std::exception_ptr &&ep = std::current_exception(), std::error_code not_matched = std::make_error_code(std::errc::resource_unavailable_try_again)) noexcept
+{
+  if(!ep)
   {
-    ep = std::exception_ptr();
-    return std::make_error_code(std::errc::not_enough_memory);
+    return {};
   }
-  catch(...)
+#if BOOST_OUTCOME_ERROR_FROM_EXCEPTION_USE_TYPE_DISPATCH
+  std::error_code ret;
+  if(detail::error_from_exception_dispatch(ep, not_matched, ret))
   {
+    return ret;
   }
-  return not_matched;
+#endif
+  return detail::error_from_exception_rethrow(ep, not_matched);
 }
 
 /*! AWAITING HUGO JSON CONVERSION TOOL 
@@ -0,0 +1,293 @@
+/* Awaiting several of Outcome's awaitables at once
+(C) 2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2024
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef BOOST_OUTCOME_WHEN_ALL_HPP
+#define BOOST_OUTCOME_WHEN_ALL_HPP
+
+#include "basic_outcome.hpp"
+#include "coroutine_support.hpp"
+
+#ifdef BOOST_OUTCOME_FOUND_COROUTINE_HEADER
+
+#include <algorithm>  // for std::min
+#include <exception>  // for std::terminate
+#include <thread>     // for std::this_thread::yield
+#include <tuple>
+#include <utility>
+
+BOOST_OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+namespace awaitables
+{
+  namespace detail
+  {
+    /* Begins or joins every awaitable at once. Their completions count down a single atomic, which
+    starts at the number of completions needed plus a guard worth more than all of them, so that
+    none can resume the awaiter before all have begun. Completions after the one needed count down
+    past zero, and wrap.
+    */
+    template <class... Awaitables> class counted_awaitables
+    {
+      static_assert(sizeof...(Awaitables) > 0, "at least one awaitable is required");
+      static_assert(((is_basic_result_v<typename Awaitables::container_type> || is_basic_outcome_v<typename Awaitables::container_type>) &&...),
+                    "every awaitable must be of a basic_result or basic_outcome");
+
+    protected:
+      static constexpr size_t _count = sizeof...(Awaitables);
+      std::tuple<Awaitables...> _children;
+      static constexpr size_t _guard = _count + 1;
+      std::atomic<size_t> _countdown{0};
+      size_t _completed_before{0};  // completed before being awaited, so did not count down
+      size_t _released{0};          // counted down by this once all had begun
+      bool _counted[_count]{};      // will count down upon completion
+      bool _begun{false};
+
+      template <size_t... I> bool _any_completed(std::index_sequence<I...> /*unused*/) { return (std::get<I>(_children).await_ready() || ...); }
+      template <size_t... I> bool _all_completed(std::index_sequence<I...> /*unused*/) { return (std::get<I>(_children).await_ready() && ...); }
+      // Returns whether the awaiter should be resumed straight away, after releasing the guard
+      template <class P, size_t... I> bool _begin(coroutine_handle<P> cont, size_t needed, std::index_sequence<I...> /*unused*/)  // could throw
+      {
+        _countdown.store(needed + _guard, std::memory_order_release);
+        _begun = true;
+        ((_counted[I] = std::get<I>(_children)._await_counted(cont, &_countdown), _completed_before += !_counted[I]), ...);
+        _released = _guard + (std::min)(_completed_before, needed);
+        return _countdown.fetch_sub(_released, std::memory_order_acq_rel) <= _released;
+      }
+      // Detaches those which have not completed, and waits for those which have to finish counting down
+      template <size_t... I> void _settle(size_t needed, std::index_sequence<I...> /*unused*/) noexcept
+      {
+        size_t counting = 0;
+        ((counting += (_counted[I] && !std::get<I>(_children)._detach())), ...);
+        const size_t settled = needed + _guard - _released - counting;
+        while(_countdown.load(std::memory_order_acquire) != settled)
+        {
+          std::this_thread::yield();
+        }
+      }
+
+      explicit counted_awaitables(Awaitables &&...aw)
+          : _children(static_cast<Awaitables &&>(aw)...)
+      {
+      }
+
+    public:
+#if BOOST_OUTCOME_HAVE_STOP_TOKEN
+      void _inherit_stop_token(const std::stop_token *t) noexcept
+      {
+        std::apply([t](auto &...child) { (child._inherit_stop_token(t), ...); }, _children);
+      }
+#endif
+      counted_awaitables(const counted_awaitables &) = delete;
+      counted_awaitables(counted_awaitables &&) = delete;
+      counted_awaitables &operator=(const counted_awaitables &) = delete;
+      counted_awaitables &operator=(counted_awaitables &&) = delete;
+    };
+
+    // Awaits every awaitable at once, returning each of their results in order
+    template <class... Awaitables> class BOOST_OUTCOME_NODISCARD when_all_results_awaitable : public counted_awaitables<Awaitables...>
+    {
+      using _base = counted_awaitables<Awaitables...>;
+
+    protected:
+      using _indices = std::index_sequence_for<Awaitables...>;
+
+    private:
+      template <size_t... I> std::tuple<typename Awaitables::container_type...> _resume(std::index_sequence<I...> /*unused*/)
+      {
+        // Braced initialisation fetches the results in order
+        return std::tuple<typename Awaitables::container_type...>{std::get<I>(this->_children).await_resume()...};
+      }
+
+    public:
+      using container_type = std::tuple<typename Awaitables::container_type...>;
+      using value_type = container_type;
+
+      explicit when_all_results_awaitable(Awaitables &&...aw)
+          : _base(static_cast<Awaitables &&>(aw)...)
+      {
+      }
+      ~when_all_results_awaitable()
+      {
+        if(this->_begun)
+        {
+          this->_settle(this->_count, _indices());
+        }
+      }
+
+      bool await_ready() noexcept { return this->_all_completed(_indices()); }
+      container_type await_resume() { return _resume(_indices()); }
+#if BOOST_OUTCOME_HAVE_NOOP_COROUTINE
+      template <class P = void> coroutine_handle<> await_suspend(coroutine_handle<P> cont)  // could throw
+      {
+        if(this->_begin(cont, this->_count, _indices()) && cont)
+        {
+          return cont;
+        }
+        return noop_coroutine();
+      }
+#else
+      template <class P = void> bool await_suspend(coroutine_handle<P> cont)  // could throw
+      {
+        return !this->_begin(cont, this->_count, _indices()) || !cont;
+      }
+#endif
+    };
+
+    // Used by BOOST_OUTCOME_CO_TRY_ALL, which tests each result itself
+    template <class... Awaitables> inline when_all_results_awaitable<Awaitables...> when_all_results(Awaitables... aw)
+    {
+      return when_all_results_awaitable<Awaitables...>(static_cast<Awaitables &&>(aw)...);
+    }
+
+    // Never invoked, this exists only to have transform() propagate a failure into a result of the tuple
+    template <class T> struct when_all_failure
+    {
+      template <class... Args> T operator()(Args &&... /*unused*/) const { std::terminate(); }
+    };
+
+    template <class... Awaitables> class BOOST_OUTCOME_NODISCARD when_all_awaitable : public when_all_results_awaitable<Awaitables...>
+    {
+      using _base = when_all_results_awaitable<Awaitables...>;
+      using _first_type = typename std::tuple_element<0, std::tuple<typename Awaitables::container_type...>>::type;
+      static_assert((!std::is_void<typename Awaitables::container_type::value_type>::value && ...),
+                    "when_all() requires awaitables of a basic_result or basic_outcome with a non-void value_type");
+
+    public:
+      using tuple_type = std::tuple<typename Awaitables::container_type::value_type...>;
+      using container_type = decltype(std::declval<_first_type &&>().transform(when_all_failure<tuple_type>()));
+      using value_type = container_type;
+
+    private:
+      template <size_t I, class Results> static container_type _first_failure(Results &results)
+      {
+        if constexpr(I + 1 < sizeof...(Awaitables))
+        {
+          if(std::get<I>(results).has_value())
+          {
+            return _first_failure<I + 1>(results);
+          }
+        }
+        return container_type(std::get<I>(static_cast<Results &&>(results)).as_failure());
+      }
+      template <size_t... I> container_type _resume(std::index_sequence<I...> /*unused*/)
+      {
+        auto results = _base::await_resume();
+        if((std::get<I>(results).has_value() && ...))
+        {
+          return container_type{in_place_type<tuple_type>, std::get<I>(static_cast<decltype(results) &&>(results)).assume_value()...};
+        }
+        return _first_failure<0>(results);
+      }
+
+    public:
+      explicit when_all_awaitable(Awaitables &&...aw)
+          : _base(static_cast<Awaitables &&>(aw)...)
+      {
+      }
+
+      container_type await_resume() { return _resume(typename _base::_indices()); }
+    };
+
+    template <class... Awaitables> class BOOST_OUTCOME_NODISCARD when_any_awaitable : public counted_awaitables<Awaitables...>
+    {
+      using _base = counted_awaitables<Awaitables...>;
+      using _indices = std::index_sequence_for<Awaitables...>;
+      using _first_type = typename std::tuple_element<0, std::tuple<typename Awaitables::container_type...>>::type;
+      static_assert((std::is_same<_first_type, typename Awaitables::container_type>::value && ...), "when_any() requires awaitables of the same type");
+
+    public:
+      using container_type = std::pair<size_t, _first_type>;
+      using value_type = container_type;
+
+    private:
+      template <size_t I> container_type _resume()
+      {
+        if constexpr(I + 1 < sizeof...(Awaitables))
+        {
+          if(!std::get<I>(this->_children).await_ready())
+          {
+            return _resume<I + 1>();
+          }
+        }
+        return container_type(I, std::get<I>(this->_children).await_resume());
+      }
+
+    public:
+      explicit when_any_awaitable(Awaitables &&...aw)
+          : _base(static_cast<Awaitables &&>(aw)...)
+      {
+      }
+      ~when_any_awaitable()
+      {
+        if(this->_begun)
+        {
+          this->_settle(1, _indices());
+        }
+      }
+
+      bool await_ready() noexcept { return this->_any_completed(_indices()); }
+      container_type await_resume() { return _resume<0>(); }
+#if BOOST_OUTCOME_HAVE_NOOP_COROUTINE
+      template <class P = void> coroutine_handle<> await_suspend(coroutine_handle<P> cont)  // could throw
+      {
+        if(this->_begin(cont, 1, _indices()) && cont)
+        {
+          return cont;
+        }
+        return noop_coroutine();
+      }
+#else
+      template <class P = void> bool await_suspend(coroutine_handle<P> cont)  // could throw
+      {
+        return !this->_begin(cont, 1, _indices()) || !cont;
+      }
+#endif
+    };
+  }  // namespace detail
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class... Awaitables> inline detail::when_all_awaitable<Awaitables...> when_all(Awaitables... aw)
+  {
+    return detail::when_all_awaitable<Awaitables...>(static_cast<Awaitables &&>(aw)...);
+  }
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+SIGNATURE NOT RECOGNISED
+*/
+  template <class... Awaitables> inline detail::when_any_awaitable<Awaitables...> when_any(Awaitables... aw)
+  {
+    return detail::when_any_awaitable<Awaitables...>(static_cast<Awaitables &&>(aw)...);
+  }
+}  // namespace awaitables
+BOOST_OUTCOME_V2_NAMESPACE_END
+
+#endif
+#endif
@@ -0,0 +1,363 @@
+/* A work stealing thread pool executor for Outcome's awaitables
+(C) 2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+File Created: Oct 2024
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef BOOST_OUTCOME_WORK_STEALING_POOL_HPP
+#define BOOST_OUTCOME_WORK_STEALING_POOL_HPP
+
+#include "coroutine_support.hpp"
+#include "sync_wait.hpp"
+
+#ifdef BOOST_OUTCOME_FOUND_COROUTINE_HEADER
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+BOOST_OUTCOME_V2_NAMESPACE_EXPORT_BEGIN
+namespace awaitables
+{
+  namespace detail
+  {
+    /* A Chase-Lev deque, as corrected for weak memory models by Le, Pop, Cohen and Zappa Nardelli
+    (2013). Only its owning thread pushes and pops at the bottom, any thread may steal from the top.
+    Arrays outgrown remain until the deque is destroyed, as stealers may still be reading them.
+    */
+    class work_stealing_deque
+    {
+      struct array
+      {
+        size_t mask;
+        std::unique_ptr<std::atomic<void *>[]> items;
+
+        explicit array(size_t capacity)
+            : mask(capacity - 1)
+            , items(new std::atomic<void *>[capacity])
+        {
+        }
+        void *get(ptrdiff_t i) const noexcept { return items[static_cast<size_t>(i) & mask].load(std::memory_order_relaxed); }
+        void put(ptrdiff_t i, void *v) noexcept { items[static_cast<size_t>(i) & mask].store(v, std::memory_order_relaxed); }
+      };
+
+      alignas(64) std::atomic<ptrdiff_t> _top{0};
+      alignas(64) std::atomic<ptrdiff_t> _bottom{0};
+      std::atomic<array *> _array{nullptr};
+      std::vector<std::unique_ptr<array>> _arrays;  // owner only
+
+    public:
+      work_stealing_deque()
+      {
+        _arrays.push_back(std::make_unique<array>(256));
+        _array.store(_arrays.back().get(), std::memory_order_relaxed);
+      }
+
+      // True if there may be something to steal
+      bool maybe_nonempty() const noexcept { return _bottom.load(std::memory_order_relaxed) > _top.load(std::memory_order_relaxed); }
+
+      void push(void *v)  // could throw
+      {
+        const auto b = _bottom.load(std::memory_order_relaxed);
+        const auto t = _top.load(std::memory_order_acquire);
+        auto *a = _array.load(std::memory_order_relaxed);
+        if(b - t > static_cast<ptrdiff_t>(a->mask))
+        {
+          auto bigger = std::make_unique<array>((a->mask + 1) * 2);
+          for(auto i = t; i < b; i++)
+          {
+            bigger->put(i, a->get(i));
+          }
+          a = bigger.get();
+          _arrays.push_back(static_cast<std::unique_ptr<array> &&>(bigger));
+          _array.store(a, std::memory_order_release);
+        }
+        a->put(b, v);
+        _bottom.store(b + 1, std::memory_order_release);
+      }
+      void *pop() noexcept
+      {
+        const auto b = _bottom.load(std::memory_order_relaxed) - 1;
+        auto *a = _array.load(std::memory_order_relaxed);
+        _bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto t = _top.load(std::memory_order_relaxed);
+        if(t > b)
+        {
+          _bottom.store(b + 1, std::memory_order_relaxed);
+          return nullptr;
+        }
+        void *v = a->get(b);
+        if(t == b)
+        {
+          // The last item, which a stealer may be taking
+          if(!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+          {
+            v = nullptr;
+          }
+          _bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return v;
+      }
+      // Returns null if empty, or if another stealer or the owner won the race
+      void *steal() noexcept
+      {
+        auto t = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto b = _bottom.load(std::memory_order_acquire);
+        if(t >= b)
+        {
+          return nullptr;
+        }
+        void *v = _array.load(std::memory_order_acquire)->get(t);
+        if(!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+          return nullptr;
+        }
+        return v;
+      }
+    };
+  }  // namespace detail
+
+  /*! AWAITING HUGO JSON CONVERSION TOOL
+type definition work_stealing_pool. Potential doc page: `work_stealing_pool`
+*/
+  class work_stealing_pool
+  {
+    struct worker
+    {
+      work_stealing_pool *pool;
+      size_t index;
+      detail::work_stealing_deque deque;
+    };
+
+    std::vector<std::unique_ptr<worker>> _workers;
+    std::vector<std::thread> _threads;
+    // Posts from threads not of this pool, and sleeping, are under this lock
+    std::mutex _lock;
+    std::condition_variable _changed;
+    std::deque<coroutine_handle<>> _injected;
+    std::atomic<bool> _has_injected{false};
+    std::atomic<size_t> _sleeping{0};
+    bool _stopping{false};
+
+    static worker *&_current() noexcept
+    {
+      static BOOST_OUTCOME_THREAD_LOCAL worker *v;
+      return v;
+    }
+    void *_take_injected()
+    {
+      if(!_has_injected.load(std::memory_order_relaxed))
+      {
+        return nullptr;
+      }
+      std::lock_guard<std::mutex> g(_lock);
+      if(_injected.empty())
+      {
+        return nullptr;
+      }
+      void *ret = _injected.front().address();
+      _injected.pop_front();
+      _has_injected.store(!_injected.empty(), std::memory_order_relaxed);
+      return ret;
+    }
+    void *_steal(worker &me, size_t &victim) noexcept
+    {
+      for(size_t n = 1; n < _workers.size(); n++)
+      {
+        victim = (victim + 1) % _workers.size();
+        if(victim == me.index)
+        {
+          victim = (victim + 1) % _workers.size();
+        }
+        if(void *ret = _workers[victim]->deque.steal())
+        {
+          return ret;
+        }
+      }
+      return nullptr;
+    }
+    bool _anything_to_steal() const noexcept
+    {
+      for(auto &w : _workers)
+      {
+        if(w->deque.maybe_nonempty())
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+    // Posters and sleepers both fence before looking at the other, so one always sees the other
+    void _wake_one()
+    {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if(_sleeping.load(std::memory_order_relaxed) > 0)
+      {
+        std::lock_guard<std::mutex> g(_lock);
+        _changed.notify_one();
+      }
+    }
+    void _run(worker &me)
+    {
+      _current() = &me;
+      size_t victim = me.index, idle = 0;
+      for(;;)
+      {
+        void *h = me.deque.pop();
+        if(h == nullptr)
+        {
+          h = _take_injected();
+        }
+        if(h == nullptr)
+        {
+          h = _steal(me, victim);
+        }
+        if(h != nullptr)
+        {
+          idle = 0;
+          coroutine_handle<>::from_address(h).resume();
+          continue;
+        }
+        if(++idle < 64)
+        {
+          std::this_thread::yield();
+          continue;
+        }
+        idle = 0;
+        std::unique_lock<std::mutex> g(_lock);
+        _sleeping.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        // Work queued before stopping is still done
+        const bool empty = _injected.empty() && !_anything_to_steal();
+        if(empty && _stopping)
+        {
+          _sleeping.fetch_sub(1, std::memory_order_relaxed);
+          break;
+        }
+        if(empty)
+        {
+          _changed.wait(g);
+        }
+        _sleeping.fetch_sub(1, std::memory_order_relaxed);
+      }
+      _current() = nullptr;
+    }
+
+  public:
+    //! The executor to give to awaitables, which resumes them upon this pool.
+    class executor_type
+    {
+      friend class work_stealing_pool;
+      work_stealing_pool *_pool{nullptr};
+
+      explicit executor_type(work_stealing_pool *pool) noexcept
+          : _pool(pool)
+      {
+      }
+
+    public:
+      //! Queues `h` for resumption by a thread of the pool.
+      void post(coroutine_handle<> h) const { _pool->post(h); }
+      //! True if the calling thread is one of the pool's.
+      bool running_in_this_thread() const noexcept { return _current() != nullptr && _current()->pool == _pool; }
+      //! The pool.
+      work_stealing_pool &context() const noexcept { return *_pool; }
+
+      friend bool operator==(const executor_type &a, const executor_type &b) noexcept { return a._pool == b._pool; }
+      friend bool operator!=(const executor_type &a, const executor_type &b) noexcept { return a._pool != b._pool; }
+    };
+
+    //! Starts `threads` threads, by default one per hardware thread.
+    explicit work_stealing_pool(size_t threads = std::thread::hardware_concurrency())
+    {
+      if(threads == 0)
+      {
+        threads = 1;
+      }
+      _workers.reserve(threads);
+      for(size_t n = 0; n < threads; n++)
+      {
+        _workers.push_back(std::unique_ptr<worker>(new worker{this, n, {}}));
+      }
+      _threads.reserve(threads);
+      for(auto &w : _workers)
+      {
+        _threads.emplace_back([this, p = w.get()] { _run(*p); });
+      }
+    }
+    work_stealing_pool(const work_stealing_pool &) = delete;
+    work_stealing_pool(work_stealing_pool &&) = delete;
+    work_stealing_pool &operator=(const work_stealing_pool &) = delete;
+    work_stealing_pool &operator=(work_stealing_pool &&) = delete;
+    //! Resumes everything already queued, then joins the threads.
+    ~work_stealing_pool()
+    {
+      {
+        std::lock_guard<std::mutex> g(_lock);
+        _stopping = true;
+      }
+      _changed.notify_all();
+      for(auto &t : _threads)
+      {
+        t.join();
+      }
+    }
+
+    //! The executor of this pool.
+    executor_type get_executor() noexcept { return executor_type(this); }
+    //! The number of threads in this pool.
+    size_t size() const noexcept { return _threads.size(); }
+    //! Queues `h` for resumption by a thread of the pool, at the front of the calling thread's queue if it is one of the pool's.
+    void post(coroutine_handle<> h)
+    {
+      worker *w = _current();
+      if(w != nullptr && w->pool == this)
+      {
+        w->deque.push(h.address());
+        _wake_one();
+        return;
+      }
+      {
+        std::lock_guard<std::mutex> g(_lock);
+        _injected.push_back(h);
+        _has_injected.store(true, std::memory_order_relaxed);
+      }
+      _changed.notify_one();
+    }
+  };
+}  // namespace awaitables
+BOOST_OUTCOME_V2_NAMESPACE_END
+
+#endif
+#endif
@@ -0,0 +1,27 @@
+# Distributed under the Boost Software License, Version 1.0.
+# https://www.boost.org/LICENSE_1_0.txt
+
+# Usage: cmake -DIR=<LLVM IR of codegen/trivial-abi.cpp> -P check-trivial-abi.cmake
+#
+# clang lowers a parameter passed in registers into coerced arguments named <param>.coerce<N>,
+# whereas a parameter passed by pointer to a temporary keeps its own name.
+
+file(READ "${IR}" ir)
+
+function(outcome_codegen_signature var name)
+  string(REGEX MATCH "define[^\n]*@${name}\\([^\n]*" signature "${ir}")
+  if(NOT signature)
+    message(FATAL_ERROR "${name} was not found in ${IR}")
+  endif()
+  set(${var} "${signature}" PARENT_SCOPE)
+endfunction()
+
+outcome_codegen_signature(handle_result outcome_codegen_handle_result)
+if(NOT handle_result MATCHES "%r\\.coerce")
+  message(FATAL_ERROR "basic_result<handle, int> is not passed in registers, so [[clang::trivial_abi]] was ignored on it:\n${handle_result}")
+endif()
+
+outcome_codegen_signature(self_referencing_result outcome_codegen_self_referencing_result)
+if(self_referencing_result MATCHES "%r\\.coerce")
+  message(FATAL_ERROR "basic_result<self_referencing, int> is passed in registers, despite its value not being trivially relocatable:\n${self_referencing_result}")
+endif()
@@ -0,0 +1,77 @@
+/* Codegen check that basic_result is passed in registers when its contents allow it
+(C) 2013-2022 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+/* This is compiled to LLVM IR by clang, and check-trivial-abi.cmake then checks how each of the
+functions below receives its parameter. If [[clang::trivial_abi]] survived on every layer of
+basic_result, the result is passed in registers as coerced arguments, otherwise it is passed by
+pointer to a temporary in the caller.
+*/
+
+#include <boost/outcome/basic_result.hpp>
+#include <boost/outcome/policy/all_narrow.hpp>
+
+namespace outcome = BOOST_OUTCOME_V2_NAMESPACE;
+
+// A move-only handle with a non-trivial destructor which is nevertheless safe to pass in registers
+struct BOOST_OUTCOME_TRIVIAL_ABI handle
+{
+  int *v{nullptr};
+  handle() = default;
+  handle(handle &&o) noexcept
+      : v(o.v)
+  {
+    o.v = nullptr;
+  }
+  handle &operator=(handle &&o) noexcept
+  {
+    v = o.v;
+    o.v = nullptr;
+    return *this;
+  }
+  ~handle() { v = nullptr; }
+};
+
+// A type which must never be passed in registers, as it points into itself
+struct self_referencing
+{
+  self_referencing *self{this};
+  self_referencing() = default;
+  self_referencing(const self_referencing & /*unused*/) noexcept {}
+  ~self_referencing() {}
+};
+
+extern "C" int *outcome_codegen_handle_result(outcome::basic_result<handle, int, outcome::policy::all_narrow> r)
+{
+  return r.has_value() ? r.assume_value().v : nullptr;
+}
+
+extern "C" bool outcome_codegen_self_referencing_result(outcome::basic_result<self_referencing, int, outcome::policy::all_narrow> r)
+{
+  return r.has_value() && r.assume_value().self == &r.assume_value();
+}
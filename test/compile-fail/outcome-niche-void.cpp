@@ -0,0 +1,45 @@
+/* clang-format off
+(value_type and error_type cannot be a type with a niche and void)
+clang-format on
+
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License in the accompanying file
+Licence.txt or at
+
+http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file Licence.txt or copy at
+http://www.boost.org/LICENSE_1_0.txt)
+*/
+
+#include "../../include/boost/outcome.hpp"
+
+struct code
+{
+  int v;
+};
+template <> struct BOOST_OUTCOME_V2_NAMESPACE::trait::has_niche<code>
+{
+  static constexpr bool value = true;
+  static constexpr code make_niche() noexcept { return {0}; }
+  static constexpr bool is_niche(const code &v) noexcept { return v.v == 0; }
+};
+
+int main()
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  // Must not be possible to niche encode an outcome, as the niche has no room for the exception
+  outcome<void, code> m(code{5});
+  (void) m;
+  return 0;
+}
@@ -0,0 +1,278 @@
+/* Unit testing for outcomes
+(C) 2013-2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <boost/outcome/collect.hpp>
+#include <boost/outcome/outcome.hpp>
+#include <boost/outcome/std_result.hpp>
+#include <boost/outcome/experimental/status_result.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+
+#include <deque>
+#include <forward_list>
+#include <list>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace collect_test
+{
+  struct Counted
+  {
+    static int copies, moves;
+    int v;
+    Counted(int _v)
+        : v(_v)
+    {
+    }
+    Counted(const Counted &o)
+        : v(o.v)
+    {
+      ++copies;
+    }
+    Counted(Counted &&o) noexcept
+        : v(o.v)
+    {
+      ++moves;
+    }
+    Counted &operator=(const Counted &) = default;
+    Counted &operator=(Counted &&) = default;
+    ~Counted() = default;
+    static void reset() { copies = moves = 0; }
+  };
+  int Counted::copies, Counted::moves;
+
+  // Counts how often it is asked to reserve, and how often it reallocates
+  template <class T> struct counting_vector : std::vector<T>
+  {
+    size_t reserves{0}, reallocations{0};
+    void reserve(size_t n)
+    {
+      ++reserves;
+      std::vector<T>::reserve(n);
+    }
+    void push_back(T &&v)
+    {
+      if(this->size() == this->capacity())
+      {
+        ++reallocations;
+      }
+      std::vector<T>::push_back(std::move(v));
+    }
+  };
+}  // namespace collect_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_collect_result, "Tests that collect() of a range of results short circuits, and reserves once")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  using collect_test::Counted;
+  std::vector<result<Counted>> in;
+  for(int n = 0; n < 100; n++)
+  {
+    in.emplace_back(n);
+  }
+  {
+    Counted::reset();
+    auto r = collect<collect_test::counting_vector<Counted>>(std::move(in));
+    static_assert(std::is_same<decltype(r), result<collect_test::counting_vector<Counted>>>::value, "");
+    BOOST_REQUIRE(r.has_value());
+    BOOST_CHECK(r.value().size() == 100);
+    BOOST_CHECK(r.value().reserves == 1);
+    BOOST_CHECK(r.value().reallocations == 0);
+    BOOST_CHECK(r.value()[99].v == 99);
+    // Values are moved out of rvalue ranges, never copied
+    BOOST_CHECK(Counted::copies == 0);
+  }
+  {
+    Counted::reset();
+    auto r = collect(in);
+    static_assert(std::is_same<decltype(r), result<std::vector<Counted>>>::value, "");
+    BOOST_REQUIRE(r.has_value());
+    BOOST_CHECK(r.value().size() == 100);
+    // Values are copied out of lvalue ranges
+    BOOST_CHECK(Counted::copies == 100);
+  }
+  in[50] = boost::system::errc::invalid_argument;
+  in[70] = boost::system::errc::not_enough_memory;
+  {
+    Counted::reset();
+    auto r = collect(in);
+    BOOST_REQUIRE(r.has_error());
+    BOOST_CHECK(r.error() == boost::system::errc::invalid_argument);
+    // Nothing after the first failure is visited
+    BOOST_CHECK(Counted::copies == 50);
+  }
+  {
+    // Containers without push_back() are inserted into, ranges without size() are not reserved for
+    std::list<result<int>> l{1, 2, 3, 2};
+    auto r = collect<std::set<int>>(l);
+    BOOST_REQUIRE(r.has_value());
+    BOOST_CHECK(r.value().size() == 3);
+    std::forward_list<result<int>> fl{1, 2, 3};
+    auto s = collect<std::deque<int>>(std::move(fl));
+    BOOST_REQUIRE(s.has_value());
+    BOOST_CHECK(s.value().back() == 3);
+    result<int> a[] = {4, 5, 6};
+    auto t = collect(a);
+    BOOST_REQUIRE(t.has_value());
+    BOOST_CHECK(t.value().capacity() == 3);
+  }
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_collect_errors, "Tests that collect_errors() gathers every error into a small_vector")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  std::vector<result<int>> in;
+  for(int n = 0; n < 10; n++)
+  {
+    in.emplace_back(n);
+  }
+  {
+    auto r = collect_errors(in);
+    static_assert(std::is_same<decltype(r), result<std::vector<int>, small_vector<boost::system::error_code, 4>, policy::terminate>>::value, "");
+    BOOST_REQUIRE(r.has_value());
+    BOOST_CHECK(r.value().size() == 10);
+  }
+  for(int n = 1; n < 10; n += 2)
+  {
+    in[n] = boost::system::error_code(n, boost::system::generic_category());
+  }
+  {
+    auto r = collect_errors(in);
+    BOOST_REQUIRE(r.has_error());
+    BOOST_REQUIRE(r.error().size() == 5);
+    // Five errors do not fit inline
+    BOOST_CHECK(!r.error().is_inline());
+    for(int n = 0; n < 5; n++)
+    {
+      BOOST_CHECK(r.error()[n].value() == n * 2 + 1);
+    }
+    auto s = collect_errors<std::vector<int>, small_vector<boost::system::error_code, 8>>(in);
+    BOOST_REQUIRE(s.has_error());
+    BOOST_CHECK(s.error().is_inline());
+    BOOST_CHECK(s.error().size() == 5);
+  }
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_collect_outcome, "Tests that collect() of a range of outcomes propagates exceptions")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  std::vector<outcome<std::string>> in{std::string("a"), std::string("b"), std::string("c")};
+  {
+    auto r = collect(in);
+    static_assert(std::is_same<decltype(r), outcome<std::vector<std::string>>>::value, "");
+    BOOST_REQUIRE(r.has_value());
+    BOOST_CHECK(r.value()[2] == "c");
+  }
+  in[1] = boost::copy_exception(std::runtime_error("b"));
+  {
+    auto r = collect(std::move(in));
+    BOOST_REQUIRE(r.has_exception());
+    BOOST_CHECK(!r.has_error());
+    BOOST_CHECK_THROW(r.value(), std::runtime_error);
+  }
+  in = {std::string("a"), std::string("b")};
+  in[0] = boost::system::errc::invalid_argument;
+  in[1] = boost::copy_exception(std::runtime_error("b"));
+  {
+    auto r = collect_errors(in);
+    BOOST_REQUIRE(r.has_error());
+    BOOST_REQUIRE(r.error().size() == 2);
+    BOOST_CHECK(r.error()[0].error() == boost::system::errc::invalid_argument);
+    BOOST_CHECK(r.error()[1].exception());
+  }
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_collect_std_status_result, "Tests that collect() works with std_result and status_result")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  {
+    std::vector<std_result<int>> in{1, 2, 3};
+    auto r = collect(in);
+    static_assert(std::is_same<decltype(r), std_result<std::vector<int>>>::value, "");
+    BOOST_REQUIRE(r.has_value());
+    BOOST_CHECK(r.value()[1] == 2);
+    in[2] = std::errc::invalid_argument;
+    auto s = collect(in);
+    BOOST_REQUIRE(s.has_error());
+    BOOST_CHECK(s.error() == std::errc::invalid_argument);
+    BOOST_CHECK_THROW(s.value(), std::system_error);
+  }
+  {
+    namespace outcome_e = BOOST_OUTCOME_V2_NAMESPACE::experimental;
+    std::vector<outcome_e::status_result<int>> in;
+    in.emplace_back(1);
+    in.emplace_back(outcome_e::errc::invalid_argument);
+    in.emplace_back(outcome_e::errc::not_enough_memory);
+    // status codes are move only, so must be moved out of the range
+    auto r = collect(std::move(in));
+    BOOST_REQUIRE(r.has_error());
+    BOOST_CHECK(r.error() == outcome_e::errc::invalid_argument);
+
+    std::vector<outcome_e::status_result<int>> in2;
+    in2.emplace_back(1);
+    in2.emplace_back(outcome_e::errc::invalid_argument);
+    in2.emplace_back(outcome_e::errc::not_enough_memory);
+    auto s = collect_errors(std::move(in2));
+    BOOST_REQUIRE(s.has_error());
+    BOOST_REQUIRE(s.error().size() == 2);
+    BOOST_CHECK(s.error()[1] == outcome_e::errc::not_enough_memory);
+  }
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_small_vector, "Tests that small_vector stores inline, then spills into allocated memory")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  small_vector<std::string, 2> v;
+  BOOST_CHECK(v.is_inline());
+  v.push_back("a");
+  v.emplace_back(10, 'b');
+  BOOST_CHECK(v.is_inline());
+  // Appending an item of itself when growing must not read from relocated storage
+  v.push_back(v[1]);
+  BOOST_CHECK(!v.is_inline());
+  BOOST_REQUIRE(v.size() == 3);
+  BOOST_CHECK(v[2] == std::string(10, 'b'));
+  small_vector<std::string, 2> w(v);
+  BOOST_CHECK(w.size() == 3);
+  small_vector<std::string, 2> x(std::move(v));
+  BOOST_CHECK(v.empty());
+  BOOST_CHECK(x.front() == "a");
+  small_vector<std::string, 2> y;
+  y.push_back("c");
+  small_vector<std::string, 2> z(std::move(y));
+  BOOST_CHECK(z.is_inline());
+  BOOST_CHECK(z.back() == "c");
+  z = std::move(x);
+  BOOST_CHECK(z.size() == 3);
+  z = w;
+  BOOST_CHECK(z.size() == 3);
+  z.pop_back();
+  BOOST_CHECK(z.size() == 2);
+}
@@ -0,0 +1,249 @@
+/* Unit testing for outcomes
+(C) 2013-2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#define BOOST_OUTCOME_COMPACT_OUTCOME_STORAGE 1
+
+#include <boost/outcome.hpp>
+#include <boost/outcome/std_outcome.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace compact_outcome_storage
+{
+  // An exception type which counts how many of it are alive
+  struct counted_exception
+  {
+    static int live;
+    int v{0};
+    counted_exception() noexcept { ++live; }
+    explicit counted_exception(int _v) noexcept
+        : v(_v)
+    {
+      ++live;
+    }
+    counted_exception(const counted_exception &o) noexcept
+        : v(o.v)
+    {
+      ++live;
+    }
+    counted_exception(counted_exception &&o) noexcept
+        : v(o.v)
+    {
+      o.v = -1;
+      ++live;
+    }
+    counted_exception &operator=(const counted_exception &) = default;
+    counted_exception &operator=(counted_exception &&) = default;
+    ~counted_exception() { --live; }
+    bool operator==(const counted_exception &o) const noexcept { return v == o.v; }
+    bool operator!=(const counted_exception &o) const noexcept { return v != o.v; }
+  };
+  int counted_exception::live;
+
+  // Too small to hold a counted_exception
+  struct small_value
+  {
+    char c;
+  };
+  struct big_value
+  {
+    std::string v;
+    big_value(small_value o)  // NOLINT
+        : v(1, o.c)
+    {
+    }
+    big_value(std::string _v)  // NOLINT
+        : v(std::move(_v))
+    {
+    }
+  };
+}  // namespace compact_outcome_storage
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_outcome_compact_storage_size, "Tests that the compact outcome layout is no bigger than the equivalent result")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  using compact_outcome_storage::counted_exception;
+#define BOOST_OUTCOME_CHECK_COMPACT_SIZE(T)                                                                                                                    \
+  static_assert(sizeof(outcome<T>) == sizeof(result<T>), "outcome<" #T "> does not overlap its exception with its value!")
+  BOOST_OUTCOME_CHECK_COMPACT_SIZE(std::string);
+  BOOST_OUTCOME_CHECK_COMPACT_SIZE(std::vector<int>);
+  BOOST_OUTCOME_CHECK_COMPACT_SIZE(std::shared_ptr<int>);
+#undef BOOST_OUTCOME_CHECK_COMPACT_SIZE
+  static_assert(sizeof(std_outcome<std::string>) == sizeof(std_result<std::string>), "std_outcome<std::string> is the wrong size!");
+  static_assert(sizeof(basic_outcome<std::string, std::error_code, counted_exception, policy::all_narrow>) == sizeof(std_result<std::string>),
+                "basic_outcome<std::string, std::error_code, counted_exception> is the wrong size!");
+
+  // A value too small to hold the exception, or an error sharing the value's storage, keeps the v2.2 layout
+  static_assert(sizeof(outcome<int>) > sizeof(result<int>), "outcome<int> cannot overlap its exception with its value!");
+  static_assert(sizeof(outcome<void>) > sizeof(result<void>), "outcome<void> cannot overlap its exception with its value!");
+  static_assert(!detail::outcome_exception_shares_value_storage<std::string, std::string, boost::exception_ptr>::value, "");
+  static_assert(!detail::outcome_exception_shares_value_storage<std::string, std::error_code, void>::value, "");
+  static_assert(std::is_same<outcome<int>, layout_compact::outcome<int>>::value, "compact layout is not in its own namespace!");
+
+  // Special members are only available if the value, error and exception provide them
+  static_assert(std::is_copy_constructible<outcome<std::string>>::value, "");
+  static_assert(std::is_nothrow_move_constructible<outcome<std::string>>::value, "");
+  using move_only = std_outcome<std::unique_ptr<int>>;
+  static_assert(sizeof(move_only) == sizeof(std_result<std::unique_ptr<int>>), "std_outcome<std::unique_ptr<int>> is the wrong size!");
+  static_assert(!std::is_copy_constructible<move_only>::value, "");
+  static_assert(!std::is_copy_assignable<move_only>::value, "");
+  static_assert(std::is_nothrow_move_constructible<move_only>::value, "");
+  static_assert(std::is_move_assignable<move_only>::value, "");
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_outcome_compact_storage_lifetime, "Tests that the compact outcome layout constructs and destroys its exception correctly")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  using compact_outcome_storage::counted_exception;
+  using type = basic_outcome<std::string, std::error_code, counted_exception, policy::all_narrow>;
+  static_assert(detail::outcome_exception_shares_value_storage<std::string, std::error_code, counted_exception>::value, "");
+  const std::error_code ec = std::make_error_code(std::errc::invalid_argument);
+  {
+    type a("niall"), b(in_place_type<counted_exception>, 5), c(ec, counted_exception(6)), d(ec);
+    BOOST_CHECK(counted_exception::live == 2);
+    BOOST_CHECK(a.value() == "niall");
+    BOOST_CHECK(b.exception().v == 5);
+    BOOST_CHECK(!b.has_error());
+    BOOST_CHECK(c.error() == ec);
+    BOOST_CHECK(c.exception().v == 6);
+    BOOST_CHECK(!d.has_exception());
+
+    // copies and moves
+    type e(b), f(c);
+    BOOST_CHECK(e.exception().v == 5);
+    BOOST_CHECK(f.error() == ec);
+    BOOST_CHECK(f.exception().v == 6);
+    type g(std::move(e));
+    BOOST_CHECK(g.exception().v == 5);
+    BOOST_CHECK(e.exception().v == -1);
+    BOOST_CHECK(counted_exception::live == 5);
+
+    // assignment across states
+    e = a;
+    BOOST_CHECK(e.value() == "niall");
+    BOOST_CHECK(!e.has_exception());
+    BOOST_CHECK(counted_exception::live == 4);
+    e = c;
+    BOOST_CHECK(e.error() == ec);
+    BOOST_CHECK(e.exception().v == 6);
+    e = std::move(b);
+    BOOST_CHECK(!e.has_error());
+    BOOST_CHECK(e.exception().v == 5);
+    e = e;
+    BOOST_CHECK(e.exception().v == 5);
+    e = type("hello");
+    BOOST_CHECK(e.value() == "hello");
+    BOOST_CHECK(counted_exception::live == 4);
+    BOOST_CHECK(e != c);
+    BOOST_CHECK(f == c);
+    BOOST_CHECK(g != c);
+
+    // swaps move the exceptions out of the way of the value and error
+    swap(a, c);
+    BOOST_CHECK(a.error() == ec);
+    BOOST_CHECK(a.exception().v == 6);
+    BOOST_CHECK(c.value() == "niall");
+    BOOST_CHECK(!c.has_exception());
+    swap(a, g);
+    BOOST_CHECK(!a.has_error());
+    BOOST_CHECK(a.exception().v == 5);
+    BOOST_CHECK(g.error() == ec);
+    BOOST_CHECK(g.exception().v == 6);
+    swap(a, d);
+    BOOST_CHECK(a.error() == ec);
+    BOOST_CHECK(!a.has_exception());
+    BOOST_CHECK(d.exception().v == 5);
+    BOOST_CHECK(!a.has_lost_consistency());
+    BOOST_CHECK(!d.has_lost_consistency());
+    BOOST_CHECK(counted_exception::live == 4);
+
+    // failure conversions
+    type h(failure(ec, counted_exception(7))), i(failure(counted_exception(8))), j(failure(ec));
+    BOOST_CHECK(h.error() == ec);
+    BOOST_CHECK(h.exception().v == 7);
+    BOOST_CHECK(i.exception().v == 8);
+    BOOST_CHECK(!j.has_exception());
+    BOOST_CHECK(h.error() == ec && h.exception() == counted_exception(7));
+    BOOST_CHECK(counted_exception::live == 6);
+
+    // Overriding the exception destroys any value, as they cannot both be present
+    hooks::override_outcome_exception(&c, counted_exception(9));
+    BOOST_CHECK(!c.has_value());
+    BOOST_CHECK(c.exception().v == 9);
+    hooks::override_outcome_exception(&c, counted_exception(10));
+    BOOST_CHECK(c.exception().v == 10);
+    BOOST_CHECK(counted_exception::live == 7);
+  }
+  BOOST_CHECK(counted_exception::live == 0);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_outcome_compact_storage_conversion, "Tests that outcomes convert between the compact and v2.2 layouts")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  using namespace compact_outcome_storage;
+  using small = basic_outcome<small_value, std::error_code, counted_exception, policy::all_narrow>;
+  using big = basic_outcome<big_value, std::error_code, counted_exception, policy::all_narrow>;
+  using string = basic_outcome<std::string, std::error_code, counted_exception, policy::all_narrow>;
+  static_assert(!detail::outcome_exception_shares_value_storage<small_value, std::error_code, counted_exception>::value, "");
+  static_assert(detail::outcome_exception_shares_value_storage<big_value, std::error_code, counted_exception>::value, "");
+  static_assert(detail::outcome_exception_shares_value_storage<std::string, std::error_code, counted_exception>::value, "");
+  const std::error_code ec = std::make_error_code(std::errc::invalid_argument);
+  {
+    small a(small_value{'a'}), b(in_place_type<counted_exception>, 5), c(ec, counted_exception(6));
+    big d(a), e(b), f(std::move(c));
+    BOOST_CHECK(d.value().v == "a");
+    BOOST_CHECK(e.exception().v == 5);
+    BOOST_CHECK(f.error() == ec);
+    BOOST_CHECK(f.exception().v == 6);
+    string g(std::string("niall")), h(ec, counted_exception(7));
+    big i(g), j(std::move(h));
+    BOOST_CHECK(i.value().v == "niall");
+    BOOST_CHECK(j.exception().v == 7);
+    BOOST_CHECK(h.exception().v == -1);
+    BOOST_CHECK(e.exception() == b.exception());
+    BOOST_CHECK(j.exception() != e.exception());
+  }
+  BOOST_CHECK(counted_exception::live == 0);
+  {
+    // outcome's standard exception_ptr
+    outcome<std::string> a(boost::copy_exception(std::runtime_error("hi"))), b("niall");
+    BOOST_CHECK_THROW(a.value(), std::runtime_error);
+    BOOST_CHECK(a.failure() == a.exception());
+    swap(a, b);
+    BOOST_CHECK(a.value() == "niall");
+    BOOST_CHECK_THROW(b.value(), std::runtime_error);
+    outcome<std::string> c(boost::system::errc::invalid_argument);
+    BOOST_CHECK(c.failure());
+  }
+}
@@ -0,0 +1,160 @@
+/* Unit testing for outcomes
+(C) 2013-2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <boost/outcome.hpp>
+#include <boost/outcome/coroutine_support.hpp>
+#include <boost/outcome/try.hpp>
+
+#if BOOST_OUTCOME_FOUND_COROUTINE_HEADER && __cpp_lib_span >= 202002L
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+
+#include <vector>
+
+namespace coroutine_batch_generator_test
+{
+  namespace outcome = BOOST_OUTCOME_V2_NAMESPACE;
+  template <class T> using generator = outcome::awaitables::generator<T>;
+  template <class T, size_t N> using batch_generator = outcome::awaitables::batch_generator<T, N>;
+
+  struct custom_exception_type
+  {
+  };
+
+  inline generator<outcome::result<int>> counting(int count)
+  {
+    for(int n = 0; n < count; n++)
+    {
+      co_yield n;
+    }
+  }
+  template <size_t N> inline batch_generator<outcome::result<int>, N> counting_batched(int count)
+  {
+    for(int n = 0; n < count; n++)
+    {
+      co_yield n;
+    }
+  }
+  inline batch_generator<outcome::result<int>, 8> batched_error()
+  {
+    co_yield 1;
+    co_yield 2;
+    co_yield boost::system::errc::not_enough_memory;
+  }
+#ifndef BOOST_NO_EXCEPTIONS
+  inline batch_generator<outcome::std_outcome<int>, 8> batched_exception(int count)
+  {
+    for(int n = 0; n < count; n++)
+    {
+      co_yield n;
+    }
+    throw custom_exception_type();
+  }
+#endif
+}  // namespace coroutine_batch_generator_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_coroutine_batch_generator, "Tests that results can be generated in batches")
+{
+  using namespace coroutine_batch_generator_test;
+  // The coroutine is resumed once per batch, with the last batch holding what remains
+  {
+    std::vector<size_t> sizes;
+    int expected = 0;
+    auto t = counting_batched<64>(1000);
+    while(t)
+    {
+      auto batch = t();
+      sizes.push_back(batch.size());
+      for(auto &r : batch)
+      {
+        BOOST_CHECK(r.value() == expected++);
+      }
+    }
+    BOOST_CHECK(expected == 1000);
+    BOOST_REQUIRE(sizes.size() == 16);
+    BOOST_CHECK(sizes.front() == 64);
+    BOOST_CHECK(sizes.back() == 1000 - 15 * 64);
+  }
+  // Exactly filling the last batch, and yielding nothing, yield no empty batches
+  {
+    auto t = counting_batched<10>(20);
+    BOOST_CHECK(t().size() == 10);
+    BOOST_CHECK(t().size() == 10);
+    BOOST_CHECK(!t);
+  }
+  BOOST_CHECK(!counting_batched<10>(0));
+
+  // Yielded failures are values like any other
+  {
+    auto t = batched_error();
+    auto batch = t();
+    BOOST_REQUIRE(batch.size() == 3);
+    BOOST_CHECK(batch[1].value() == 2);
+    BOOST_CHECK(batch[2].error() == boost::system::errc::not_enough_memory);
+    BOOST_CHECK(!t);
+  }
+#ifndef BOOST_NO_EXCEPTIONS
+  // A throw becomes the last value
+  {
+    auto t = batched_exception(10);
+    BOOST_CHECK(t().size() == 8);
+    auto batch = t();
+    BOOST_REQUIRE(batch.size() == 3);
+    BOOST_CHECK(batch[1].value() == 9);
+    BOOST_CHECK_THROW(batch[2].value(), custom_exception_type);
+    BOOST_CHECK(!t);
+  }
+#endif
+
+  // The same values come from resuming per value as from resuming per batch
+  {
+    long long sum = 0;
+    auto t = counting(10000);
+    while(t)
+    {
+      sum += t().value();
+    }
+    auto u = counting_batched<64>(10000);
+    while(u)
+    {
+      for(auto &r : u())
+      {
+        sum -= r.value();
+      }
+    }
+    BOOST_CHECK(sum == 0);
+  }
+}
+#else
+int main(void)
+{
+  return 0;
+}
+#endif
@@ -0,0 +1,216 @@
+/* Unit testing for outcomes
+(C) 2013-2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <boost/outcome.hpp>
+#include <boost/outcome/coroutine_support.hpp>
+#include <boost/outcome/thread_pool.hpp>
+#include <boost/outcome/try.hpp>
+#include <boost/outcome/when_all.hpp>
+
+#if BOOST_OUTCOME_FOUND_COROUTINE_HEADER && BOOST_OUTCOME_HAVE_STOP_TOKEN
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <stop_token>
+#include <thread>
+
+namespace coroutine_cancellation_test
+{
+  namespace outcome = BOOST_OUTCOME_V2_NAMESPACE;
+  using executor = outcome::awaitables::thread_pool::executor_type;
+  template <class T> using eager = outcome::awaitables::eager<T>;
+  template <class T> using lazy = outcome::awaitables::lazy<T>;
+  template <class T> using atomic_lazy = outcome::awaitables::atomic_lazy<T, executor>;
+  template <class T> using result = outcome::result<T>;
+
+  // Suspends until resumed by hand
+  struct event
+  {
+    outcome::awaitables::coroutine_handle<> waiting;
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(outcome::awaitables::coroutine_handle<> h) noexcept { waiting = h; }
+    void await_resume() const noexcept {}
+  };
+  // Resumes the awaiting coroutine upon the pool
+  struct reschedule
+  {
+    executor ex;
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(outcome::awaitables::coroutine_handle<> h) { ex.post(h); }
+    void await_resume() const noexcept {}
+  };
+
+  static int reached = 0;
+  static std::atomic<int> spins{0};
+
+  inline lazy<result<int>> leaf(event &e)
+  {
+    co_await e;
+    ++reached;
+    // Stop is checked here, so this returns operation_canceled
+    co_await std::suspend_never();
+    ++reached;
+    co_return 0;
+  }
+  // Inherits the stop token of whoever awaits it
+  inline lazy<result<int>> chain(event &e, int depth)
+  {
+    if(depth == 0)
+    {
+      BOOST_OUTCOME_CO_TRY(auto v, co_await leaf(e));
+      co_return v;
+    }
+    BOOST_OUTCOME_CO_TRY(auto v, co_await chain(e, depth - 1));
+    co_return v + 1;
+  }
+  inline lazy<result<int>> top(std::stop_token /*unused*/, event &e, int depth)
+  {
+    BOOST_OUTCOME_CO_TRY(auto v, co_await chain(e, depth));
+    co_return v;
+  }
+  inline lazy<result<int>> both(std::stop_token /*unused*/, event &e)
+  {
+    BOOST_OUTCOME_CO_TRY(auto v, co_await outcome::awaitables::when_all(chain(e, 5), chain(e, 5)));
+    co_return std::get<0>(v) + std::get<1>(v);
+  }
+
+  inline atomic_lazy<result<int>> spin(executor ex, int depth)
+  {
+    if(depth == 0)
+    {
+      for(;;)
+      {
+        ++spins;
+        co_await reschedule{ex};
+      }
+    }
+    BOOST_OUTCOME_CO_TRY(auto v, co_await spin(ex, depth - 1));
+    co_return v + 1;
+  }
+  inline atomic_lazy<result<int>> atomic_top(executor ex, std::stop_token /*unused*/, int depth)
+  {
+    BOOST_OUTCOME_CO_TRY(auto v, co_await spin(ex, depth));
+    co_return v;
+  }
+
+  template <class T> inline auto wait(T &t)
+  {
+#if BOOST_OUTCOME_HAVE_NOOP_COROUTINE
+    t.await_suspend({}).resume();
+#else
+    t.await_suspend({});
+#endif
+    while(!t.await_ready())
+    {
+      std::this_thread::yield();
+    }
+    return t.await_resume();
+  }
+}  // namespace coroutine_cancellation_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_coroutine_cancellation, "Tests that stop tokens cancel chains of awaiting coroutines")
+{
+  using namespace coroutine_cancellation_test;
+  {
+    // Without stop being requested, nothing changes
+    std::stop_source ss;
+    event e;
+    auto t = top(ss.get_token(), e, 1000);
+#if BOOST_OUTCOME_HAVE_NOOP_COROUTINE
+    t.await_suspend({}).resume();
+#else
+    t.await_suspend({});
+#endif
+    BOOST_REQUIRE(e.waiting);
+    BOOST_CHECK(!t.await_ready());
+    e.waiting.resume();
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().value() == 1000);
+    BOOST_CHECK(reached == 2);
+  }
+  reached = 0;
+  {
+    // Stop requested whilst the leaf of a 1000 deep chain is suspended
+    std::stop_source ss;
+    event e;
+    auto t = top(ss.get_token(), e, 1000);
+#if BOOST_OUTCOME_HAVE_NOOP_COROUTINE
+    t.await_suspend({}).resume();
+#else
+    t.await_suspend({});
+#endif
+    BOOST_REQUIRE(e.waiting);
+    ss.request_stop();
+    e.waiting.resume();
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().error() == boost::system::errc::operation_canceled);
+    BOOST_CHECK(reached == 1);
+  }
+  reached = 0;
+  {
+    // Stop requested before beginning, so nothing runs past the first co_await
+    std::stop_source ss;
+    ss.request_stop();
+    event e;
+    auto t = both(ss.get_token(), e);
+    BOOST_CHECK(wait(t).error() == boost::system::errc::operation_canceled);
+    BOOST_CHECK(!e.waiting);
+    BOOST_CHECK(reached == 0);
+  }
+  {
+    // Stop requested whilst the leaf of a 100 deep chain keeps rescheduling itself upon a pool
+    outcome::awaitables::thread_pool pool(4);
+    std::stop_source ss;
+    auto t = atomic_top(pool.get_executor(), ss.get_token(), 100);
+#if BOOST_OUTCOME_HAVE_NOOP_COROUTINE
+    t.await_suspend({}).resume();
+#else
+    t.await_suspend({});
+#endif
+    while(spins < 100)
+    {
+      std::this_thread::yield();
+    }
+    ss.request_stop();
+    while(!t.await_ready())
+    {
+      std::this_thread::yield();
+    }
+    BOOST_CHECK(t.await_resume().error() == boost::system::errc::operation_canceled);
+  }
+}
+#else
+int main(void)
+{
+  return 0;
+}
+#endif
@@ -0,0 +1,284 @@
+/* Unit testing for outcomes
+(C) 2013-2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <boost/outcome.hpp>
+#include <boost/outcome/coroutine_support.hpp>
+#include <boost/outcome/thread_pool.hpp>
+#include <boost/outcome/try.hpp>
+
+#if BOOST_OUTCOME_FOUND_COROUTINE_HEADER
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+namespace coroutine_executor_test
+{
+  namespace outcome = BOOST_OUTCOME_V2_NAMESPACE;
+  using executor = outcome::awaitables::thread_pool::executor_type;
+  template <class T> using atomic_eager = outcome::awaitables::atomic_eager<T, executor>;
+  template <class T> using atomic_lazy = outcome::awaitables::atomic_lazy<T, executor>;
+  template <class T> using eager = outcome::awaitables::eager<T>;
+  template <class T> using lazy = outcome::awaitables::lazy<T>;
+
+  // The lowest and highest stack addresses seen by each thread
+  struct stack_extent
+  {
+    uintptr_t lowest{UINTPTR_MAX}, highest{0};
+  };
+  static std::mutex extents_lock;
+  static std::set<std::thread::id> threads_seen;
+  static std::atomic<uintptr_t> deepest{0};
+  // Boost.Test is not thread safe, so checks made upon the pool are counted
+  static std::atomic<unsigned> failed_checks{0};
+  inline void check(bool v)
+  {
+    if(!v)
+    {
+      ++failed_checks;
+    }
+  }
+#if defined(__GNUC__) || defined(__clang__)
+  __attribute__((noinline))
+#elif defined(_MSC_VER)
+  __declspec(noinline)
+#endif
+  inline void
+  note_stack_depth()
+  {
+    static BOOST_OUTCOME_THREAD_LOCAL stack_extent extent;
+    volatile char c = 0;
+    const auto here = reinterpret_cast<uintptr_t>(&c);
+    extent.lowest = (std::min)(extent.lowest, here);
+    extent.highest = (std::max)(extent.highest, here);
+    auto depth = extent.highest - extent.lowest;
+    auto d = deepest.load(std::memory_order_relaxed);
+    while(depth > d && !deepest.compare_exchange_weak(d, depth, std::memory_order_relaxed))
+    {
+    }
+    std::lock_guard<std::mutex> g(extents_lock);
+    threads_seen.insert(std::this_thread::get_id());
+  }
+
+  inline atomic_lazy<outcome::result<int>> chain(executor ex, int depth)
+  {
+    note_stack_depth();
+    if(depth == 0)
+    {
+      co_return 0;
+    }
+    BOOST_OUTCOME_CO_TRY(auto v, co_await chain(ex, depth - 1));
+    note_stack_depth();
+    check(ex.running_in_this_thread());
+    co_return v + 1;
+  }
+
+  inline atomic_eager<outcome::result<std::thread::id>> where(executor /*unused*/) { co_return std::this_thread::get_id(); }
+  inline atomic_lazy<outcome::result<int>> on_other_pool(executor ex, executor other)
+  {
+    auto w = where(other);  // begins running upon the other pool straight away
+    BOOST_OUTCOME_CO_TRY(auto id, co_await std::move(w));
+    check(id != std::this_thread::get_id());
+    // Resumed upon our own executor after the other pool completed it
+    check(ex.running_in_this_thread());
+    check(!other.running_in_this_thread());
+    co_return 5;
+  }
+
+  // No executor, so everything happens inline
+  inline lazy<outcome::result<int>> inline_chain(int depth)
+  {
+    if(depth == 0)
+    {
+      co_return 0;
+    }
+    BOOST_OUTCOME_CO_TRY(auto v, co_await inline_chain(depth - 1));
+    co_return v + 1;
+  }
+
+  // Counts coroutine frames still in existence
+  static std::atomic<int> live{0};
+  struct frame_counter
+  {
+    frame_counter() { ++live; }
+    frame_counter(const frame_counter &) = delete;
+    frame_counter &operator=(const frame_counter &) = delete;
+    ~frame_counter() { --live; }
+  };
+  static std::atomic<bool> release{false};
+  inline atomic_eager<outcome::result<int>> held(executor /*unused*/)
+  {
+    frame_counter c;
+    while(!release)
+    {
+      std::this_thread::yield();
+    }
+    co_return 1;
+  }
+
+  // Never resumes what awaits it
+  struct never
+  {
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(outcome::awaitables::coroutine_handle<> /*unused*/) const noexcept {}
+    void await_resume() const noexcept {}
+  };
+  inline eager<outcome::result<int>> suspended_forever()
+  {
+    frame_counter c;
+    co_await never();
+    co_return 1;
+  }
+
+  // Resumes inline, or throws if told to fail
+  struct failing_executor
+  {
+    bool *fail;
+    void post(outcome::awaitables::coroutine_handle<> h) const
+    {
+      if(*fail)
+      {
+        throw std::runtime_error("post failed");
+      }
+      h.resume();
+    }
+  };
+  struct gate
+  {
+    outcome::awaitables::coroutine_handle<> waiting;
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(outcome::awaitables::coroutine_handle<> h) noexcept { waiting = h; }
+    void await_resume() const noexcept {}
+  };
+  inline lazy<outcome::result<int>> gated(gate &g)
+  {
+    co_await g;
+    co_return 7;
+  }
+  inline outcome::awaitables::lazy<outcome::result<int>, failing_executor> after_gated(failing_executor /*unused*/, gate &g)
+  {
+    BOOST_OUTCOME_CO_TRY(auto v, co_await gated(g));
+    co_return v + 1;
+  }
+
+  template <class T> inline auto wait(T &t)
+  {
+#if BOOST_OUTCOME_HAVE_NOOP_COROUTINE
+    t.await_suspend({}).resume();
+#else
+    t.await_suspend({});
+#endif
+    while(!t.await_ready())
+    {
+      std::this_thread::yield();
+    }
+    return t.await_resume();
+  }
+}  // namespace coroutine_executor_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_coroutine_executor, "Tests that awaitables with an executor are resumed upon it, without the stack growing")
+{
+  using namespace coroutine_executor_test;
+  outcome::awaitables::thread_pool pool(4), other(1);
+  BOOST_CHECK(pool.size() == 4);
+  {
+    auto t = chain(pool.get_executor(), 10000);
+    BOOST_REQUIRE(t.executor() != nullptr);
+    BOOST_CHECK(*t.executor() == pool.get_executor());
+    BOOST_CHECK(!t.await_ready());
+    BOOST_CHECK(wait(t).value() == 10000);
+  }
+  // Each resumption began afresh from a thread of the pool
+  BOOST_CHECK(deepest < 64 * 1024);
+  BOOST_CHECK(threads_seen.count(std::this_thread::get_id()) == 0);
+  {
+    auto t = on_other_pool(pool.get_executor(), other.get_executor());
+    BOOST_CHECK(wait(t).value() == 5);
+  }
+  BOOST_CHECK(failed_checks == 0);
+  {
+    auto t = inline_chain(100);
+    BOOST_CHECK(t.executor() == nullptr);
+    // Without an executor, awaiting begins execution immediately within this thread
+    BOOST_CHECK(wait(t).value() == 100);
+  }
+  {
+    // Dropping an eager awaitable which is still running upon the pool detaches it, rather than destroying it under its feet
+    {
+      auto t = held(pool.get_executor());
+      while(live == 0)
+      {
+        std::this_thread::yield();
+      }
+    }
+    BOOST_CHECK(live == 1);
+    release = true;
+    while(live != 0)
+    {
+      std::this_thread::yield();
+    }
+  }
+  {
+    // Without atomics or an executor nothing can be running elsewhere, so dropping a suspended eager awaitable destroys it
+    {
+      auto t = suspended_forever();
+      BOOST_CHECK(!t.await_ready());
+      BOOST_CHECK(live == 1);
+    }
+    BOOST_CHECK(live == 0);
+  }
+  {
+    // If the executor fails to post the awaiter's resumption, it is resumed where the awaited completed instead
+    bool fail = false;
+    gate g;
+    auto t = after_gated(failing_executor{&fail}, g);
+#if BOOST_OUTCOME_HAVE_NOOP_COROUTINE
+    t.await_suspend({}).resume();
+#else
+    t.await_suspend({});
+#endif
+    BOOST_REQUIRE(g.waiting);
+    BOOST_CHECK(!t.await_ready());
+    fail = true;
+    g.waiting.resume();
+    BOOST_REQUIRE(t.await_ready());
+    BOOST_CHECK(t.await_resume().value() == 8);
+  }
+}
+#else
+int main(void)
+{
+  return 0;
+}
+#endif
@@ -0,0 +1,186 @@
+/* Unit testing for outcomes
+(C) 2013-2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <boost/outcome.hpp>
+#include <boost/outcome/coroutine_support.hpp>
+#include <boost/outcome/try.hpp>
+
+#if BOOST_OUTCOME_FOUND_COROUTINE_HEADER
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <thread>
+
+namespace coroutine_frame_allocation_test
+{
+  static std::atomic<size_t> global_allocations{0};
+}  // namespace coroutine_frame_allocation_test
+
+// Every form of the global operator new and delete which are replaced allocate with malloc and free with free
+namespace coroutine_frame_allocation_test
+{
+  static void *counted_malloc(size_t bytes)
+  {
+    ++global_allocations;
+    if(void *ret = std::malloc(bytes != 0 ? bytes : 1))
+    {
+      return ret;
+    }
+    throw std::bad_alloc();
+  }
+}  // namespace coroutine_frame_allocation_test
+void *operator new(size_t bytes) { return coroutine_frame_allocation_test::counted_malloc(bytes); }
+void *operator new[](size_t bytes) { return coroutine_frame_allocation_test::counted_malloc(bytes); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t /*unused*/) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete[](void *p, size_t /*unused*/) noexcept { std::free(p); }
+
+namespace coroutine_frame_allocation_test
+{
+  namespace outcome = BOOST_OUTCOME_V2_NAMESPACE;
+  template <class T> using eager = outcome::awaitables::eager<T>;
+  template <class T> using lazy = outcome::awaitables::lazy<T>;
+  template <class T> using generator = outcome::awaitables::generator<T>;
+
+  // Counts what it allocates, and is not always equal so it must be stored
+  template <class T> struct counting_allocator
+  {
+    using value_type = T;
+    size_t *allocated;
+    int id;
+
+    counting_allocator(size_t *_allocated, int _id)
+        : allocated(_allocated)
+        , id(_id)
+    {
+    }
+    template <class U>
+    counting_allocator(const counting_allocator<U> &o)
+        : allocated(o.allocated)
+        , id(o.id)
+    {
+    }
+    T *allocate(size_t n)
+    {
+      *allocated += n * sizeof(T);
+      return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T *p, size_t n)
+    {
+      *allocated -= n * sizeof(T);
+      std::allocator<T>().deallocate(p, n);
+    }
+    template <class U> bool operator==(const counting_allocator<U> &o) const { return id == o.id; }
+    template <class U> bool operator!=(const counting_allocator<U> &o) const { return id != o.id; }
+  };
+
+  inline lazy<outcome::result<int>> pooled(int x) { co_return x + 1; }
+  inline eager<outcome::result<int>> pooled_eager(int x) { co_return x + 1; }
+  inline lazy<outcome::result<int>> pooled_chain(int x)
+  {
+    BOOST_OUTCOME_CO_TRY(auto v, co_await pooled(x));
+    co_return v + 1;
+  }
+  template <class Alloc> inline lazy<outcome::result<int>> allocated(std::allocator_arg_t /*unused*/, Alloc /*unused*/, int x) { co_return x + 1; }
+  template <class Alloc> inline generator<outcome::result<int>> allocated_generator(std::allocator_arg_t /*unused*/, Alloc /*unused*/, int x)
+  {
+    co_yield x;
+    co_yield x + 1;
+  }
+  struct object
+  {
+    int base{5};
+    template <class Alloc> eager<outcome::result<int>> allocated(std::allocator_arg_t /*unused*/, Alloc /*unused*/, int x) { co_return base + x; }
+  };
+
+  template <class T> inline auto wait(T &&t)
+  {
+#if BOOST_OUTCOME_HAVE_NOOP_COROUTINE
+    t.await_suspend({}).resume();
+#else
+    t.await_suspend({});
+#endif
+    return t.await_resume();
+  }
+}  // namespace coroutine_frame_allocation_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_coroutine_frame_allocation, "Tests that coroutine frames are recycled, or allocated with a given allocator")
+{
+  using namespace coroutine_frame_allocation_test;
+  // Frames are recycled by the thread freeing them, so after the first none come from operator new
+  BOOST_CHECK(wait(pooled_chain(1)).value() == 3);
+  global_allocations = 0;
+  for(int n = 0; n < 1000; n++)
+  {
+    BOOST_CHECK(wait(pooled_chain(n)).value() == n + 2);
+    BOOST_CHECK(wait(pooled_eager(n)).value() == n + 1);
+  }
+  BOOST_CHECK(global_allocations == 0);
+
+  // Frames freed upon another thread are recycled by that thread instead
+  {
+    auto t = pooled(5);
+    std::thread([&] { BOOST_CHECK(wait(std::move(t)).value() == 6); }).join();
+  }
+
+  // Coroutines taking an allocator use it for their frame, whichever allocator they use
+  size_t allocated_bytes = 0;
+  {
+    auto t = allocated(std::allocator_arg, counting_allocator<char>(&allocated_bytes, 1), 5);
+    BOOST_CHECK(allocated_bytes > 0);
+    BOOST_CHECK(wait(t).value() == 6);
+  }
+  BOOST_CHECK(allocated_bytes == 0);
+  {
+    object o;
+    auto t = o.allocated(std::allocator_arg, counting_allocator<double>(&allocated_bytes, 2), 5);
+    BOOST_CHECK(allocated_bytes > 0);
+    BOOST_CHECK(wait(t).value() == 10);
+  }
+  BOOST_CHECK(allocated_bytes == 0);
+  {
+    auto t = allocated_generator(std::allocator_arg, counting_allocator<int>(&allocated_bytes, 3), 5);
+    BOOST_CHECK(allocated_bytes > 0);
+    BOOST_CHECK(t().value() == 5);
+    BOOST_CHECK(t().value() == 6);
+  }
+  BOOST_CHECK(allocated_bytes == 0);
+}
+#else
+int main(void)
+{
+  return 0;
+}
+#endif
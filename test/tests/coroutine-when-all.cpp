@@ -0,0 +1,163 @@
+/* Unit testing for outcomes
+(C) 2013-2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <boost/outcome.hpp>
+#include <boost/outcome/coroutine_support.hpp>
+#include <boost/outcome/thread_pool.hpp>
+#include <boost/outcome/try.hpp>
+#include <boost/outcome/when_all.hpp>
+
+#if BOOST_OUTCOME_FOUND_COROUTINE_HEADER
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace coroutine_when_all_test
+{
+  namespace outcome = BOOST_OUTCOME_V2_NAMESPACE;
+  using outcome::awaitables::when_all;
+  using outcome::awaitables::when_any;
+  using executor = outcome::awaitables::thread_pool::executor_type;
+  template <class T> using eager = outcome::awaitables::eager<T>;
+  template <class T> using lazy = outcome::awaitables::lazy<T>;
+  template <class T> using atomic_lazy = outcome::awaitables::atomic_lazy<T, executor>;
+  template <class T> using result = outcome::result<T>;
+
+  // Counts coroutine frames still in existence
+  static std::atomic<int> live{0};
+  struct frame_counter
+  {
+    frame_counter() { ++live; }
+    frame_counter(const frame_counter &) = delete;
+    frame_counter &operator=(const frame_counter &) = delete;
+    ~frame_counter() { --live; }
+  };
+
+  inline lazy<result<int>> lazy_int(int x) { co_return x; }
+  inline eager<result<std::string>> eager_string(const char *x) { co_return std::string(x); }
+  inline lazy<result<double>> lazy_error(boost::system::errc::errc_t e) { co_return boost::system::errc::make_error_code(e); }
+
+  inline lazy<result<int>> sum_of_three()
+  {
+    BOOST_OUTCOME_CO_TRY(auto v, co_await when_all(lazy_int(1), eager_string("two"), lazy_int(3)));
+    co_return std::get<0>(v) + static_cast<int>(std::get<1>(v).size()) + std::get<2>(v);
+  }
+  inline lazy<result<int>> first_error()
+  {
+    BOOST_OUTCOME_CO_TRY(auto v, co_await when_all(lazy_int(1), lazy_error(boost::system::errc::timed_out),
+                                                   lazy_error(boost::system::errc::not_enough_memory)));
+    co_return std::get<0>(v);
+  }
+
+  // Completes upon the pool after sleeping
+  inline atomic_lazy<result<int>> after(executor /*unused*/, int ms, int x)
+  {
+    frame_counter c;
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    co_return x;
+  }
+  inline atomic_lazy<result<int>> fan_out(executor ex)
+  {
+    BOOST_OUTCOME_CO_TRY(auto v, co_await when_all(after(ex, 100, 1), after(ex, 100, 2), after(ex, 100, 3), after(ex, 100, 4), after(ex, 100, 5),
+                                                   after(ex, 100, 6), after(ex, 100, 7), after(ex, 100, 8)));
+    co_return std::apply([](auto... x) { return (x + ...); }, v);
+  }
+  inline atomic_lazy<result<int>> fastest(executor ex)
+  {
+    auto v = co_await when_any(after(ex, 500, 1), after(ex, 10, 2), after(ex, 500, 3));
+    BOOST_OUTCOME_CO_TRY(auto x, std::move(v.second));
+    co_return static_cast<int>(v.first) * 10 + x;
+  }
+
+  template <class T> inline auto wait(T &&t)
+  {
+#if BOOST_OUTCOME_HAVE_NOOP_COROUTINE
+    t.await_suspend({}).resume();
+#else
+    t.await_suspend({});
+#endif
+    while(!t.await_ready())
+    {
+      std::this_thread::yield();
+    }
+    return t.await_resume();
+  }
+}  // namespace coroutine_when_all_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_coroutine_when_all, "Tests that when_all() and when_any() await several awaitables at once")
+{
+  using namespace coroutine_when_all_test;
+  // Inline, lazy awaitables run to completion as they are begun
+  BOOST_CHECK(wait(sum_of_three()).value() == 7);
+  BOOST_CHECK(wait(first_error()).error() == boost::system::errc::timed_out);
+  {
+    auto v = wait(when_any(lazy_int(4), lazy_int(5)));
+    BOOST_CHECK(v.first == 0);
+    BOOST_CHECK(v.second.value() == 4);
+  }
+  {
+    // Already completed eager awaitables need not suspend
+    auto all = when_all(eager_string("a"), eager_string("b"));
+    BOOST_CHECK(all.await_ready());
+    BOOST_CHECK(std::get<1>(all.await_resume().value()) == "b");
+  }
+
+  outcome::awaitables::thread_pool pool(8);
+  {
+    // The eight run concurrently, so take little longer than one of them
+    const auto begin = std::chrono::steady_clock::now();
+    BOOST_CHECK(wait(fan_out(pool.get_executor())).value() == 36);
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin).count();
+    BOOST_CHECK(elapsed < 800);
+  }
+  BOOST_CHECK(live == 0);
+  {
+    // The slower two are abandoned, and destroy themselves once they complete
+    const auto begin = std::chrono::steady_clock::now();
+    BOOST_CHECK(wait(fastest(pool.get_executor())).value() == 12);
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin).count();
+    BOOST_CHECK(elapsed < 500);
+    BOOST_CHECK(live == 2);
+  }
+  while(live != 0)
+  {
+    std::this_thread::yield();
+  }
+}
+#else
+int main(void)
+{
+  return 0;
+}
+#endif
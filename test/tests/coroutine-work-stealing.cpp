@@ -0,0 +1,151 @@
+/* Unit testing for outcomes
+(C) 2013-2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <boost/outcome.hpp>
+#include <boost/outcome/coroutine_support.hpp>
+#include <boost/outcome/sync_wait.hpp>
+#include <boost/outcome/try.hpp>
+#include <boost/outcome/when_all.hpp>
+#include <boost/outcome/work_stealing_pool.hpp>
+
+#if BOOST_OUTCOME_FOUND_COROUTINE_HEADER
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace coroutine_work_stealing_test
+{
+  namespace outcome = BOOST_OUTCOME_V2_NAMESPACE;
+  using outcome::awaitables::spawn;
+  using outcome::awaitables::sync_wait;
+  using outcome::awaitables::when_all;
+  using outcome::awaitables::work_stealing_pool;
+  using executor = work_stealing_pool::executor_type;
+  template <class T> using lazy = outcome::awaitables::lazy<T>;
+  template <class T> using atomic_lazy = outcome::awaitables::atomic_lazy<T, executor>;
+  template <class T> using result = outcome::result<T>;
+
+  inline lazy<result<int>> lazy_int(int x) { co_return x; }
+  inline lazy<result<bool>> on_pool(executor ex) { co_return ex.running_in_this_thread(); }
+
+  inline long serial_fib(int n) { return n < 2 ? n : serial_fib(n - 1) + serial_fib(n - 2); }
+  // Every call at or below the cutoff is done serially
+  inline atomic_lazy<result<long>> fib(executor ex, int n, int cutoff)
+  {
+    if(n < 0)
+    {
+      co_return boost::system::errc::invalid_argument;
+    }
+    if(n <= cutoff)
+    {
+      co_return serial_fib(n);
+    }
+    BOOST_OUTCOME_CO_TRY(auto v, co_await when_all(fib(ex, n - 1, cutoff), fib(ex, n - 2, cutoff)));
+    co_return std::get<0>(v) + std::get<1>(v);
+  }
+  inline atomic_lazy<result<uint64_t>> sum(executor ex, const uint32_t *begin, size_t count)
+  {
+    if(count <= 65536)
+    {
+      co_return std::accumulate(begin, begin + count, uint64_t(0));
+    }
+    BOOST_OUTCOME_CO_TRY(auto v, co_await when_all(sum(ex, begin, count / 2), sum(ex, begin + count / 2, count - count / 2)));
+    co_return std::get<0>(v) + std::get<1>(v);
+  }
+
+
+  // Counts coroutine frames begun, and those still in existence
+  static std::atomic<int> begun{0}, live{0};
+  struct frame_counter
+  {
+    frame_counter() { ++begun, ++live; }
+    frame_counter(const frame_counter &) = delete;
+    frame_counter &operator=(const frame_counter &) = delete;
+    ~frame_counter() { --live; }
+  };
+  inline atomic_lazy<result<int>> counted(executor /*unused*/, int x)
+  {
+    frame_counter c;
+    std::this_thread::yield();
+    co_return x;
+  }
+}  // namespace coroutine_work_stealing_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_coroutine_work_stealing, "Tests that the work stealing pool runs awaitables")
+{
+  using namespace coroutine_work_stealing_test;
+  // Awaitables without an executor complete upon the waiting thread
+  BOOST_CHECK(sync_wait(lazy_int(5)).value() == 5);
+  {
+    work_stealing_pool pool(4);
+    auto ex = pool.get_executor();
+    // Spawned awaitables begin upon the pool immediately
+    BOOST_CHECK(sync_wait(spawn(ex, on_pool(ex))).value());
+    BOOST_CHECK(!sync_wait(on_pool(ex)).value());
+    {
+      std::vector<outcome::awaitables::atomic_eager<result<long>, executor>> spawned;
+      for(int n = 0; n < 100; n++)
+      {
+        spawned.push_back(spawn(ex, fib(ex, n % 20, 1)));
+      }
+      for(int n = 0; n < 100; n++)
+      {
+        BOOST_CHECK(sync_wait(spawned[n]).value() == serial_fib(n % 20));
+      }
+    }
+    // Dropping what spawn() returned detaches it, so it runs to completion upon the pool and then destroys itself
+    for(int n = 0; n < 100; n++)
+    {
+      (void) spawn(ex, counted(ex, n));
+    }
+    while(begun != 100 || live != 0)
+    {
+      std::this_thread::yield();
+    }
+    // A coroutine per call, spread across the pool by stealing
+    BOOST_CHECK(sync_wait(fib(ex, 20, 1)).value() == 6765);
+    BOOST_CHECK(sync_wait(fib(ex, -1, 1)).error() == boost::system::errc::invalid_argument);
+    // A parallel sum, split until each part is small enough
+    std::vector<uint32_t> values(1 << 18);
+    std::iota(values.begin(), values.end(), 0);
+    BOOST_CHECK(sync_wait(sum(ex, values.data(), values.size())).value() == std::accumulate(values.begin(), values.end(), uint64_t(0)));
+  }
+}
+#else
+int main(void)
+{
+  return 0;
+}
+#endif
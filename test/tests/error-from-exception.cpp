@@ -0,0 +1,167 @@
+/* Unit testing for outcomes
+(C) 2013-2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <boost/outcome/utils.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <ios>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace error_from_exception_test
+{
+  struct custom_out_of_range : std::out_of_range
+  {
+    custom_out_of_range()
+        : std::out_of_range("custom")
+    {
+    }
+  };
+  struct mixin
+  {
+    int x{5};
+    virtual ~mixin() = default;
+  };
+  // The system_error base is not at offset zero, so its code() must be read through an adjusted pointer
+  struct custom_system_error : mixin, std::system_error
+  {
+    custom_system_error()
+        : std::system_error(std::make_error_code(std::errc::device_or_resource_busy))
+    {
+    }
+  };
+  struct unknown
+  {
+  };
+
+  inline std::vector<std::exception_ptr> make_exceptions()
+  {
+    return {std::make_exception_ptr(std::invalid_argument("")),
+            std::make_exception_ptr(std::domain_error("")),
+            std::make_exception_ptr(std::length_error("")),
+            std::make_exception_ptr(std::out_of_range("")),
+            std::make_exception_ptr(std::logic_error("")),
+            std::make_exception_ptr(std::system_error(std::make_error_code(std::errc::no_such_file_or_directory))),
+            std::make_exception_ptr(std::ios_base::failure("")),
+            std::make_exception_ptr(std::overflow_error("")),
+            std::make_exception_ptr(std::range_error("")),
+            std::make_exception_ptr(std::runtime_error("")),
+            std::make_exception_ptr(std::bad_alloc()),
+            std::make_exception_ptr(custom_out_of_range()),
+            std::make_exception_ptr(custom_system_error()),
+            std::make_exception_ptr(std::bad_cast()),
+            std::make_exception_ptr(unknown()),
+            std::make_exception_ptr(5)};
+  }
+}  // namespace error_from_exception_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_error_from_exception, "Tests that error_from_exception() matches every exception type as rethrowing it would")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  const std::error_code not_matched = std::make_error_code(std::errc::state_not_recoverable);
+  BOOST_CHECK(!error_from_exception(std::exception_ptr()));
+  auto exceptions = error_from_exception_test::make_exceptions();
+  // Twice, so the second time is served from the cache
+  for(int n = 0; n < 2; n++)
+  {
+    for(const auto &e : exceptions)
+    {
+      std::exception_ptr a(e), b(e);
+      auto ec = error_from_exception(std::move(a), not_matched);
+      auto expected = detail::error_from_exception_rethrow(b, not_matched);
+      BOOST_CHECK(ec == expected);
+      // The exception is consumed only if it was matched
+      BOOST_CHECK(!a == !b);
+    }
+  }
+  std::exception_ptr ep = exceptions[12];
+  BOOST_CHECK(error_from_exception(std::move(ep)) == std::errc::device_or_resource_busy);
+  BOOST_CHECK(!ep);
+  ep = exceptions[14];
+  BOOST_CHECK(error_from_exception(std::move(ep), not_matched) == not_matched);
+  BOOST_CHECK(ep);
+  try
+  {
+    throw std::length_error("");
+  }
+  catch(...)
+  {
+    BOOST_CHECK(error_from_exception() == std::errc::argument_list_too_long);
+  }
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_error_from_exception_threaded, "Tests error_from_exception() from many threads at once")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  const auto exceptions = error_from_exception_test::make_exceptions();
+  std::vector<std::error_code> expected;
+  for(const auto &e : exceptions)
+  {
+    std::exception_ptr b(e);
+    expected.push_back(detail::error_from_exception_rethrow(b, {}));
+  }
+  const unsigned threads = (std::max)(2U, (std::min)(8U, std::thread::hardware_concurrency()));
+  auto run = [&](bool rethrow) {
+    std::atomic<unsigned> ready{0};
+    std::atomic<size_t> mismatches{0};
+    std::vector<std::thread> workers;
+    for(unsigned t = 0; t < threads; t++)
+    {
+      workers.emplace_back([&] {
+        ++ready;
+        while(ready < threads)
+        {
+          std::this_thread::yield();
+        }
+        for(size_t n = 0; n < 2000; n++)
+        {
+          const size_t idx = n % exceptions.size();
+          std::exception_ptr e(exceptions[idx]);
+          auto ec = rethrow ? detail::error_from_exception_rethrow(e, {}) : error_from_exception(std::move(e), {});
+          if(ec != expected[idx])
+          {
+            ++mismatches;
+          }
+        }
+      });
+    }
+    for(auto &w : workers)
+    {
+      w.join();
+    }
+    BOOST_CHECK(mismatches == 0);
+  };
+  run(true);
+  run(false);
+}
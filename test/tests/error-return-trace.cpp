@@ -0,0 +1,155 @@
+/* Unit testing for outcomes
+(C) 2013-2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#define BOOST_OUTCOME_ENABLE_ERROR_RETURN_TRACE 1
+#include <boost/outcome.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+
+#include <cstring>
+#include <thread>
+
+namespace error_return_trace_test
+{
+  namespace outcome = BOOST_OUTCOME_V2_NAMESPACE;
+
+  inline outcome::result<int> leaf(int x)
+  {
+    if(x < 0)
+    {
+      return boost::system::errc::invalid_argument;
+    }
+    return x;
+  }
+  static const unsigned middle_line = __LINE__ + 3;
+  inline outcome::result<int> middle(int x)
+  {
+    BOOST_OUTCOME_TRY(auto v, leaf(x));
+    return v + 1;
+  }
+  static const unsigned top_line = __LINE__ + 3;
+  inline outcome::result<int> top(int x)
+  {
+    BOOST_OUTCOME_TRY(auto v, middle(x));
+    return v * 2;
+  }
+  inline outcome::outcome<int> outcome_top(int x)
+  {
+    BOOST_OUTCOME_TRY(auto v, top(x));
+    return v;
+  }
+  inline outcome::result<int> recurse(int depth, int x)
+  {
+    if(depth == 0)
+    {
+      return leaf(x);
+    }
+    BOOST_OUTCOME_TRY(auto v, recurse(depth - 1, x));
+    return v;
+  }
+  inline uint16_t last_record() noexcept { return outcome::detail::error_return_trace_ring_instance().last_id; }
+}  // namespace error_return_trace_test
+
+// The same functions without error return tracing, to compare against
+#undef BOOST_OUTCOME_TRY_RECORD_ERROR_RETURN
+#define BOOST_OUTCOME_TRY_RECORD_ERROR_RETURN(f)
+
+namespace error_return_trace_test
+{
+  inline outcome::result<int> untraced_middle(int x)
+  {
+    BOOST_OUTCOME_TRY(auto v, leaf(x));
+    return v + 1;
+  }
+  inline outcome::result<int> untraced_top(int x)
+  {
+    BOOST_OUTCOME_TRY(auto v, untraced_middle(x));
+    return v * 2;
+  }
+}  // namespace error_return_trace_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_error_return_trace, "Tests that BOOST_OUTCOME_TRY records the path taken by a failure")
+{
+  using namespace error_return_trace_test;
+  {
+    auto r = top(-1);
+    BOOST_REQUIRE(r.has_error());
+    const auto trace = outcome::error_return_trace_of(r);
+    BOOST_REQUIRE(trace.size() == 2);
+    BOOST_CHECK(0 == std::strcmp(trace[0].file, __FILE__));
+    BOOST_CHECK(trace[0].line == middle_line);
+    BOOST_CHECK(trace[1].line == top_line);
+    // Each failure has its own trace
+    auto s = middle(-1);
+    BOOST_CHECK(outcome::error_return_trace_of(s).size() == 1);
+    BOOST_CHECK(outcome::error_return_trace_of(r).size() == 2);
+    // Failures which never passed through a TRY have no trace
+    BOOST_CHECK(outcome::error_return_trace_of(leaf(-1)).empty());
+    // Outcomes and failure types carry traces too
+    auto o = outcome_top(-1);
+    BOOST_REQUIRE(o.has_error());
+    BOOST_CHECK(outcome::error_return_trace_of(o).size() == 3);
+    BOOST_CHECK(outcome::error_return_trace_of(o.as_failure()).size() == 3);
+    // Traces are per thread, and are never confused with those recorded by the thread reading them
+    size_t other = 99;
+    std::thread(
+    [&]
+    {
+      for(int n = 0; n < 4; n++)
+      {
+        BOOST_CHECK(outcome::error_return_trace_of(top(-1)).size() == 2);
+      }
+      other = outcome::error_return_trace_of(r).size();
+    })
+    .join();
+    BOOST_CHECK(other == 0);
+  }
+  {
+    // The success path records nothing
+    const auto before = last_record();
+    BOOST_CHECK(top(1).value() == 4);
+    BOOST_CHECK(outcome_top(1).value() == 4);
+    BOOST_CHECK(last_record() == before);
+    // Nor does the failure path with recording disabled
+    BOOST_CHECK(untraced_top(-1).has_error());
+    BOOST_CHECK(last_record() == before);
+  }
+  {
+    // Only the most recent BOOST_OUTCOME_ERROR_RETURN_TRACE_DEPTH sites are kept
+    auto r = recurse(BOOST_OUTCOME_ERROR_RETURN_TRACE_DEPTH + 8, -1);
+    const auto trace = outcome::error_return_trace_of(r);
+    BOOST_CHECK(trace.size() == BOOST_OUTCOME_ERROR_RETURN_TRACE_DEPTH);
+    for(const auto &site : trace)
+    {
+      BOOST_CHECK(site.line == trace[0].line);
+    }
+    auto s = recurse(3, -1);
+    BOOST_CHECK(outcome::error_return_trace_of(s).size() == 3);
+  }
+}
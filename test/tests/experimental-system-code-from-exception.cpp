@@ -0,0 +1,195 @@
+/* Unit testing for outcomes
+(C) 2013-2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <boost/outcome/config.hpp>
+#include <boost/outcome/experimental/status-code/system_code_from_exception.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace system_code_from_exception_test
+{
+  namespace sys = BOOST_OUTCOME_SYSTEM_ERROR2_NAMESPACE;
+
+  class unknown_category : public std::error_category
+  {
+  public:
+    const char *name() const noexcept override { return "unknown"; }
+    std::string message(int /*unused*/) const override { return "unknown"; }
+  };
+  inline const std::error_category &unknown() noexcept
+  {
+    static unknown_category c;
+    return c;
+  }
+
+  // A third party exception carrying its own error number
+  struct vendor_exception : std::runtime_error
+  {
+    int errnum;
+    explicit vendor_exception(int _errnum)
+        : std::runtime_error("vendor")
+        , errnum(_errnum)
+    {
+    }
+  };
+  struct derived_vendor_exception : vendor_exception
+  {
+    derived_vendor_exception()
+        : vendor_exception(ETIMEDOUT)
+    {
+    }
+  };
+  inline sys::system_code from_vendor_exception(const vendor_exception &e)
+  {
+    // Zero has no equivalent, so leave it to the next matching conversion
+    if(e.errnum == 0)
+    {
+      return {};
+    }
+    return sys::generic_code(static_cast<sys::errc>(e.errnum));
+  }
+
+  inline std::vector<std::exception_ptr> make_exceptions()
+  {
+    return {std::make_exception_ptr(std::invalid_argument("")),
+            std::make_exception_ptr(std::domain_error("")),
+            std::make_exception_ptr(std::length_error("")),
+            std::make_exception_ptr(std::out_of_range("")),
+            std::make_exception_ptr(std::logic_error("")),
+            std::make_exception_ptr(std::system_error(std::make_error_code(std::errc::no_such_file_or_directory))),
+            std::make_exception_ptr(std::system_error(EACCES, std::system_category())),
+            std::make_exception_ptr(std::system_error(5, unknown())),
+            std::make_exception_ptr(std::overflow_error("")),
+            std::make_exception_ptr(std::range_error("")),
+            std::make_exception_ptr(std::runtime_error("")),
+            std::make_exception_ptr(std::bad_alloc()),
+            std::make_exception_ptr(sys::status_error<sys::_generic_code_domain>(sys::generic_code(sys::errc::filename_too_long))),
+            std::make_exception_ptr(vendor_exception(EPERM)),
+            std::make_exception_ptr(vendor_exception(0)),
+            std::make_exception_ptr(derived_vendor_exception()),
+            std::make_exception_ptr(5)};
+  }
+  // Whether both converted the same, and consumed the exception the same
+  inline bool same_as_rethrowing(const std::exception_ptr &e)
+  {
+    std::exception_ptr a(e), b(e);
+    auto x = sys::system_code_from_exception(std::move(a), sys::generic_code(sys::errc::state_not_recoverable));
+    auto y = sys::detail::system_code_from_exception_rethrow(b, sys::generic_code(sys::errc::state_not_recoverable));
+    return x == y && !a == !b;
+  }
+}  // namespace system_code_from_exception_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_status_code_system_code_from_exception, "Tests that system_code_from_exception() matches rethrowing, and uses registered conversions")
+{
+  namespace sys = BOOST_OUTCOME_SYSTEM_ERROR2_NAMESPACE;
+  using namespace system_code_from_exception_test;
+  auto exceptions = make_exceptions();
+  BOOST_CHECK(sys::system_code_from_exception(std::exception_ptr()) == sys::errc::success);
+  for(int n = 0; n < 2; n++)
+  {
+    for(const auto &e : exceptions)
+    {
+      BOOST_CHECK(same_as_rethrowing(e));
+    }
+  }
+  {
+    std::exception_ptr ep = exceptions[12];
+    BOOST_CHECK(sys::system_code_from_exception(std::move(ep)) == sys::errc::filename_too_long);
+    BOOST_CHECK(!ep);
+    ep = exceptions[7];
+    BOOST_CHECK(sys::system_code_from_exception(std::move(ep), sys::generic_code(sys::errc::state_not_recoverable)) == sys::errc::state_not_recoverable);
+    BOOST_CHECK(!ep);
+    ep = exceptions[16];
+    BOOST_CHECK(sys::system_code_from_exception(std::move(ep), sys::generic_code(sys::errc::state_not_recoverable)) == sys::errc::state_not_recoverable);
+    BOOST_CHECK(ep);
+    ep = exceptions[13];
+    BOOST_CHECK(sys::system_code_from_exception(std::move(ep)) == sys::errc::resource_unavailable_try_again);
+  }
+
+  BOOST_REQUIRE(sys::register_system_code_from_exception<vendor_exception>(from_vendor_exception));
+  for(const auto &e : exceptions)
+  {
+    BOOST_CHECK(same_as_rethrowing(e));
+  }
+  std::exception_ptr ep = exceptions[13];
+  BOOST_CHECK(sys::system_code_from_exception(std::move(ep)) == sys::errc::operation_not_permitted);
+  BOOST_CHECK(!ep);
+  // An empty code from a registered conversion falls through to the runtime_error conversion
+  ep = exceptions[14];
+  BOOST_CHECK(sys::system_code_from_exception(std::move(ep)) == sys::errc::resource_unavailable_try_again);
+  ep = exceptions[15];
+  BOOST_CHECK(sys::system_code_from_exception(std::move(ep)) == sys::errc::timed_out);
+  // Registered conversions take precedence over the built in ones
+  BOOST_REQUIRE(sys::register_system_code_from_exception<std::bad_alloc>([](const std::bad_alloc &) -> sys::system_code { return sys::generic_code(sys::errc::no_buffer_space); }));
+  ep = exceptions[11];
+  BOOST_CHECK(sys::system_code_from_exception(std::move(ep)) == sys::errc::no_buffer_space);
+  BOOST_CHECK(same_as_rethrowing(exceptions[11]));
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_status_code_system_code_from_exception_threaded, "Tests system_code_from_exception() from many threads at once")
+{
+  namespace sys = BOOST_OUTCOME_SYSTEM_ERROR2_NAMESPACE;
+  const auto exceptions = system_code_from_exception_test::make_exceptions();
+  const unsigned threads = (std::max)(2U, (std::min)(8U, std::thread::hardware_concurrency()));
+  auto run = [&](bool rethrow) {
+    std::atomic<unsigned> ready{0};
+    std::atomic<size_t> matched{0};
+    std::vector<std::thread> workers;
+    for(unsigned t = 0; t < threads; t++)
+    {
+      workers.emplace_back([&] {
+        ++ready;
+        while(ready < threads)
+        {
+          std::this_thread::yield();
+        }
+        for(size_t n = 0; n < 2000; n++)
+        {
+          std::exception_ptr e(exceptions[n % exceptions.size()]);
+          auto ec = rethrow ? sys::detail::system_code_from_exception_rethrow(e, {}) : sys::system_code_from_exception(std::move(e), {});
+          if(!ec.empty())
+          {
+            ++matched;
+          }
+        }
+      });
+    }
+    for(auto &w : workers)
+    {
+      w.join();
+    }
+    return matched.load();
+  };
+  BOOST_CHECK(run(true) == run(false));
+}
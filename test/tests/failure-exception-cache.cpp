@@ -0,0 +1,89 @@
+/* Unit testing for outcomes
+(C) 2013-2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <boost/outcome.hpp>
+#include <boost/outcome/std_outcome.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+
+#include <thread>
+
+// Opt boost::system::error_code into having its synthesised exceptions cached
+BOOST_OUTCOME_V2_NAMESPACE_BEGIN
+namespace trait
+{
+  template <> struct is_failure_exception_cached<boost::system::error_code>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace trait
+BOOST_OUTCOME_V2_NAMESPACE_END
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_outcome_failure_exception_cache, "Tests that failure() synthesises an exception once per error code when opted in")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  outcome<int> a(boost::system::errc::invalid_argument), b(boost::system::errc::invalid_argument), c(boost::system::errc::not_enough_memory);
+  auto ea = a.failure();
+  BOOST_REQUIRE(ea);
+  // The same exception is returned for the same code, even from a different outcome
+  BOOST_CHECK(a.failure() == ea);
+  BOOST_CHECK(b.failure() == ea);
+  auto ec = c.failure();
+  BOOST_CHECK(ec != ea);
+  BOOST_CHECK(c.failure() == ec);
+  try
+  {
+    boost::rethrow_exception(ea);
+  }
+  catch(const boost::system::system_error &e)
+  {
+    BOOST_CHECK(e.code() == boost::system::errc::invalid_argument);
+  }
+
+  // Exceptions already present are returned as is, and are never cached
+  outcome<int> d(boost::copy_exception(std::runtime_error("d")));
+  BOOST_CHECK(d.failure() == d.exception());
+  BOOST_CHECK(a.failure() == ea);
+
+  // Each thread has its own cache
+  boost::exception_ptr other;
+  std::thread([&] { other = a.failure(); }).join();
+  BOOST_CHECK(other);
+  BOOST_CHECK(other != ea);
+  BOOST_CHECK(a.failure() == ea);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_outcome_failure_exception_uncached, "Tests that failure() synthesises a new exception each time when not opted in")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  std_outcome<int> a(std::errc::invalid_argument);
+  auto ea = a.failure();
+  BOOST_REQUIRE(ea);
+  BOOST_CHECK(a.failure() != ea);
+}
@@ -0,0 +1,140 @@
+/* Unit testing for outcomes
+(C) 2013-2022 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <boost/outcome.hpp>
+#include <boost/outcome/try.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+
+namespace has_niche_test
+{
+  // A pointer which is never null when observable
+  class non_null_ptr
+  {
+    int *_v;
+
+  public:
+    constexpr explicit non_null_ptr(int *v) noexcept
+        : _v(v)
+    {
+    }
+    constexpr int *get() const noexcept { return _v; }
+    constexpr bool operator==(const non_null_ptr &o) const noexcept { return _v == o._v; }
+    constexpr bool operator!=(const non_null_ptr &o) const noexcept { return _v != o._v; }
+  };
+
+  // An error code whose zero value means no error, and so can never be a valid error
+  struct code
+  {
+    int v;
+    constexpr explicit code(int _v) noexcept
+        : v(_v)
+    {
+    }
+    constexpr explicit operator int() const noexcept { return v; }
+    constexpr bool operator==(const code &o) const noexcept { return v == o.v; }
+  };
+}  // namespace has_niche_test
+
+BOOST_OUTCOME_V2_NAMESPACE_BEGIN
+template <> struct trait::has_niche<has_niche_test::non_null_ptr>
+{
+  static constexpr bool value = true;
+  static constexpr has_niche_test::non_null_ptr make_niche() noexcept { return has_niche_test::non_null_ptr(nullptr); }
+  static constexpr bool is_niche(const has_niche_test::non_null_ptr &v) noexcept { return v.get() == nullptr; }
+};
+template <> struct trait::has_niche<has_niche_test::code>
+{
+  static constexpr bool value = true;
+  static constexpr has_niche_test::code make_niche() noexcept { return has_niche_test::code(0); }
+  static constexpr bool is_niche(const has_niche_test::code &v) noexcept { return v.v == 0; }
+};
+BOOST_OUTCOME_V2_NAMESPACE_END
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_trait_has_niche, "Tests that a result of a type with a niche and void keeps its status in the niche")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  using has_niche_test::code;
+  using has_niche_test::non_null_ptr;
+  static_assert(!trait::has_niche<int>::value, "int should not have a niche by default!");
+  static_assert(!trait::has_niche<int *>::value, "int * should not have a niche by default!");
+  static_assert(trait::has_niche<non_null_ptr>::is_niche(trait::has_niche<non_null_ptr>::make_niche()), "make_niche() is not a niche!");
+
+  // The status takes no storage of its own
+  static_assert(sizeof(result<non_null_ptr, void>) == sizeof(int *), "result<non_null_ptr, void> is not pointer sized!");
+  static_assert(sizeof(unchecked<void, code>) == sizeof(int), "unchecked<void, code> is not int sized!");
+  static_assert(std::is_trivially_copyable<result<non_null_ptr, void>>::value, "result<non_null_ptr, void> is not trivially copyable!");
+  // Only one of value and error can be encoded in the niche
+  static_assert(sizeof(result<non_null_ptr, int>) > sizeof(int *), "result<non_null_ptr, int> should not use the niche!");
+
+  int x = 5;
+  {
+    result<non_null_ptr, void> r{non_null_ptr(&x)};
+    BOOST_CHECK(r.has_value());
+    BOOST_CHECK(!r.has_error());
+    BOOST_CHECK(*r.value().get() == 5);
+    result<non_null_ptr, void> f{in_place_type<void>};
+    BOOST_CHECK(!f.has_value());
+    BOOST_CHECK(f.has_error());
+    BOOST_CHECK(r != f);
+    swap(r, f);
+    BOOST_CHECK(r.has_error());
+    BOOST_CHECK(*f.value().get() == 5);
+    r = f;
+    BOOST_CHECK(r == f);
+  }
+  {
+    unchecked<void, code> r{success()};
+    BOOST_CHECK(r.has_value());
+    BOOST_CHECK(!r.has_error());
+    unchecked<void, code> f{code(78)};
+    BOOST_CHECK(f.has_error());
+    BOOST_CHECK(f.error().v == 78);
+    BOOST_CHECK(hooks::spare_storage(&f) == 0);
+
+    // Converts to and from the usual layout
+    unchecked<void, int> i(f);
+    BOOST_CHECK(i.has_error());
+    BOOST_CHECK(i.error() == 78);
+    unchecked<void, code> c(unchecked<void, int>{success()});
+    BOOST_CHECK(c.has_value());
+
+    auto op = [](unchecked<void, code> v) -> unchecked<void, code> {
+      BOOST_OUTCOME_TRY(v);
+      return code(5);
+    };
+    BOOST_CHECK(op(r).error().v == 5);
+    BOOST_CHECK(op(f).error().v == 78);
+  }
+  {
+    constexpr unchecked<void, code> r{success()};
+    constexpr unchecked<void, code> f{code(78)};
+    static_assert(r.has_value() && f.has_error() && f.assume_error().v == 78, "niche status is not constexpr!");
+  }
+}
@@ -0,0 +1,138 @@
+/* Unit testing for outcomes
+(C) 2013-2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <boost/outcome/lazy_exception_ptr.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+
+#include <cstring>
+
+namespace lazy_exception_ptr_test
+{
+  static int synthesised;
+  inline std::exception_ptr counting_factory(const std::error_code &ec, const char *message)
+  {
+    ++synthesised;
+    return std::make_exception_ptr(std::system_error(ec, message));
+  }
+}  // namespace lazy_exception_ptr_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_outcome_lazy_exception_ptr, "Tests that a lazy exception pointer synthesises its exception only when needed")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  using lazy_exception_ptr_test::counting_factory;
+  using lazy_exception_ptr_test::synthesised;
+  using lazy_outcome = std_outcome<int, std::error_code, std_lazy_exception_ptr>;
+  static_assert(trait::is_exception_ptr_available<std_lazy_exception_ptr>::value, "");
+  static_assert(std::is_same<trait::is_exception_ptr_available<std_lazy_exception_ptr>::type, std::exception_ptr>::value, "");
+  static_assert(!std::is_convertible<std_lazy_exception_ptr, std::exception_ptr>::value, "");
+  const std::error_code ec = std::make_error_code(std::errc::invalid_argument);
+  {
+    lazy_outcome a(std_lazy_exception_ptr(ec, "parsing", counting_factory));
+    // Copying, moving and inspecting the failure does not synthesise anything
+    lazy_outcome b(a), c(std::move(b));
+    BOOST_CHECK(a.has_failure());
+    BOOST_CHECK(a.has_exception());
+    BOOST_CHECK(!a.has_error());
+    BOOST_CHECK(a.exception().is_deferred());
+    BOOST_CHECK(a.exception().code() == ec);
+    BOOST_CHECK(0 == std::strcmp(a.exception().message(), "parsing"));
+    BOOST_CHECK(a == c);
+    BOOST_CHECK(a.failure().is_deferred());
+    BOOST_CHECK(synthesised == 0);
+    // Observing the value rethrows a newly synthesised exception
+    try
+    {
+      (void) a.value();
+      BOOST_CHECK(false);
+    }
+    catch(const std::system_error &e)
+    {
+      BOOST_CHECK(e.code() == ec);
+      BOOST_CHECK(std::strstr(e.what(), "parsing") != nullptr);
+    }
+    BOOST_CHECK(synthesised == 1);
+    BOOST_CHECK(a.exception().get() != a.exception().get());
+    BOOST_CHECK(synthesised == 3);
+    // Materialising caches the exception
+    const std::exception_ptr e = a.exception().materialise();
+    BOOST_CHECK(!a.exception().is_deferred());
+    BOOST_CHECK(a.exception().get() == e);
+    BOOST_CHECK(a.exception().materialise() == e);
+    BOOST_CHECK(synthesised == 4);
+    BOOST_CHECK(a != c);
+    BOOST_CHECK_THROW(a.value(), std::system_error);
+    BOOST_CHECK(synthesised == 4);
+    // Explicit conversion into an outcome with an exception pointer synthesises
+    std_outcome<int> d(c);
+    BOOST_CHECK(d.has_exception());
+    BOOST_CHECK(synthesised == 5);
+    BOOST_CHECK_THROW(d.value(), std::system_error);
+  }
+  {
+    // Exception pointers convert implicitly, and are not deferred
+    lazy_outcome a(std::make_exception_ptr(std::runtime_error("hi")));
+    BOOST_CHECK(!a.exception().is_deferred());
+    BOOST_CHECK(static_cast<bool>(a.exception()));
+    BOOST_CHECK_THROW(a.value(), std::runtime_error);
+    lazy_outcome b(std_outcome<int>(std::make_exception_ptr(std::runtime_error("hi"))));
+    BOOST_CHECK(b.has_exception());
+    // Errors and values work as usual
+    lazy_outcome c(ec), d(5);
+    BOOST_CHECK(c.has_error());
+    BOOST_CHECK_THROW(c.value(), std::system_error);
+    BOOST_CHECK(d.value() == 5);
+    BOOST_CHECK(!std_lazy_exception_ptr());
+  }
+  {
+    // The default factory synthesises what .failure() would, and Boost's types work too
+    std_lazy_exception_ptr a(ec);
+    BOOST_CHECK(static_cast<bool>(a));
+    try
+    {
+      std::rethrow_exception(a.get());
+    }
+    catch(const std::system_error &e)
+    {
+      BOOST_CHECK(e.code() == ec);
+    }
+    boost_outcome<int, boost::system::error_code, lazy_exception_ptr> b(lazy_exception_ptr(boost::system::errc::make_error_code(boost::system::errc::invalid_argument), "boost"));
+    BOOST_CHECK(b.exception().is_deferred());
+    try
+    {
+      (void) b.value();
+      BOOST_CHECK(false);
+    }
+    catch(const boost::system::system_error &e)
+    {
+      BOOST_CHECK(e.code() == boost::system::errc::invalid_argument);
+      BOOST_CHECK(std::strstr(e.what(), "boost") != nullptr);
+    }
+  }
+}
@@ -0,0 +1,230 @@
+/* Unit testing for outcomes
+(C) 2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <boost/outcome.hpp>
+#include <boost/outcome/try.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+
+#include <string>
+
+namespace monadic
+{
+  // A large value type which counts how often it is copied and moved
+  struct Big
+  {
+    static int copies, moves;
+    std::string v;
+    explicit Big(std::string _v)
+        : v(std::move(_v))
+    {
+    }
+    Big(const Big &o)
+        : v(o.v)
+    {
+      ++copies;
+    }
+    Big(Big &&o) noexcept
+        : v(std::move(o.v))
+    {
+      ++moves;
+    }
+    Big &operator=(const Big &) = default;
+    Big &operator=(Big &&) = default;
+    ~Big() = default;
+  };
+  int Big::copies, Big::moves;
+  inline void reset()
+  {
+    Big::copies = 0;
+    Big::moves = 0;
+  }
+
+  template <class T> using result = BOOST_OUTCOME_V2_NAMESPACE::result<T>;
+  using BOOST_OUTCOME_V2_NAMESPACE::in_place_type;
+
+  inline result<Big> parse(const std::string &s)
+  {
+    if(s.empty())
+    {
+      return boost::system::errc::invalid_argument;
+    }
+    return result<Big>(in_place_type<Big>, s);
+  }
+  inline result<Big> validate(Big &&b)
+  {
+    if(b.v == "bad")
+    {
+      return boost::system::errc::bad_message;
+    }
+    return result<Big>(in_place_type<Big>, b.v + "!");
+  }
+  inline result<Big> enrich(Big &&b) { return result<Big>(in_place_type<Big>, b.v + "?"); }
+
+  // The same pipeline written with TRY
+  inline result<size_t> pipeline_try(const std::string &s)
+  {
+    BOOST_OUTCOME_TRY(auto &&a, parse(s));
+    BOOST_OUTCOME_TRY(auto &&b, validate(std::move(a)));
+    BOOST_OUTCOME_TRY(auto &&c, enrich(std::move(b)));
+    Big d(c.v + ".");
+    return d.v.size();
+  }
+  // And with the monadic operations
+  inline result<size_t> pipeline_monadic(const std::string &s)
+  {
+    return parse(s)
+    .and_then([](Big &&a) { return validate(std::move(a)); })
+    .and_then([](Big &&b) { return enrich(std::move(b)); })
+    .transform([](Big &&c) { return Big(c.v + "."); })
+    .transform([](const Big &d) { return d.v.size(); });
+  }
+}  // namespace monadic
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_result_monadic, "Tests that the monadic operations of result behave as per std::expected")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  const result<int> v(5), e(boost::system::errc::invalid_argument);
+
+  // and_then
+  BOOST_CHECK(v.and_then([](int x) -> result<std::string> { return std::to_string(x); }).value() == "5");
+  BOOST_CHECK(e.and_then([](int x) -> result<std::string> { return std::to_string(x); }).error() == boost::system::errc::invalid_argument);
+  BOOST_CHECK(v.and_then([](int) -> result<std::string> { return boost::system::errc::bad_message; }).error() == boost::system::errc::bad_message);
+
+  // transform
+  auto scale = [](int x) { return x * 1.5; };
+  auto discard = [](int /*unused*/) {};
+  static_assert(std::is_same<decltype(v.transform(scale)), result<double>>::value, "transform() returns the wrong type!");
+  static_assert(std::is_same<decltype(v.transform(discard)), result<void>>::value, "transform() returns the wrong type!");
+  BOOST_CHECK(v.transform(scale).value() == 7.5);
+  BOOST_CHECK(e.transform(scale).error() == boost::system::errc::invalid_argument);
+  BOOST_CHECK(v.transform(discard).has_value());
+
+  // or_else
+  BOOST_CHECK(v.or_else([](const boost::system::error_code &) -> result<int> { return 6; }).value() == 5);
+  BOOST_CHECK(e.or_else([](const boost::system::error_code &) -> result<int> { return 6; }).value() == 6);
+
+  // transform_error
+  auto message = [](const boost::system::error_code &ec) { return ec.message(); };
+  static_assert(std::is_same<decltype(e.transform_error(message))::error_type, std::string>::value, "transform_error() returns the wrong type!");
+  BOOST_CHECK(v.transform_error(message).value() == 5);
+  BOOST_CHECK(!e.transform_error(message).error().empty());
+
+  // void values and errors
+  const result<void> vv = success();
+  BOOST_CHECK(vv.and_then([]() -> result<int> { return 3; }).value() == 3);
+  BOOST_CHECK(vv.transform([] { return 4; }).value() == 4);
+  const result<int, void, policy::all_narrow> ve{in_place_type<void>};
+  BOOST_CHECK((ve.or_else([]() -> result<int, void, policy::all_narrow> { return 8; }).value() == 8));
+  BOOST_CHECK((ve.transform_error([] { return 9L; }).error() == 9L));
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_result_monadic_inplace, "Tests that the monadic operations construct in place and move out of rvalues")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  using monadic::Big;
+  result<Big> r(in_place_type<Big>, "niall");
+
+  // The output of transform is constructed directly from the callable's return
+  monadic::reset();
+  auto a = r.transform([](const Big &b) { return Big(b.v + " douglas"); });
+  BOOST_CHECK(a.value().v == "niall douglas");
+#if __cplusplus >= 201700L || _HAS_CXX17
+  BOOST_CHECK(Big::moves == 0);
+#endif
+  BOOST_CHECK(Big::copies == 0);
+
+  // Rvalue results are moved from, not copied
+  monadic::reset();
+  auto b = std::move(a).transform([](Big &&b) { return std::move(b); });
+  BOOST_CHECK(b.value().v == "niall douglas");
+  BOOST_CHECK(Big::copies == 0);
+  BOOST_CHECK(Big::moves <= 1);
+  monadic::reset();
+  result<Big> c(boost::system::errc::invalid_argument);
+  auto d = std::move(c).transform_error([](boost::system::error_code &&ec) { return ec.value(); });
+  BOOST_CHECK(d.has_error());
+  auto f = std::move(b).or_else([](boost::system::error_code) -> result<Big> { return boost::system::errc::bad_message; });
+  BOOST_CHECK(f.value().v == "niall douglas");
+  BOOST_CHECK(Big::copies == 0);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_result_monadic_vs_try, "Tests that a monadic pipeline never copies more than the equivalent TRY code")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  using monadic::Big;
+  for(const char *input : {"niall", "bad", ""})
+  {
+    monadic::reset();
+    auto a = monadic::pipeline_try(input);
+    const int try_copies = Big::copies, try_moves = Big::moves;
+    monadic::reset();
+    auto b = monadic::pipeline_monadic(input);
+    BOOST_CHECK(a == b);
+    BOOST_CHECK(Big::copies == 0);
+    BOOST_CHECK(Big::copies <= try_copies);
+    BOOST_CHECK(Big::moves <= try_moves);
+  }
+  BOOST_CHECK(monadic::pipeline_monadic("niall").value() == 8);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_outcome_monadic, "Tests that the monadic operations of outcome propagate errors and exceptions")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  const outcome<int> v(5), e(boost::system::errc::invalid_argument), x(boost::copy_exception(std::runtime_error("x"))),
+  ex(make_error_code(boost::system::errc::invalid_argument), boost::copy_exception(std::runtime_error("ex")));
+
+  BOOST_CHECK(v.and_then([](int i) -> outcome<std::string> { return std::to_string(i); }).value() == "5");
+  BOOST_CHECK(e.and_then([](int i) -> outcome<std::string> { return std::to_string(i); }).error() == boost::system::errc::invalid_argument);
+  BOOST_CHECK(x.and_then([](int i) -> outcome<std::string> { return std::to_string(i); }).has_exception());
+  {
+    auto r = ex.transform([](int i) { return std::to_string(i); });
+    BOOST_CHECK(r.has_error() && r.has_exception());
+    BOOST_CHECK_THROW(r.value(), std::runtime_error);
+  }
+  BOOST_CHECK(v.transform([](int i) { return i * 2.5; }).value() == 12.5);
+
+  // or_else only recovers from errors without an exception
+  auto recover = [](const boost::system::error_code &) -> outcome<int> { return 6; };
+  BOOST_CHECK(v.or_else(recover).value() == 5);
+  BOOST_CHECK(e.or_else(recover).value() == 6);
+  BOOST_CHECK(x.or_else(recover).has_exception());
+  BOOST_CHECK(ex.or_else(recover).has_exception());
+  BOOST_CHECK(ex.or_else(recover).has_error());
+
+  // transform_error keeps any exception
+  auto message = [](const boost::system::error_code &ec) { return ec.message(); };
+  BOOST_CHECK(v.transform_error(message).value() == 5);
+  BOOST_CHECK(!e.transform_error(message).error().empty());
+  BOOST_CHECK(x.transform_error(message).has_exception());
+  BOOST_CHECK(!x.transform_error(message).has_error());
+  BOOST_CHECK(ex.transform_error(message).has_exception());
+  BOOST_CHECK(!ex.transform_error(message).error().empty());
+}
@@ -0,0 +1,253 @@
+/* Unit testing for outcomes
+(C) 2013-2022 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#define BOOST_OUTCOME_OVERLAP_NONTRIVIAL_STORAGE 1
+
+#include <boost/outcome.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace overlapped_storage
+{
+  // What a single union of T and E plus the status bitfield ought to cost
+  template <class T, class E> struct expected_layout
+  {
+    union
+    {
+      char _empty;
+      T _value;
+      E _error;
+    };
+    uint32_t _status;
+    expected_layout() = delete;
+    ~expected_layout() = delete;
+  };
+
+  struct counted
+  {
+    static int constructed, destructed;
+    std::string v;
+    explicit counted(std::string _v)
+        : v(std::move(_v))
+    {
+      ++constructed;
+    }
+    counted(const counted &o)
+        : v(o.v)
+    {
+      ++constructed;
+    }
+    counted(counted &&o) noexcept
+        : v(std::move(o.v))
+    {
+      ++constructed;
+    }
+    counted &operator=(const counted &) = default;
+    counted &operator=(counted &&) = default;
+    ~counted() { ++destructed; }
+  };
+  int counted::constructed, counted::destructed;
+
+  struct counted_error
+  {
+    std::vector<int> v;
+    explicit counted_error(int x)
+        : v(4, x)
+    {
+      ++counted::constructed;
+    }
+    counted_error(const counted_error &o)
+        : v(o.v)
+    {
+      ++counted::constructed;
+    }
+    counted_error(counted_error &&o) noexcept
+        : v(std::move(o.v))
+    {
+      ++counted::constructed;
+    }
+    counted_error &operator=(const counted_error &) = default;
+    counted_error &operator=(counted_error &&) = default;
+    ~counted_error() { ++counted::destructed; }
+  };
+
+  // Counts live objects, and throws from the move constructor when `throw_on_move` counts down to zero
+  template <int tag> struct throwing
+  {
+    static int live, throw_on_move;
+    std::string v;
+    explicit throwing(std::string _v)
+        : v(std::move(_v))
+    {
+      ++live;
+    }
+    throwing(const throwing &o)
+        : v(o.v)
+    {
+      ++live;
+    }
+    throwing(throwing &&o)
+        : v(o.v)
+    {
+      if(throw_on_move-- == 0)
+      {
+        throw std::runtime_error("move");
+      }
+      ++live;
+    }
+    throwing &operator=(const throwing &) = default;
+    throwing &operator=(throwing &&) = default;
+    ~throwing() { --live; }
+  };
+  template <int tag> int throwing<tag>::live;
+  template <int tag> int throwing<tag>::throw_on_move = -1;
+}  // namespace overlapped_storage
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_result_overlapped_storage_size, "Tests that overlapped non-trivial storage is no bigger than its largest member")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  using overlapped_storage::expected_layout;
+#define BOOST_OUTCOME_CHECK_OVERLAPPED_SIZE(T, E)                                                                                                              \
+  static_assert(sizeof(result<T, E, policy::all_narrow>) == sizeof(expected_layout<T, E>), "result<" #T ", " #E "> does not overlap its storage!")
+  BOOST_OUTCOME_CHECK_OVERLAPPED_SIZE(std::string, std::error_code);
+  BOOST_OUTCOME_CHECK_OVERLAPPED_SIZE(std::string, boost::system::error_code);
+  BOOST_OUTCOME_CHECK_OVERLAPPED_SIZE(std::vector<int>, std::error_code);
+  BOOST_OUTCOME_CHECK_OVERLAPPED_SIZE(std::unique_ptr<int>, std::error_code);
+  BOOST_OUTCOME_CHECK_OVERLAPPED_SIZE(std::shared_ptr<int>, std::error_code);
+  BOOST_OUTCOME_CHECK_OVERLAPPED_SIZE(int, std::string);
+  BOOST_OUTCOME_CHECK_OVERLAPPED_SIZE(std::string, std::vector<int>);
+  BOOST_OUTCOME_CHECK_OVERLAPPED_SIZE(std::string, std::exception_ptr);
+#undef BOOST_OUTCOME_CHECK_OVERLAPPED_SIZE
+  static_assert(sizeof(result<std::string>) == sizeof(expected_layout<std::string, boost::system::error_code>), "result<std::string> is the wrong size!");
+  static_assert(sizeof(std_result<std::string>) == sizeof(expected_layout<std::string, std::error_code>), "std_result<std::string> is the wrong size!");
+  // outcome adds its exception_ptr after the overlapped storage
+  static_assert(sizeof(outcome<std::string>) == sizeof(expected_layout<std::string, boost::system::error_code>) + sizeof(boost::exception_ptr),
+                "outcome<std::string> is the wrong size!");
+  BOOST_CHECK(sizeof(result<std::string>) < sizeof(std::string) + sizeof(boost::system::error_code) + sizeof(uint32_t));
+  // The overlapped layout must not share its types with translation units using the default layout
+  static_assert(std::is_same<result<std::string>, layout_overlap::result<std::string>>::value, "overlapped layout is not in its own namespace!");
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_result_overlapped_storage_lifetime, "Tests that overlapped non-trivial storage constructs and destroys correctly")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  using overlapped_storage::counted;
+  using overlapped_storage::counted_error;
+  using type = result<counted, counted_error, policy::all_narrow>;
+  {
+    type a(in_place_type<counted>, "niall"), b(in_place_type<counted_error>, 5);
+    BOOST_CHECK(a.value().v == "niall");
+    BOOST_CHECK(b.error().v == std::vector<int>(4, 5));
+
+    // copies and moves
+    type c(a), d(b);
+    BOOST_CHECK(c.value().v == "niall");
+    BOOST_CHECK(d.error().v == std::vector<int>(4, 5));
+    type e(std::move(c)), f(std::move(d));
+    BOOST_CHECK(e.value().v == "niall");
+    BOOST_CHECK(f.error().v == std::vector<int>(4, 5));
+
+    // assignment across states
+    c = b;
+    BOOST_CHECK(c.has_error());
+    BOOST_CHECK(c.error().v == std::vector<int>(4, 5));
+    d = a;
+    BOOST_CHECK(d.has_value());
+    BOOST_CHECK(d.value().v == "niall");
+    c = std::move(d);
+    BOOST_CHECK(c.has_value());
+    BOOST_CHECK(c.value().v == "niall");
+    e = std::move(f);
+    BOOST_CHECK(e.has_error());
+    BOOST_CHECK(e.error().v == std::vector<int>(4, 5));
+
+    // value/error swaps must bounce through a temporary
+    a.swap(b);
+    BOOST_CHECK(a.has_error());
+    BOOST_CHECK(a.error().v == std::vector<int>(4, 5));
+    BOOST_CHECK(b.has_value());
+    BOOST_CHECK(b.value().v == "niall");
+    a.swap(b);
+    BOOST_CHECK(a.value().v == "niall");
+    BOOST_CHECK(b.error().v == std::vector<int>(4, 5));
+    BOOST_CHECK(!a.has_lost_consistency());
+    BOOST_CHECK(!b.has_lost_consistency());
+  }
+  BOOST_CHECK(counted::constructed == counted::destructed);
+  {
+    outcome<std::string> a("niall"), b(boost::system::errc::not_enough_memory);
+    swap(a, b);
+    BOOST_CHECK(a.error() == boost::system::errc::not_enough_memory);
+    BOOST_CHECK(b.value() == "niall");
+    a = b;
+    BOOST_CHECK(a.value() == "niall");
+  }
+}
+
+#ifndef BOOST_NO_EXCEPTIONS
+BOOST_OUTCOME_AUTO_TEST_CASE(works_result_overlapped_storage_swap_throws, "Tests that a throwing value/error swap of overlapped storage puts everything back")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  using value_type = overlapped_storage::throwing<0>;
+  using error_type = overlapped_storage::throwing<1>;
+  using type = result<value_type, error_type, policy::all_narrow>;
+  {
+    type a(in_place_type<value_type>, "value"), b(in_place_type<error_type>, "error");
+    // The error fails to move across
+    error_type::throw_on_move = 0;
+    BOOST_CHECK_THROW(a.swap(b), std::runtime_error);
+    BOOST_CHECK(a.value().v == "value");
+    BOOST_CHECK(b.error().v == "error");
+    BOOST_CHECK(!a.has_lost_consistency());
+    BOOST_CHECK(!b.has_lost_consistency());
+    // The parked value fails to move across
+    value_type::throw_on_move = 1;
+    BOOST_CHECK_THROW(b.swap(a), std::runtime_error);
+    BOOST_CHECK(a.value().v == "value");
+    BOOST_CHECK(b.error().v == "error");
+    BOOST_CHECK(!a.has_lost_consistency());
+    BOOST_CHECK(!b.has_lost_consistency());
+    BOOST_CHECK(value_type::live == 1);
+    BOOST_CHECK(error_type::live == 1);
+    // And succeeds once nothing throws
+    value_type::throw_on_move = error_type::throw_on_move = -1;
+    a.swap(b);
+    BOOST_CHECK(a.error().v == "error");
+    BOOST_CHECK(b.value().v == "value");
+  }
+  BOOST_CHECK(value_type::live == 0);
+  BOOST_CHECK(error_type::live == 0);
+}
+#endif
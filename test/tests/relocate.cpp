@@ -0,0 +1,188 @@
+/* Unit testing for outcomes
+(C) 2013-2022 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <boost/outcome.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+
+#include <memory>
+#include <string>
+
+namespace relocate_test
+{
+  static int alive;
+
+  // A move bitcopying type, and therefore trivially relocatable
+  struct bitcopying
+  {
+    int *v{nullptr};
+    bitcopying() = default;
+    explicit bitcopying(int *_v)
+        : v(_v)
+    {
+      ++alive;
+    }
+    bitcopying(bitcopying &&o) noexcept
+        : v(o.v)
+    {
+      o.v = nullptr;
+    }
+    bitcopying &operator=(bitcopying &&) = delete;
+    ~bitcopying()
+    {
+      if(v != nullptr)
+      {
+        --alive;
+      }
+    }
+  };
+
+  // A type which is not trivially relocatable, as it points into itself
+  struct self_referencing
+  {
+    int v;
+    self_referencing *self{this};
+    explicit self_referencing(int _v)
+        : v(_v)
+    {
+      ++alive;
+    }
+    self_referencing(self_referencing &&o) noexcept
+        : v(o.v)
+    {
+      ++alive;
+    }
+    self_referencing &operator=(self_referencing &&) = delete;
+    ~self_referencing() { --alive; }
+  };
+
+  template <class T> struct raw_buffer
+  {
+    alignas(T) char storage[16 * sizeof(T)];
+    T *get() noexcept { return reinterpret_cast<T *>(storage); }
+  };
+}  // namespace relocate_test
+
+BOOST_OUTCOME_V2_NAMESPACE_BEGIN
+template <> struct trait::is_move_bitcopying<relocate_test::bitcopying>
+{
+  static constexpr bool value = true;
+};
+BOOST_OUTCOME_V2_NAMESPACE_END
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_result_relocate_trait, "Tests that basic_result and basic_outcome report trivial relocatability correctly")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  using relocate_test::bitcopying;
+  using relocate_test::self_referencing;
+  static_assert(trait::is_trivially_relocatable<int>::value, "int is not trivially relocatable!");
+  static_assert(trait::is_trivially_relocatable<bitcopying>::value, "bitcopying is not trivially relocatable!");
+  static_assert(!trait::is_trivially_relocatable<self_referencing>::value, "self_referencing is trivially relocatable!");
+  static_assert(trait::is_trivially_relocatable<result<int, long>>::value, "result<int, long> is not trivially relocatable!");
+  static_assert(trait::is_trivially_relocatable<result<void, long>>::value, "result<void, long> is not trivially relocatable!");
+  static_assert(trait::is_trivially_relocatable<result<bitcopying, long>>::value, "result<bitcopying, long> is not trivially relocatable!");
+  static_assert(!trait::is_trivially_relocatable<result<self_referencing, long>>::value, "result<self_referencing, long> is trivially relocatable!");
+  static_assert(trait::is_trivially_relocatable<outcome<bitcopying, long, void>>::value, "outcome<bitcopying, long, void> is not trivially relocatable!");
+  static_assert(!trait::is_trivially_relocatable<outcome<bitcopying, long, self_referencing>>::value,
+                "outcome<bitcopying, long, self_referencing> is trivially relocatable!");
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_result_relocate_n, "Tests that relocate_n relocates trivially and non-trivially relocatable results")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  using relocate_test::alive;
+  using relocate_test::bitcopying;
+  using relocate_test::raw_buffer;
+  using relocate_test::self_referencing;
+  int values[8];
+  {
+    // Growth into a new buffer, as std::vector would do
+    using type = result<bitcopying, int, policy::all_narrow>;
+    raw_buffer<type> a, b;
+    for(int n = 0; n < 8; n++)
+    {
+      if(n & 1)
+      {
+        new(a.get() + n) type(in_place_type<int>, n);
+      }
+      else
+      {
+        new(a.get() + n) type(in_place_type<bitcopying>, values + n);
+      }
+    }
+    BOOST_CHECK(alive == 4);
+    BOOST_CHECK(relocate_n(a.get(), 8, b.get()) == b.get() + 8);
+    BOOST_CHECK(alive == 4);
+    // Pop two off the front, then compact within the same buffer as a ring buffer would do
+    b.get()[0].~type();
+    b.get()[1].~type();
+    BOOST_CHECK(alive == 3);
+    BOOST_CHECK(relocate_n(b.get() + 2, 6, b.get()) == b.get() + 6);
+    BOOST_CHECK(alive == 3);
+    for(int n = 0; n < 6; n++)
+    {
+      type &r = b.get()[n];
+      if(n & 1)
+      {
+        BOOST_CHECK(r.assume_error() == n + 2);
+      }
+      else
+      {
+        BOOST_CHECK(r.assume_value().v == values + n + 2);
+      }
+      r.~type();
+    }
+    BOOST_CHECK(alive == 0);
+  }
+  {
+    using type = result<self_referencing, int, policy::all_narrow>;
+    raw_buffer<type> a;
+    for(int n = 0; n < 8; n++)
+    {
+      new(a.get() + n) type(in_place_type<self_referencing>, n);
+    }
+    // Overlapping relocation forwards and backwards must call move constructors in a safe order
+    BOOST_CHECK(relocate_n(a.get(), 8, a.get() + 3) == a.get() + 11);
+    for(int n = 0; n < 8; n++)
+    {
+      BOOST_CHECK(a.get()[n + 3].assume_value().v == n);
+      BOOST_CHECK(a.get()[n + 3].assume_value().self == &a.get()[n + 3].assume_value());
+    }
+    BOOST_CHECK(alive == 8);
+    BOOST_CHECK(relocate_n(a.get() + 3, 8, a.get() + 1) == a.get() + 9);
+    for(int n = 0; n < 8; n++)
+    {
+      BOOST_CHECK(a.get()[n + 1].assume_value().v == n);
+      BOOST_CHECK(a.get()[n + 1].assume_value().self == &a.get()[n + 1].assume_value());
+      a.get()[n + 1].~type();
+    }
+    BOOST_CHECK(alive == 0);
+  }
+}
@@ -0,0 +1,243 @@
+/* Unit testing for outcomes
+(C) 2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <boost/outcome/result_array.hpp>
+#include <boost/outcome/std_result.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <system_error>
+#include <vector>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_result_array_basic, "Tests that result_array stores and observes results like a vector of results")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  using array_type = result_array<double, std::error_code, policy::error_code_throw_as_system_error<double, std::error_code, void>>;
+  using result_type = array_type::result_type;
+  array_type a;
+  BOOST_CHECK(a.empty());
+  BOOST_CHECK(a.count_failures() == 0);
+  BOOST_CHECK(a.first_failure() == 0);
+
+  a.push_back(result_type(1.5));
+  a.push_back(result_type(std::make_error_code(std::errc::invalid_argument)));
+  a.emplace_value(2.5);
+  a.emplace_error(std::make_error_code(std::errc::not_enough_memory));
+  BOOST_CHECK(a.size() == 4);
+  BOOST_CHECK(a[0].has_value());
+  BOOST_CHECK(a[0].value() == 1.5);
+  BOOST_CHECK(a[1].has_error());
+  BOOST_CHECK(a[1].error() == std::errc::invalid_argument);
+  BOOST_CHECK(a[2] && a[2].value() == 2.5);
+  BOOST_CHECK(!a[3]);
+  BOOST_CHECK(a.count_failures() == 2);
+  BOOST_CHECK(a.first_failure() == 1);
+
+  // wide observers apply the result's no-value policy
+  BOOST_CHECK_THROW(a[1].value(), std::system_error);
+  BOOST_CHECK_THROW(a[0].error(), bad_result_access);
+
+  // proxies convert to results
+  result_type r = a[1];
+  BOOST_CHECK(r.error() == std::errc::invalid_argument);
+  r = a[2];
+  BOOST_CHECK(r.value() == 2.5);
+
+  // and assign through to the array
+  a[1] = result_type(7.0);
+  BOOST_CHECK(a[1].value() == 7.0);
+  a[0] = a[3];
+  BOOST_CHECK(a[0].error() == std::errc::not_enough_memory);
+  BOOST_CHECK(a.count_failures() == 2);
+  BOOST_CHECK(a.first_failure() == 0);
+
+  a.pop_back();
+  a.pop_back();
+  BOOST_CHECK(a.size() == 2);
+  BOOST_CHECK(a.count_failures() == 1);
+  a.clear();
+  BOOST_CHECK(a.empty());
+  BOOST_CHECK(a.failure_bitmap().empty());
+
+  array_type b{result_type(1.0), result_type(std::make_error_code(std::errc::invalid_argument)), result_type(3.0)};
+  BOOST_CHECK(b.size() == 3);
+  BOOST_CHECK(b.first_failure() == 1);
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_result_array_bulk, "Tests the bulk operations of result_array across many bitmap words")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  using array_type = result_array<double, std::error_code>;
+  using result_type = array_type::result_type;
+  std::vector<result_type> source;
+  for(size_t n = 0; n < 1000; n++)
+  {
+    if(n % 7 == 3 && n > 500)
+    {
+      source.emplace_back(std::make_error_code(std::errc::result_out_of_range));
+    }
+    else
+    {
+      source.emplace_back(static_cast<double>(n));
+    }
+  }
+  array_type a(source.begin(), source.end());
+  BOOST_REQUIRE(a.size() == source.size());
+  BOOST_CHECK(a.failure_bitmap().size() == (1000 + 63) / 64);
+
+  size_t failures = 0, first = source.size();
+  for(size_t n = 0; n < source.size(); n++)
+  {
+    if(source[n].has_error())
+    {
+      ++failures;
+      first = std::min(first, n);
+    }
+  }
+  BOOST_CHECK(a.count_failures() == failures);
+  BOOST_CHECK(a.first_failure() == first);
+  BOOST_CHECK(a.first_failure() == 507);
+
+  // The value array is contiguous, and lines up with the results
+  auto values = a.values_span();
+  BOOST_CHECK(values.size() == a.size());
+  BOOST_CHECK(values[42] == 42.0);
+  BOOST_CHECK(std::accumulate(values.begin(), values.begin() + 500, 0.0) == 499.0 * 500.0 / 2.0);
+  BOOST_CHECK(a.errors_span()[first] == std::errc::result_out_of_range);
+
+  // Iteration yields proxies which compare equal to the source results
+  size_t idx = 0;
+  for(auto r : a)
+  {
+    BOOST_CHECK(static_cast<result_type>(r) == source[idx]);
+    ++idx;
+  }
+  BOOST_CHECK(idx == a.size());
+  const array_type &ca = a;
+  BOOST_CHECK(std::count_if(ca.begin(), ca.end(), [](array_type::const_reference r) { return r.has_error(); }) == static_cast<ptrdiff_t>(failures));
+  BOOST_CHECK(ca.end() - ca.begin() == static_cast<ptrdiff_t>(a.size()));
+  array_type::const_iterator it = a.begin() + first;
+  BOOST_CHECK((*it).has_error());
+  BOOST_CHECK(!it[-1].has_error());
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_result_array_nontrivial, "Tests result_array with non-trivial value and error types")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  using array_type = result_array<std::string, std::vector<int>, policy::all_narrow>;
+  array_type a;
+  a.reserve(100);
+  for(int n = 0; n < 100; n++)
+  {
+    if(n == 64 || n == 99)
+    {
+      a.emplace_error(3, n);
+    }
+    else
+    {
+      a.emplace_value(std::to_string(n));
+    }
+  }
+  BOOST_CHECK(a.count_failures() == 2);
+  BOOST_CHECK(a.first_failure() == 64);
+  BOOST_CHECK(a[64].error() == std::vector<int>(3, 64));
+  BOOST_CHECK(a[63].value() == "63");
+  a[64] = array_type::result_type(in_place_type<std::string>, "fixed");
+  BOOST_CHECK(a.first_failure() == 99);
+  a.pop_back();
+  BOOST_CHECK(a.count_failures() == 0);
+  BOOST_CHECK(a.first_failure() == a.size());
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_result_array_not_default_constructible, "Tests result_array with value and error types which are not default constructible")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  struct value_type
+  {
+    std::string v;
+    explicit value_type(std::string _v)
+        : v(std::move(_v))
+    {
+    }
+  };
+  struct error_type
+  {
+    int e;
+    explicit error_type(int _e)
+        : e(_e)
+    {
+    }
+  };
+  using array_type = result_array<value_type, error_type, policy::all_narrow>;
+  static_assert(!std::is_default_constructible<value_type>::value && !std::is_default_constructible<error_type>::value, "");
+  static_assert(std::is_same<std::iterator_traits<array_type::iterator>::iterator_category, std::input_iterator_tag>::value, "");
+  array_type a;
+  for(int n = 0; n < 200; n++)
+  {
+    if(n % 3 == 0)
+    {
+      a.emplace_error(n);
+    }
+    else
+    {
+      a.emplace_value(std::to_string(n));
+    }
+  }
+  // Appending a copy of an existing value while the arrays grow
+  a.emplace_value(a[1].value());
+  BOOST_REQUIRE(a.size() == 201);
+  BOOST_CHECK(a[200].value().v == "1");
+  BOOST_CHECK(a.count_failures() == 67);
+
+  array_type b(a);
+  BOOST_CHECK(b.size() == a.size());
+  BOOST_CHECK(b[3].error().e == 3);
+  BOOST_CHECK(b[4].value().v == "4");
+  b[3] = array_type::result_type(in_place_type<value_type>, "three");
+  b[4] = array_type::result_type(in_place_type<error_type>, 4);
+  BOOST_CHECK(b[3].value().v == "three");
+  BOOST_CHECK(b[4].error().e == 4);
+  BOOST_CHECK(a[3].has_error() && a[4].has_value());
+
+  array_type c(std::move(b));
+  BOOST_CHECK(b.empty());
+  BOOST_CHECK(c.size() == 201);
+  b = c;
+  BOOST_CHECK(b.size() == 201);
+  a = std::move(c);
+  BOOST_CHECK(a[3].value().v == "three");
+  a.clear();
+  BOOST_CHECK(a.count_failures() == 0);
+  a.emplace_error(5);
+  BOOST_CHECK(a.first_failure() == 0);
+}
@@ -0,0 +1,66 @@
+/* Unit testing for outcomes
+(C) 2013-2022 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+
+#define BOOST_OUTCOME_SPARE_STORAGE_BITS 0
+
+#include <boost/outcome.hpp>
+#include <boost/outcome/iostream_support.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_result_spare_storage_compact, "Tests that the compact status layout uses a single byte")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  static_assert(sizeof(detail::status_bitfield_type) == 1, "status_bitfield_type is not 1 byte!");
+  static_assert(sizeof(result<int32_t, int8_t, policy::all_narrow>) == 8, "result<int32_t, int8_t> is the wrong size!");
+  static_assert(sizeof(result<int16_t, int8_t, policy::all_narrow>) == 4, "result<int16_t, int8_t> is the wrong size!");
+  static_assert(sizeof(result<void, int8_t, policy::all_narrow>) == 2, "result<void, int8_t> is the wrong size!");
+  static_assert(std::is_same<result<int>, layout_spare0::result<int>>::value, "compact layout is not in its own namespace!");
+
+  // Spare storage is discarded
+  result<int> a = success(5, 78);
+  BOOST_CHECK(a.value() == 5);
+  BOOST_CHECK(hooks::spare_storage(&a) == 0);
+  hooks::set_spare_storage(&a, 78);
+  BOOST_CHECK(hooks::spare_storage(&a) == 0);
+
+  // Every state still works
+  outcome<int> b(make_error_code(boost::system::errc::invalid_argument), boost::copy_exception(std::runtime_error("hi")));
+  BOOST_CHECK(b.has_error());
+  BOOST_CHECK(b.has_exception());
+
+  // Serialisation is unchanged
+  std::stringstream ss;
+  result<int, long> c(in_place_type<int>, 5), d(in_place_type<int>, 6);
+  ss << c;
+  ss.seekg(0);
+  ss >> d;
+  BOOST_CHECK(c == d);
+}
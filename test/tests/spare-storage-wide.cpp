@@ -0,0 +1,91 @@
+/* Unit testing for outcomes
+(C) 2013-2022 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+
+#define BOOST_OUTCOME_SPARE_STORAGE_BITS 48
+
+#include <boost/outcome.hpp>
+#include <boost/outcome/iostream_support.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+
+namespace spare_storage_wide
+{
+  namespace outcome = BOOST_OUTCOME_V2_NAMESPACE;
+
+  constexpr outcome::spare_storage_type trace_id = 0xfedcba987654ULL;
+
+  outcome::result<int> foo()
+  {
+    outcome::result<int> ret(boost::system::errc::invalid_argument);
+    outcome::hooks::set_spare_storage(&ret, trace_id);
+    return ret;
+  }
+  outcome::result<int> test()
+  {
+    BOOST_OUTCOME_TRY(foo());
+    return 7;
+  }
+}  // namespace spare_storage_wide
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_result_spare_storage_wide, "Tests that the wide status layout provides 48 bits of spare storage")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  using spare_storage_wide::trace_id;
+  static_assert(sizeof(spare_storage_type) == 8, "spare_storage_type is not 64 bits!");
+  static_assert(sizeof(detail::status_bitfield_type) == 8, "status_bitfield_type is not 8 bytes!");
+  static_assert(sizeof(result<int *, int>) == 16, "result<int *, int> is the wrong size!");
+
+  // All 48 bits survive propagation through TRY, and via success() and failure()
+  auto r = spare_storage_wide::test();
+  BOOST_CHECK(r.has_error());
+  BOOST_CHECK(hooks::spare_storage(&r) == trace_id);
+  result<int> s = success(5, trace_id);
+  BOOST_CHECK(hooks::spare_storage(&s) == trace_id);
+  outcome<int> t(r);
+  BOOST_CHECK(hooks::spare_storage(&t) == trace_id);
+  hooks::set_spare_storage(&s, 0xffffffffffffULL);
+  BOOST_CHECK(hooks::spare_storage(&s) == 0xffffffffffffULL);
+  BOOST_CHECK(s.value() == 5);
+  // The top 16 bits of spare_storage_type are not stored, and must not disturb the status
+  hooks::set_spare_storage(&s, 0xffff000000000001ULL);
+  BOOST_CHECK(hooks::spare_storage(&s) == 1);
+  BOOST_CHECK(s.value() == 5);
+  static_assert(std::is_same<result<int>, layout_spare48::result<int>>::value, "wide layout is not in its own namespace!");
+
+  // All 48 bits survive serialisation
+  std::stringstream ss;
+  result<int, long> u(in_place_type<int>, 5), v(in_place_type<int>, 6);
+  hooks::set_spare_storage(&u, trace_id);
+  ss << u;
+  ss.seekg(0);
+  ss >> v;
+  BOOST_CHECK(u == v);
+  BOOST_CHECK(hooks::spare_storage(&v) == trace_id);
+}
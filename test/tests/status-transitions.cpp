@@ -0,0 +1,105 @@
+/* Unit testing for outcomes
+(C) 2013-2022 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <boost/outcome.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+
+namespace status_transitions
+{
+  using BOOST_OUTCOME_V2_NAMESPACE::detail::status;
+  using BOOST_OUTCOME_V2_NAMESPACE::detail::status_bitfield_type;
+
+  constexpr status_bitfield_type apply(status_bitfield_type s, unsigned which, bool v) noexcept
+  {
+    switch(which)
+    {
+    case 0:
+      return s.set_have_value(v);
+    case 1:
+      return s.set_have_error(v);
+    case 2:
+      return s.set_have_exception(v);
+    case 3:
+      return s.set_have_error_is_errno(v);
+    case 4:
+      return s.set_have_lost_consistency(v);
+    default:
+      return s.set_have_moved_from(v);
+    }
+  }
+  constexpr uint16_t expected(uint16_t s, unsigned which, bool v) noexcept
+  {
+    constexpr uint16_t bits[6] = {static_cast<uint16_t>(status::have_value),          static_cast<uint16_t>(status::have_error),
+                                  static_cast<uint16_t>(status::have_exception),      static_cast<uint16_t>(status::have_error_is_errno),
+                                  static_cast<uint16_t>(status::have_lost_consistency), static_cast<uint16_t>(status::have_moved_from)};
+    return v ? (s | bits[which]) : (s & ~bits[which]);
+  }
+  // Every setter from every state must match setting and clearing bits
+  constexpr bool all_transitions_correct() noexcept
+  {
+    for(uint16_t s = 0; s < 64; s++)
+    {
+      for(unsigned which = 0; which < 6; which++)
+      {
+        for(bool v : {false, true})
+        {
+          if(static_cast<uint16_t>(apply(status_bitfield_type(static_cast<status>(s), 78), which, v).status_value) != expected(s, which, v) ||
+             apply(status_bitfield_type(static_cast<status>(s), 78), which, v).spare_storage() != status_bitfield_type(status::none, 78).spare_storage())
+          {
+            return false;
+          }
+        }
+      }
+    }
+    return true;
+  }
+}  // namespace status_transitions
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_status_transitions, "Tests that the status transitions are correct in constexpr and at runtime")
+{
+  using namespace status_transitions;
+  static_assert(all_transitions_correct(), "constexpr status transitions are incorrect!");
+  // Prevent the compiler constant folding the runtime check
+  bool (*volatile runtime)() = all_transitions_correct;
+  BOOST_CHECK(runtime());
+
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  // Outcome's own state changes must also work, including value plus exception
+  outcome<int> a(5);
+  BOOST_CHECK(a.has_value());
+  hooks::override_outcome_exception(&a, boost::copy_exception(std::runtime_error("hi")));
+  BOOST_CHECK(a.has_value());
+  BOOST_CHECK(a.has_exception());
+  outcome<int> b(make_error_code(boost::system::errc::invalid_argument), boost::copy_exception(std::runtime_error("hi")));
+  BOOST_CHECK(b.has_error());
+  BOOST_CHECK(b.has_exception());
+  BOOST_CHECK(b.has_failure());
+}
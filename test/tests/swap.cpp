@@ -31,6 +31,9 @@ DEALINGS IN THE SOFTWARE.
 #include <boost/test/unit_test.hpp>
 #include <boost/test/unit_test_monitor.hpp>
 
+#include <algorithm>
+#include <vector>
+
 /* Should be this:
 
 78 move constructor count = 2
@@ -430,3 +433,111 @@ BOOST_OUTCOME_AUTO_TEST_CASE(works_outcome_swap, "Tests that the outcome swaps a
   }
 #endif
 }
+
+namespace swap_relocatable
+{
+  // Owns memory and has potentially throwing moves, but is declared trivially relocatable below
+  struct Counted
+  {
+    static int moves;
+    int *p;
+    explicit Counted(int v)
+        : p(new int(v))
+    {
+    }
+    Counted(Counted &&o) noexcept(false)
+        : p(o.p)
+    {
+      o.p = nullptr;
+      ++moves;
+    }
+    Counted &operator=(Counted &&o) noexcept(false)
+    {
+      std::swap(p, o.p);
+      ++moves;
+      return *this;
+    }
+    ~Counted() { delete p; }
+  };
+  int Counted::moves;
+}  // namespace swap_relocatable
+BOOST_OUTCOME_V2_NAMESPACE_BEGIN
+namespace trait
+{
+  template <> struct is_trivially_relocatable<swap_relocatable::Counted>
+  {
+    static constexpr bool value = true;
+  };
+}  // namespace trait
+BOOST_OUTCOME_V2_NAMESPACE_END
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_outcome_swap_relocatable, "Tests that trivially relocatable payloads swap by exchanging bytes")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  using swap_relocatable::Counted;
+  using type = result<Counted, ErrorCode, policy::all_narrow>;
+  using otype = outcome<Counted, ErrorCode, std::exception_ptr, policy::all_narrow>;
+  static_assert(!detail::is_nothrow_swappable<Counted>::value, "Counted should not be nothrow swappable!");
+  static_assert(noexcept(std::declval<type &>().swap(std::declval<type &>())), "result of a trivially relocatable type has a throwing swap!");
+  static_assert(noexcept(std::declval<otype &>().swap(std::declval<otype &>())) == detail::is_nothrow_swappable<std::exception_ptr>::value,
+                "outcome of a trivially relocatable type does not take its swap noexcept from its exception type!");
+  {
+    type a(in_place_type<Counted>, 78), b(in_place_type<Counted>, 65), c(ErrorCode::dummy);
+    Counted::moves = 0;
+    a.swap(b);
+    BOOST_CHECK(*a.value().p == 65);
+    BOOST_CHECK(*b.value().p == 78);
+    a.swap(c);
+    BOOST_CHECK(a.has_error());
+    BOOST_CHECK(*c.value().p == 65);
+    swap(a, c);
+    BOOST_CHECK(*a.value().p == 65);
+    BOOST_CHECK(c.has_error());
+    BOOST_CHECK(Counted::moves == 0);
+    BOOST_CHECK(!a.has_lost_consistency() && !b.has_lost_consistency() && !c.has_lost_consistency());
+  }
+  {
+    otype a(in_place_type<Counted>, 78), b(std::make_exception_ptr(5));
+    Counted::moves = 0;
+    a.swap(b);
+    BOOST_CHECK(a.has_exception());
+    BOOST_CHECK(*b.value().p == 78);
+    BOOST_CHECK(Counted::moves == 0);
+  }
+  {  // Swap based algorithms on large vectors of results never move a payload
+    std::vector<type> v;
+    v.reserve(100000);
+    for(int n = 0; n < 100000; n++)
+    {
+      if(n % 17 == 0)
+      {
+        v.emplace_back(ErrorCode::dummy);
+      }
+      else
+      {
+        v.emplace_back(in_place_type<Counted>, (n * 7919) % 100003);
+      }
+    }
+    Counted::moves = 0;
+    std::reverse(v.begin(), v.end());
+    for(size_t n = 0; n + 1 < v.size(); n += 2)
+    {
+      swap(v[n], v[n + 1]);
+    }
+    BOOST_CHECK(Counted::moves == 0);
+
+    // Failures first, then values in ascending order
+    auto less = [](const type &a, const type &b) {
+      if(a.has_error() != b.has_error())
+      {
+        return a.has_error();
+      }
+      return a.has_value() && *a.value().p < *b.value().p;
+    };
+    std::sort(v.begin(), v.end(), less);
+    BOOST_CHECK(std::is_sorted(v.begin(), v.end(), less));
+    BOOST_CHECK(v.size() == 100000);
+    BOOST_CHECK(std::count_if(v.begin(), v.end(), [](const type &r) { return r.has_error(); }) == (100000 + 16) / 17);
+    BOOST_CHECK(std::none_of(v.begin(), v.end(), [](const type &r) { return r.has_lost_consistency(); }));
+  }
+}
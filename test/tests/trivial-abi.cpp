@@ -0,0 +1,139 @@
+/* Unit testing for outcomes
+(C) 2013-2022 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <boost/outcome.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+
+#ifdef __has_builtin
+#if __has_builtin(__is_trivially_relocatable)
+#define BOOST_OUTCOME_TEST_HAVE_IS_TRIVIALLY_RELOCATABLE 1
+#endif
+#endif
+
+namespace trivial_abi
+{
+  // A move-only handle with a non-trivial destructor which is nevertheless safe to pass in registers
+  static int alive;
+  template <int Tag> struct BOOST_OUTCOME_TRIVIAL_ABI handle_
+  {
+    int *v{nullptr};
+    handle_() = default;
+    explicit handle_(int *_v)
+        : v(_v)
+    {
+      ++alive;
+    }
+    handle_(const handle_ &) = delete;
+    handle_(handle_ &&o) noexcept
+        : v(o.v)
+    {
+      o.v = nullptr;
+    }
+    handle_ &operator=(const handle_ &) = delete;
+    handle_ &operator=(handle_ &&o) noexcept
+    {
+      if(v != nullptr)
+      {
+        --alive;
+      }
+      v = o.v;
+      o.v = nullptr;
+      return *this;
+    }
+    ~handle_()
+    {
+      if(v != nullptr)
+      {
+        --alive;
+      }
+    }
+  };
+  using handle = handle_<0>;
+  using error_handle = handle_<1>;
+
+  // A type which must never be passed in registers, as it points into itself
+  struct self_referencing
+  {
+    self_referencing *self{this};
+    self_referencing() = default;
+    self_referencing(const self_referencing & /*unused*/) noexcept {}
+    self_referencing &operator=(const self_referencing & /*unused*/) noexcept { return *this; }
+    ~self_referencing() {}
+  };
+
+#if defined(_MSC_VER) && !defined(__clang__)
+  __declspec(noinline)
+#else
+  __attribute__((noinline))
+#endif
+  int *sink(BOOST_OUTCOME_V2_NAMESPACE::result<handle, error_handle, BOOST_OUTCOME_V2_NAMESPACE::policy::all_narrow> r)
+  {
+    return r.has_value() ? r.assume_value().v : r.assume_error().v;
+  }
+}  // namespace trivial_abi
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_result_trivial_abi, "Tests that basic_result and basic_outcome are passed in registers when their contents allow it")
+{
+  using namespace BOOST_OUTCOME_V2_NAMESPACE;
+  using trivial_abi::error_handle;
+  using trivial_abi::handle;
+  using trivial_abi::self_referencing;
+  using handle_result = result<handle, error_handle, policy::all_narrow>;
+  using handle_outcome = outcome<handle, error_handle, void, policy::all_narrow>;
+  static_assert(!std::is_trivially_copyable<handle_result>::value, "handle_result should not be trivially copyable!");
+#ifdef BOOST_OUTCOME_TEST_HAVE_IS_TRIVIALLY_RELOCATABLE
+  // clang only considers a type trivially relocatable if it is trivially copyable, or if [[clang::trivial_abi]]
+  // survived on it and all its bases and members. Such types are passed and returned in registers.
+  static_assert(__is_trivially_relocatable(handle), "handle is not trivial abi!");
+  static_assert(__is_trivially_relocatable(handle_result), "result<handle, error_handle> is not trivial abi!");
+  static_assert(__is_trivially_relocatable(handle_outcome), "outcome<handle, error_handle, void> is not trivial abi!");
+  static_assert(!__is_trivially_relocatable(result<self_referencing, error_handle, policy::all_narrow>), "result<self_referencing, error_handle> is trivial abi!");
+#endif
+  int x = 5, y = 6;
+  {
+    // Passing by value destroys the parameter in the callee under trivial abi, and in the caller otherwise
+    BOOST_CHECK(trivial_abi::sink(handle_result(in_place_type<handle>, &x)) == &x);
+    BOOST_CHECK(trivial_abi::sink(handle_result(in_place_type_t<handle>{}, &x)) == &x);
+    BOOST_CHECK(trivial_abi::alive == 0);
+    handle_result r(in_place_type<handle>, &y);
+    BOOST_CHECK(trivial_abi::sink(std::move(r)) == &y);
+    BOOST_CHECK(trivial_abi::alive == 0);
+    BOOST_CHECK(r.has_value());
+    BOOST_CHECK(r.assume_value().v == nullptr);
+    handle_outcome o(in_place_type<handle>, &x), p(std::move(o));
+    BOOST_CHECK(trivial_abi::alive == 1);
+    BOOST_CHECK(p.value().v == &x);
+    BOOST_CHECK(o.value().v == nullptr);
+  }
+  BOOST_CHECK(trivial_abi::alive == 0);
+  result<self_referencing, error_handle, policy::all_narrow> s(in_place_type<self_referencing>);
+  BOOST_CHECK(s.assume_value().self == &s.assume_value());
+}
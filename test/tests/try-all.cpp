@@ -0,0 +1,192 @@
+/* Unit testing for outcomes
+(C) 2013-2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#include <boost/outcome.hpp>
+#include <boost/outcome/coroutine_support.hpp>
+#include <boost/outcome/experimental/status_result.hpp>
+#include <boost/outcome/try.hpp>
+#include <boost/outcome/when_all.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace try_all_test
+{
+  namespace outcome = BOOST_OUTCOME_V2_NAMESPACE;
+  namespace outcome_e = BOOST_OUTCOME_V2_NAMESPACE::experimental;
+
+  static std::vector<int> evaluated;
+
+  inline outcome::result<int> fetch(int x)
+  {
+    evaluated.push_back(x);
+    if(x < 0)
+    {
+      return outcome::failure(boost::system::error_code(-x, boost::system::generic_category()), static_cast<outcome::spare_storage_type>(-x));
+    }
+    return x;
+  }
+  inline outcome::result<int> sum3(int a, int b, int c)
+  {
+    BOOST_OUTCOME_TRY_ALL((auto x, auto y, auto z), fetch(a), fetch(b), fetch(c));
+    return x + y + z;
+  }
+  inline outcome::outcome<std::string> concat(int a, int b)
+  {
+    std::string s;
+    outcome::outcome<std::string> o(std::string("o"));
+    // References bind to the internal temporaries, existing variables are assigned to
+    BOOST_OUTCOME_TRY_ALL((auto &&x, s, const std::string &y), fetch(a), o, outcome::outcome<std::string>(std::to_string(b)));
+    return s + std::to_string(x) + y;
+  }
+  inline outcome_e::status_result<std::unique_ptr<int>> move_only(int a, int b)
+  {
+    auto make = [](int x) -> outcome_e::status_result<std::unique_ptr<int>> {
+      if(x < 0)
+      {
+        return outcome_e::errc::invalid_argument;
+      }
+      return std::make_unique<int>(x);
+    };
+    BOOST_OUTCOME_TRY_ALL((auto x, auto y), make(a), make(b));
+    return std::make_unique<int>(*x + *y);
+  }
+  inline outcome::result<int> eight(int fail)
+  {
+    BOOST_OUTCOME_TRY_ALL((auto a, auto b, auto c, auto d, auto e, auto f, auto g, auto h), fetch(fail == 1 ? -1 : 1), fetch(2), fetch(3), fetch(4), fetch(5),
+                          fetch(6), fetch(7), fetch(fail == 8 ? -8 : 8));
+    return a + b + c + d + e + f + g + h;
+  }
+
+#if BOOST_OUTCOME_FOUND_COROUTINE_HEADER
+  template <class T> using eager = outcome::awaitables::eager<T>;
+  template <class T> using lazy = outcome::awaitables::lazy<T>;
+
+  inline eager<outcome::result<int>> eager_fetch(int x) { co_return fetch(x); }
+  inline lazy<outcome::result<int>> lazy_fetch(int x) { co_return fetch(x); }
+  inline lazy<outcome::result<int>> co_sum(int a, int b, int c)
+  {
+    BOOST_OUTCOME_CO_TRY_ALL((auto x, auto y, auto z), eager_fetch(a), lazy_fetch(b), eager_fetch(c));
+    co_return x + y + z;
+  }
+  // Suspends until released, so that an operand cannot complete until every operand has begun
+  struct gate
+  {
+    std::vector<outcome::awaitables::coroutine_handle<>> waiting;
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(outcome::awaitables::coroutine_handle<> h) { waiting.push_back(h); }
+    void await_resume() const noexcept {}
+  };
+  inline lazy<outcome::result<int>> gated_fetch(gate &g, int x)
+  {
+    evaluated.push_back(x);
+    co_await g;
+    co_return fetch(x * 10);
+  }
+  inline lazy<outcome::result<int>> co_gated_sum(gate &g)
+  {
+    BOOST_OUTCOME_CO_TRY_ALL((auto x, auto y), gated_fetch(g, 1), gated_fetch(g, 2));
+    co_return x + y;
+  }
+  template <class T> inline T run(lazy<T> t)
+  {
+#if BOOST_OUTCOME_HAVE_NOOP_COROUTINE
+    t.await_suspend({}).resume();
+#else
+    t.await_suspend({});
+#endif
+    BOOST_REQUIRE(t.await_ready());
+    return t.await_resume();
+  }
+#endif
+}  // namespace try_all_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_try_all, "Tests that BOOST_OUTCOME_TRY_ALL evaluates every operand, and returns the first failure")
+{
+  using namespace try_all_test;
+  evaluated.clear();
+  BOOST_CHECK(sum3(1, 2, 3).value() == 6);
+  BOOST_CHECK((evaluated == std::vector<int>{1, 2, 3}));
+
+  // Every operand is evaluated even when an earlier one fails
+  evaluated.clear();
+  auto r = sum3(1, -2, -3);
+  BOOST_CHECK((evaluated == std::vector<int>{1, -2, -3}));
+  BOOST_REQUIRE(r.has_error());
+  BOOST_CHECK(r.error().value() == 2);
+  BOOST_CHECK(outcome::hooks::spare_storage(&r) == 2);
+
+  BOOST_CHECK(concat(4, 5).value() == "o45");
+  BOOST_CHECK(concat(-4, 5).error().value() == 4);
+
+  BOOST_CHECK(*move_only(4, 5).value() == 9);
+  BOOST_CHECK(move_only(4, -5).error() == outcome_e::errc::invalid_argument);
+
+  BOOST_CHECK(eight(0).value() == 36);
+  BOOST_CHECK(eight(1).error().value() == 1);
+  BOOST_CHECK(eight(8).error().value() == 8);
+}
+
+#if BOOST_OUTCOME_FOUND_COROUTINE_HEADER
+BOOST_OUTCOME_AUTO_TEST_CASE(works_co_try_all, "Tests that BOOST_OUTCOME_CO_TRY_ALL awaits every awaitable at once")
+{
+  using namespace try_all_test;
+  evaluated.clear();
+  BOOST_CHECK(run(co_sum(1, 2, 3)).value() == 6);
+  // The eager operands ran as soon as they were created, before the lazy one was awaited
+  BOOST_CHECK((evaluated == std::vector<int>{1, 3, 2}));
+
+  evaluated.clear();
+  auto r = run(co_sum(-1, 2, -3));
+  BOOST_CHECK((evaluated == std::vector<int>{-1, -3, 2}));
+  BOOST_REQUIRE(r.has_error());
+  BOOST_CHECK(r.error().value() == 1);
+
+  // Both lazy operands begin before either completes
+  evaluated.clear();
+  gate g;
+  auto t = co_gated_sum(g);
+#if BOOST_OUTCOME_HAVE_NOOP_COROUTINE
+  t.await_suspend({}).resume();
+#else
+  t.await_suspend({});
+#endif
+  BOOST_CHECK((evaluated == std::vector<int>{1, 2}));
+  BOOST_REQUIRE(g.waiting.size() == 2);
+  BOOST_CHECK(!t.await_ready());
+  g.waiting[1].resume();
+  BOOST_CHECK(!t.await_ready());
+  g.waiting[0].resume();
+  BOOST_REQUIRE(t.await_ready());
+  BOOST_CHECK(t.await_resume().value() == 30);
+}
+#endif
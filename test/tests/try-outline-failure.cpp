@@ -0,0 +1,158 @@
+/* Unit testing for outcomes
+(C) 2013-2024 Niall Douglas <http://www.nedproductions.biz/> (1 commit)
+
+
+Boost Software License - Version 1.0 - August 17th, 2003
+
+Permission is hereby granted, free of charge, to any person or organization
+obtaining a copy of the software and accompanying documentation covered by
+this license (the "Software") to use, reproduce, display, distribute,
+execute, and transmit the Software, and to prepare derivative works of the
+Software, and to permit third-parties to whom the Software is furnished to
+do so, all subject to the following:
+
+The copyright notices in the Software and this entire statement, including
+the above license grant, this restriction and the following disclaimer,
+must be included in all copies of the Software, in whole or in part, and
+all derivative works of the Software, unless such copies or derivative
+works are solely in the form of machine-executable object code generated by
+a source language processor.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+DEALINGS IN THE SOFTWARE.
+*/
+
+#define BOOST_OUTCOME_TRY_OUTLINE_FAILURE 1
+#include <boost/outcome.hpp>
+#include <boost/outcome/experimental/status_result.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+
+#include <memory>
+
+namespace try_outline_failure_test
+{
+  namespace outcome = BOOST_OUTCOME_V2_NAMESPACE;
+  namespace outcome_e = BOOST_OUTCOME_V2_NAMESPACE::experimental;
+
+  // A foreign type with no .as_failure(), which TRY learns about after try.hpp
+  struct foreign
+  {
+    int v{0}, e{0};
+    bool has_value() const { return e == 0; }
+    int value() const { return v; }
+  };
+}  // namespace try_outline_failure_test
+
+BOOST_OUTCOME_V2_NAMESPACE_BEGIN
+inline auto try_operation_return_as(const try_outline_failure_test::foreign &f)
+{
+  return failure(boost::system::error_code(f.e, boost::system::generic_category()));
+}
+BOOST_OUTCOME_V2_NAMESPACE_END
+
+namespace try_outline_failure_test
+{
+  static_assert(std::is_same<decltype(outcome::detail::try_operation_outline(std::declval<outcome::result<int>>())),
+                             outcome::detail::try_operation_outlined<outcome::result<int>>>::value,
+                "");
+  static_assert(std::is_same<decltype(outcome::detail::try_operation_outline(std::declval<const foreign &>())), const foreign &>::value, "");
+
+  inline outcome::result<int> leaf(int x)
+  {
+    if(x < 0)
+    {
+      return outcome::failure(boost::system::errc::invalid_argument, static_cast<outcome::spare_storage_type>(-x));
+    }
+    return x;
+  }
+  inline outcome::result<int> by_value(int x)
+  {
+    BOOST_OUTCOME_TRY(auto v, leaf(x));
+    return v + 1;
+  }
+  inline outcome::outcome<int> by_lvalue(int x)
+  {
+    const outcome::outcome<int> o = (x == -100) ? outcome::outcome<int>(boost::copy_exception(std::runtime_error("hi"))) : outcome::outcome<int>(leaf(x));
+    BOOST_OUTCOME_TRY(auto &&v, o);
+    return v;
+  }
+  inline outcome::result<void> void_value(int x)
+  {
+    BOOST_OUTCOME_TRYV(by_value(x));
+    BOOST_OUTCOME_TRY((auto &&, v), leaf(x));
+    (void) v;
+    return outcome::success();
+  }
+  inline outcome::result<int> from_foreign(foreign f)
+  {
+    BOOST_OUTCOME_TRY(auto v, f);
+    return v;
+  }
+  inline outcome_e::status_result<std::unique_ptr<int>> move_only(int x)
+  {
+    outcome_e::status_result<std::unique_ptr<int>> r(std::make_unique<int>(x));
+    if(x < 0)
+    {
+      r = outcome_e::errc::invalid_argument;
+    }
+    BOOST_OUTCOME_TRY(auto v, std::move(r));
+    return v;
+  }
+  // A chain of distinct TRY sites, each of which shares the one outlined failure path of result<int>
+  template <int N> outcome::result<int> chain(int x)
+  {
+    BOOST_OUTCOME_TRY(auto v, chain<N - 1>(x));
+    return v + 1;
+  }
+  template <> inline outcome::result<int> chain<0>(int x) { return leaf(x); }
+#if defined(__GNUC__) || defined(__clang__)
+  inline outcome::result<int> expression(int x) { return BOOST_OUTCOME_TRYX(leaf(x)) * 2; }
+#endif
+}  // namespace try_outline_failure_test
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_try_outline_failure, "Tests that TRY with outlined failure branches propagates failures as usual")
+{
+  using namespace try_outline_failure_test;
+  BOOST_CHECK(by_value(1).value() == 2);
+  auto r = by_value(-5);
+  BOOST_REQUIRE(r.has_error());
+  BOOST_CHECK(r.error() == boost::system::errc::invalid_argument);
+  // Spare storage is still propagated
+  BOOST_CHECK(outcome::hooks::spare_storage(&r) == 5);
+
+  BOOST_CHECK(by_lvalue(3).value() == 3);
+  auto o = by_lvalue(-3);
+  BOOST_CHECK(o.has_error());
+  BOOST_CHECK(outcome::hooks::spare_storage(&o) == 3);
+  o = by_lvalue(-100);
+  BOOST_CHECK(o.has_exception());
+  BOOST_CHECK(!o.has_error());
+
+  BOOST_CHECK(void_value(1).has_value());
+  BOOST_CHECK(void_value(-1).error() == boost::system::errc::invalid_argument);
+
+  BOOST_CHECK(from_foreign({4, 0}).value() == 4);
+  BOOST_CHECK(from_foreign({4, EINVAL}).error() == boost::system::errc::invalid_argument);
+
+  BOOST_CHECK(*move_only(6).value() == 6);
+  BOOST_CHECK(move_only(-6).error() == outcome_e::errc::invalid_argument);
+#if defined(__GNUC__) || defined(__clang__)
+  BOOST_CHECK(expression(4).value() == 8);
+  BOOST_CHECK(expression(-4).has_error());
+#endif
+}
+
+BOOST_OUTCOME_AUTO_TEST_CASE(works_try_outline_failure_chain, "Tests many TRY sites with outlined failure branches")
+{
+  using namespace try_outline_failure_test;
+  BOOST_CHECK(chain<64>(0).value() == 64);
+  auto r = chain<64>(-7);
+  BOOST_REQUIRE(r.has_error());
+  BOOST_CHECK(outcome::hooks::spare_storage(&r) == 7);
+}